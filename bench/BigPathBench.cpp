@@ -7,7 +7,9 @@
 
 #include "Benchmark.h"
 #include "SkCanvas.h"
+#include "SkExecutor.h"
 #include "SkPath.h"
+#include "SkScan.h"
 #include "sk_tool_utils.h"
 
 enum Align {
@@ -18,19 +20,36 @@ enum Align {
 
 const char* gAlignName[] = { "left", "middle", "right" };
 
+// The tall variants stretch the path vertically so delta AA has enough rows to split into bands;
+// the threaded ones generate those bands on a thread pool (see gSkDeltaAAExecutor).
+enum Mode {
+    kNormal_Mode,
+    kTall_Mode,
+    kTallThreaded_Mode
+};
+
+const char* gModeName[] = { "", "_tall", "_tall_threaded" };
+
+static constexpr SkScalar kTallScale = 4;
+
 // Inspired by crbug.com/455429
 class BigPathBench : public Benchmark {
     SkPath      fPath;
     SkString    fName;
     Align       fAlign;
     bool        fRound;
+    Mode        fMode;
+
+    std::unique_ptr<SkExecutor> fExecutor;
 
 public:
-    BigPathBench(Align align, bool round) : fAlign(align), fRound(round) {
+    BigPathBench(Align align, bool round, Mode mode = kNormal_Mode)
+        : fAlign(align), fRound(round), fMode(mode) {
         fName.printf("bigpath_%s", gAlignName[fAlign]);
         if (round) {
             fName.append("_round");
         }
+        fName.append(gModeName[fMode]);
     }
 
 protected:
@@ -39,11 +58,27 @@ protected:
     }
 
     SkIPoint onGetSize() override {
-        return SkIPoint::Make(640, 100);
+        int height = fMode == kNormal_Mode ? 100 : SkScalarCeilToInt(100 * kTallScale);
+        return SkIPoint::Make(640, height);
     }
 
     void onDelayedSetup() override {
         sk_tool_utils::make_big_path(fPath);
+        if (fMode == kTallThreaded_Mode) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        if (fExecutor) {
+            gSkDeltaAAExecutor = fExecutor.get();
+        }
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        if (fExecutor) {
+            gSkDeltaAAExecutor = nullptr;
+        }
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
@@ -56,6 +91,10 @@ protected:
         }
         this->setupPaint(&paint);
 
+        if (fMode != kNormal_Mode) {
+            canvas->scale(1, kTallScale);
+        }
+
         const SkRect r = fPath.getBounds();
         switch (fAlign) {
             case kLeft_Align:
@@ -84,3 +123,8 @@ DEF_BENCH( return new BigPathBench(kRight_Align,    false); )
 DEF_BENCH( return new BigPathBench(kLeft_Align,     true); )
 DEF_BENCH( return new BigPathBench(kMiddle_Align,   true); )
 DEF_BENCH( return new BigPathBench(kRight_Align,    true); )
+
+DEF_BENCH( return new BigPathBench(kMiddle_Align,   false,  kTall_Mode); )
+DEF_BENCH( return new BigPathBench(kMiddle_Align,   false,  kTallThreaded_Mode); )
+DEF_BENCH( return new BigPathBench(kMiddle_Align,   true,   kTall_Mode); )
+DEF_BENCH( return new BigPathBench(kMiddle_Align,   true,   kTallThreaded_Mode); )
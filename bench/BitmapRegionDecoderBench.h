@@ -24,8 +24,9 @@
 class BitmapRegionDecoderBench : public Benchmark {
 public:
     // Calls encoded->ref()
+    // If executor is non-NULL, the region is decoded on it (see SkBitmapRegionDecoder::setExecutor).
     BitmapRegionDecoderBench(const char* basename, SkData* encoded, SkColorType colorType,
-            uint32_t sampleSize, const SkIRect& subset);
+            uint32_t sampleSize, const SkIRect& subset, SkExecutor* executor = nullptr);
 
 protected:
     const char* onGetName() override;
@@ -40,6 +41,7 @@ private:
     const SkColorType                              fColorType;
     const uint32_t                                 fSampleSize;
     const SkIRect                                  fSubset;
+    SkExecutor*                                    fExecutor;
     typedef Benchmark INHERITED;
 };
 #endif // BitmapRegionDecoderBench_DEFINED
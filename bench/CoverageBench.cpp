@@ -10,9 +10,11 @@
 #include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkColorPriv.h"
+#include "SkCoverageDelta.h"
 #include "SkDraw.h"
 #include "SkMatrix.h"
 #include "SkPath.h"
+#include "SkRandom.h"
 #include "SkRasterClip.h"
 
 class DrawPathBench : public Benchmark {
@@ -73,3 +75,57 @@ private:
 
 DEF_BENCH( return new DrawPathBench(false) )
 DEF_BENCH( return new DrawPathBench(true) )
+
+// Measures SkCoverageDeltaMask::convertCoverageToAlpha, the final step of delta AA for small
+// (e.g. glyph or icon sized) paths.
+class DeltaMaskBench : public Benchmark {
+    SkString                    fName;
+    SkSTArenaAlloc<SkCoverageDeltaMask::MAX_SIZE> fAlloc;
+    SkCoverageDeltaMask*        fMask;
+    bool                        fEvenOdd;
+    bool                        fConvex;
+
+public:
+    DeltaMaskBench(bool evenOdd, bool convex) : fEvenOdd(evenOdd), fConvex(convex) {
+        fName.printf("daa_mask_convert_%s", convex ? "convex" : evenOdd ? "evenodd" : "winding");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        SkIRect bounds = SkIRect::MakeWH(SkCoverageDeltaMask::SUITABLE_WIDTH, 32);
+        fMask = fAlloc.make<SkCoverageDeltaMask>(&fAlloc, bounds);
+
+        // Each row gets a few pairs of matching +/- deltas like a row crossing path edges does.
+        SkRandom rand;
+        for (int y = bounds.fTop; y < bounds.fBottom; ++y) {
+            for (int i = 0; i < 4; ++i) {
+                int     l = rand.nextULessThan(bounds.width()),
+                        r = l + rand.nextULessThan(bounds.width() - l);
+                SkFixed d = fConvex ? SK_Fixed1 / 4 : rand.nextRangeU(0, SK_Fixed1 * 2);
+                fMask->addDelta(l,  y,  d);
+                fMask->addDelta(r,  y, -d);
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            fMask->convertCoverageToAlpha(fEvenOdd, false, fConvex);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new DeltaMaskBench(false, false) )
+DEF_BENCH( return new DeltaMaskBench(true,  false) )
+DEF_BENCH( return new DeltaMaskBench(false, true) )
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkDistanceFieldGen.h"
+#include "SkGlyphCache.h"
+#include "SkPaint.h"
+#include "SkString.h"
+#include "SkTArray.h"
+#include "SkTemplates.h"
+#include "SkTypeface.h"
+
+// Times making a distance field from one A8 glyph mask, cycling through the glyphs of the
+// lowercase alphabet at a given text size.
+class DistanceFieldGenBench : public Benchmark {
+    struct Mask {
+        int                     fWidth;
+        int                     fHeight;
+        size_t                  fRowBytes;
+        SkAutoTMalloc<uint8_t>  fImage;
+    };
+
+    SkString               fName;
+    SkScalar               fTextSize;
+    SkTArray<Mask>         fMasks;
+    SkAutoTMalloc<uint8_t> fDistanceField;
+
+public:
+    DistanceFieldGenBench(SkScalar textSize) : fTextSize(textSize) {
+        fName.printf("distancefieldgen_%d", SkScalarRoundToInt(textSize));
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        SkPaint paint;
+        paint.setTypeface(SkTypeface::MakeDefault());
+        paint.setTextSize(fTextSize);
+        paint.setAntiAlias(true);
+
+        const char text[] = "abcdefghijklmnopqrstuvwxyz";
+        SkGlyphID glyphIDs[26];
+        paint.textToGlyphs(text, 26, glyphIDs);
+
+        size_t maxSize = 0;
+        SkAutoGlyphCache cache(paint, nullptr, nullptr);
+        for (SkGlyphID glyphID : glyphIDs) {
+            const SkGlyph& glyph = cache->getGlyphIDMetrics(glyphID);
+            const void* image = cache->findImage(glyph);
+            if (!image || SkMask::kA8_Format != glyph.fMaskFormat) {
+                continue;
+            }
+            Mask& mask = fMasks.push_back();
+            mask.fWidth = glyph.fWidth;
+            mask.fHeight = glyph.fHeight;
+            mask.fRowBytes = glyph.rowBytes();
+            mask.fImage.reset(glyph.computeImageSize());
+            memcpy(mask.fImage.get(), image, glyph.computeImageSize());
+            maxSize = SkTMax(maxSize, SkComputeDistanceFieldSize(glyph.fWidth, glyph.fHeight));
+        }
+        fDistanceField.reset(maxSize);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (fMasks.empty()) {
+            return;
+        }
+        for (int i = 0; i < loops; ++i) {
+            const Mask& mask = fMasks[i % fMasks.count()];
+            SkGenerateDistanceFieldFromA8Image(fDistanceField.get(), mask.fImage.get(),
+                                               mask.fWidth, mask.fHeight, mask.fRowBytes);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+// 32, 72 and 162 are the sizes GPU text makes its small, medium and large distance field
+// glyphs at.
+DEF_BENCH( return new DistanceFieldGenBench(12); )
+DEF_BENCH( return new DistanceFieldGenBench(32); )
+DEF_BENCH( return new DistanceFieldGenBench(72); )
+DEF_BENCH( return new DistanceFieldGenBench(162); )
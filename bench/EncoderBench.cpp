@@ -8,6 +8,7 @@
 #include "Benchmark.h"
 #include "Resources.h"
 #include "SkBitmap.h"
+#include "SkExecutor.h"
 #include "SkJpegEncoder.h"
 #include "SkPngEncoder.h"
 #include "SkWebpEncoder.h"
@@ -120,3 +121,61 @@ DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 3), "PNG_3n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 1), "PNG_1n"));
 
 #undef PNG
+
+// Encodes pngs in strips on a thread pool of |threads| threads.
+class PngStripEncodeBench : public Benchmark {
+public:
+    PngStripEncodeBench(const char* filename, int zlibLevel, int threads)
+        : fSourceFilename(filename)
+        , fZLibLevel(zlibLevel)
+        , fThreads(threads)
+        , fName(SkStringPrintf("Encode_%s_PNG_%d_strips_%dthreads", filename, zlibLevel,
+                               threads)) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkAssertResult(GetResourceAsBitmap(fSourceFilename, &fBitmap));
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPngEncoder::Options opts;
+        opts.fUnpremulBehavior = SkTransferFunctionBehavior::kIgnore;
+        opts.fZLibLevel = fZLibLevel;
+        opts.fExecutor = fExecutor.get();
+        while (loops-- > 0) {
+            SkPixmap pixmap;
+            SkAssertResult(fBitmap.peekPixels(&pixmap));
+            SkNullWStream dst;
+            SkAssertResult(SkPngEncoder::Encode(&dst, pixmap, opts));
+            SkASSERT(dst.bytesWritten() > 0);
+        }
+    }
+
+private:
+    const char*                 fSourceFilename;
+    int                         fZLibLevel;
+    int                         fThreads;
+    SkString                    fName;
+    SkBitmap                    fBitmap;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH(return new PngStripEncodeBench(srcs[0], 6, 1));
+DEF_BENCH(return new PngStripEncodeBench(srcs[0], 6, 2));
+DEF_BENCH(return new PngStripEncodeBench(srcs[0], 6, 4));
+DEF_BENCH(return new PngStripEncodeBench(srcs[0], 6, 8));
+DEF_BENCH(return new PngStripEncodeBench(srcs[0], 3, 4));
+DEF_BENCH(return new PngStripEncodeBench(srcs[0], 1, 4));
+DEF_BENCH(return new PngStripEncodeBench(srcs[0], 9, 4));
+
+DEF_BENCH(return new PngStripEncodeBench(srcs[1], 6, 1));
+DEF_BENCH(return new PngStripEncodeBench(srcs[1], 6, 2));
+DEF_BENCH(return new PngStripEncodeBench(srcs[1], 6, 4));
+DEF_BENCH(return new PngStripEncodeBench(srcs[1], 6, 8));
+DEF_BENCH(return new PngStripEncodeBench(srcs[1], 3, 4));
+DEF_BENCH(return new PngStripEncodeBench(srcs[1], 1, 4));
+DEF_BENCH(return new PngStripEncodeBench(srcs[1], 9, 4));
@@ -7,25 +7,69 @@
 
 #include "Benchmark.h"
 #include "SkCanvas.h"
+#include "SkExecutor.h"
+#include "SkGlyphCache.h"
 #include "SkGraphics.h"
 #include "SkPaint.h"
 #include "SkRandom.h"
+#include "SkStream.h"
 #include "SkString.h"
+#include "SkTArray.h"
+#include "SkTaskGroup.h"
+#include "SkTypeface.h"
 
 class FontScalerBench : public Benchmark {
     SkString fName;
     SkString fText;
     bool     fDoLCD;
+    int      fThreads;  // 0 draws through the canvas on the calling thread.
+
+    std::unique_ptr<SkExecutor> fExecutor;
+    SkTArray<sk_sp<SkTypeface>> fTypefaces;
 public:
-    FontScalerBench(bool doLCD)  {
+    FontScalerBench(bool doLCD, int threads = 0)  {
         fName.printf("fontscaler_%s", doLCD ? "lcd" : "aa");
+        if (threads > 0) {
+            fName.appendf("_threads_%d", threads);
+        }
         fText.set("abcdefghijklmnopqrstuvwxyz01234567890");
         fDoLCD = doLCD;
+        fThreads = threads;
     }
 
 protected:
-    virtual const char* onGetName() { return fName.c_str(); }
-    virtual void onDraw(int loops, SkCanvas* canvas) {
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return fThreads == 0 || backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        if (fThreads == 0) {
+            return;
+        }
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+
+        // Give each thread its own typeface, made from the same data, so that the threads only
+        // contend inside the font scaler if it serializes unrelated faces.
+        sk_sp<SkTypeface> base = SkTypeface::MakeDefault();
+        int ttcIndex;
+        std::unique_ptr<SkStreamAsset> stream(base->openStream(&ttcIndex));
+        for (int i = 0; i < fThreads; ++i) {
+            sk_sp<SkTypeface> face;
+            if (stream) {
+                face = SkTypeface::MakeFromStream(stream->duplicate().release(), ttcIndex);
+            }
+            fTypefaces.push_back(face ? std::move(face) : base);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        if (fThreads > 0) {
+            this->drawThreaded(loops);
+            return;
+        }
+
         SkPaint paint;
         this->setupPaint(&paint);
         paint.setLCDRenderText(fDoLCD);
@@ -42,7 +86,31 @@ protected:
             }
         }
     }
+
 private:
+    void drawThreaded(int loops) {
+        for (int i = 0; i < loops; i++) {
+            SkGraphics::PurgeFontCache();
+
+            SkTaskGroup(*fExecutor).batch(fThreads, [&](int threadIndex) {
+                SkPaint paint;
+                this->setupPaint(&paint);
+                paint.setLCDRenderText(fDoLCD);
+                paint.setTypeface(fTypefaces[threadIndex]);
+
+                for (int ps = 9; ps <= 24; ps += 2) {
+                    paint.setTextSize(SkIntToScalar(ps));
+                    SkAutoGlyphCache autoCache(paint, nullptr, nullptr);
+                    SkGlyphCache* cache = autoCache.getCache();
+                    for (size_t c = 0; c < fText.size(); ++c) {
+                        const SkGlyph& glyph = cache->getUnicharMetrics(fText[c]);
+                        cache->findImage(glyph);
+                    }
+                }
+            });
+        }
+    }
+
     typedef Benchmark INHERITED;
 };
 
@@ -50,3 +118,6 @@ private:
 
 DEF_BENCH(return new FontScalerBench(false);)
 DEF_BENCH(return new FontScalerBench(true);)
+DEF_BENCH(return new FontScalerBench(false, 1);)
+DEF_BENCH(return new FontScalerBench(false, 4);)
+DEF_BENCH(return new FontScalerBench(false, 16);)
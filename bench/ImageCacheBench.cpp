@@ -6,7 +6,10 @@
  */
 
 #include "Benchmark.h"
+#include "SkExecutor.h"
 #include "SkResourceCache.h"
+#include "SkString.h"
+#include "SkTaskGroup.h"
 
 namespace {
 static void* gGlobalAddress;
@@ -75,3 +78,67 @@ private:
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new ImageCacheBench(); )
+
+// Hammers the global (sharded) cache from several threads at once, mostly with hits plus the
+// occasional add, like many raster threads looking up scaled bitmaps and masks.
+class ImageCacheContentionBench : public Benchmark {
+    enum {
+        CACHE_COUNT = 500
+    };
+
+    int                         fThreads;
+    SkString                    fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+public:
+    ImageCacheContentionBench(int threads) : fThreads(threads) {
+        fName.printf("imagecache_contention_%d", threads);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+    }
+
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        for (int i = 0; i < CACHE_COUNT; ++i) {
+            SkResourceCache::Add(new TestRec(TestKey(i), i));
+        }
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        SkResourceCache::PurgeAll();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkTaskGroup tg(*fExecutor);
+        tg.batch(fThreads, [&](int thread) {
+            uint32_t seed = thread + 1;
+            for (int i = 0; i < loops; ++i) {
+                seed = seed * 1664525 + 1013904223;   // LCG
+                intptr_t value = (seed >> 8) % CACHE_COUNT;
+                if ((seed & 0xff) == 0) {
+                    SkResourceCache::Add(new TestRec(TestKey(value), value));
+                } else {
+                    SkResourceCache::Find(TestKey(value), TestRec::Visitor, nullptr);
+                }
+            }
+        });
+        tg.wait();
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new ImageCacheContentionBench(1); )
+DEF_BENCH( return new ImageCacheContentionBench(4); )
+DEF_BENCH( return new ImageCacheContentionBench(16); )
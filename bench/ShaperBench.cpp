@@ -0,0 +1,73 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkPaint.h"
+#include "SkShaper.h"
+#include "SkShaperCache.h"
+#include "SkString.h"
+#include "SkTextBlob.h"
+#include "SkTypeface.h"
+
+// Shapes a rotating set of short labels into blobs, as UI text that redraws the same labels
+// over and over would. Without the cache every label is reshaped each time; with it only the
+// first time.
+class ShaperBench : public Benchmark {
+    static constexpr int kLabelCount = 32;
+
+    SkString                       fName;
+    bool                           fCached;
+    SkPaint                        fPaint;
+    SkString                       fLabels[kLabelCount];
+    std::unique_ptr<SkShaper>      fShaper;
+    std::unique_ptr<SkShaperCache> fCache;
+
+public:
+    explicit ShaperBench(bool cached) : fCached(cached) {
+        fName.printf("shaper_labels_%s", cached ? "cached" : "uncached");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fPaint.setAntiAlias(true);
+        fPaint.setTextSize(14);
+        for (int i = 0; i < kLabelCount; ++i) {
+            fLabels[i].printf("Label %d: Quarterly total %d.%02d", i, i * 37, i * 13 % 100);
+        }
+        sk_sp<SkTypeface> typeface = SkTypeface::MakeDefault();
+        fShaper.reset(new SkShaper(typeface));
+        fCache.reset(new SkShaperCache(2 * kLabelCount));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            const SkString& label = fLabels[i % kLabelCount];
+            sk_sp<SkTextBlob> blob;
+            if (fCached) {
+                blob = fCache->shape(nullptr, fPaint, label.c_str(), label.size(), true);
+            } else {
+                SkTextBlobBuilder builder;
+                fShaper->shape(&builder, fPaint, label.c_str(), label.size(), true,
+                               SkPoint::Make(0, 0));
+                blob = builder.make();
+            }
+            SkASSERT(blob);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new ShaperBench(false); )
+DEF_BENCH( return new ShaperBench(true); )
@@ -109,7 +109,55 @@ private:
     SkString fName;
 };
 
+// Many threads drawing the same text at the same size all land on one strike, so this measures
+// how well concurrent readers of a single strike scale.
+class SkGlyphCacheSharedStrike : public Benchmark {
+public:
+    explicit SkGlyphCacheSharedStrike(int threads) : fThreads(threads) { }
+
+protected:
+    const char* onGetName() override {
+        fName.printf("SkGlyphCacheSharedStrike_%d", fThreads);
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fTypeface = sk_tool_utils::create_portable_typeface("serif", SkFontStyle::Italic());
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int work = 0; work < loops; work++) {
+            SkTaskGroup().batch(fThreads, [&](int) {
+                SkPaint paint;
+                paint.setAntiAlias(true);
+                paint.setTextSize(24);
+                paint.setTypeface(fTypeface);
+                SkAutoGlyphCacheNoGamma autoCache(paint, nullptr, nullptr);
+                SkGlyphCache* cache = autoCache.getCache();
+                for (int lookups = 0; lookups < 10; lookups++) {
+                    for (int c = ' '; c < 'z'; c++) {
+                        const SkGlyph& g = cache->getUnicharMetrics(c);
+                        cache->findImage(g);
+                    }
+                }
+            });
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+    const int fThreads;
+    sk_sp<SkTypeface> fTypeface;
+    SkString fName;
+};
+
 DEF_BENCH( return new SkGlyphCacheBasic(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheBasic(32 * 1024 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(32 * 1024 * 1024); )
+DEF_BENCH( return new SkGlyphCacheSharedStrike(1); )
+DEF_BENCH( return new SkGlyphCacheSharedStrike(16); )
@@ -6,8 +6,12 @@
  */
 
 #include "Benchmark.h"
+#include "SkBlitter.h"
+#include "SkColorSpace.h"
 #include "SkOpts.h"
 #include "SkRasterPipeline.h"
+#include "SkString.h"
+#include "SkTemplates.h"
 #include "../src/jumper/SkJumper.h"
 
 static const int N = 15;
@@ -104,6 +108,105 @@ private:
 DEF_BENCH( return (new SkRasterPipelineCompileVsRunBench(true )); )
 DEF_BENCH( return (new SkRasterPipelineCompileVsRunBench(false)); )
 
+// Measures just the per-draw cost of building and compiling a typical blitter pipeline,
+// without running it over any pixels.
+class SkRasterPipelineSetupBench : public Benchmark {
+public:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return "SkRasterPipeline_setup"; }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkJumper_MemoryCtx mask_ctx = {mask, 0},
+                            dst_ctx = {dst,  0};
+        const float color[] = { 0.25f, 0.5f, 0.75f, 1.0f };
+
+        SkSTArenaAlloc<1024> alloc;
+        while (loops --> 0) {
+            SkRasterPipeline p(&alloc);
+            p.append_constant_color(&alloc, color);
+            p.append(SkRasterPipeline::scale_u8, &mask_ctx);
+            p.append(SkRasterPipeline::move_src_dst);
+            p.append(SkRasterPipeline::load_8888, &dst_ctx);
+            p.append(SkRasterPipeline::srcover);
+            p.append(SkRasterPipeline::store_8888, &dst_ctx);
+            auto fn = p.compile();
+            alloc.reset();
+        }
+    }
+};
+DEF_BENCH( return (new SkRasterPipelineSetupBench); )
+
+// Measures the per-draw cost of creating an SkRasterPipelineBlitter for a solid color paint,
+// again without blitting anything.
+class SkRasterPipelineBlitterSetupBench : public Benchmark {
+public:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return "SkRasterPipeline_blitter_setup"; }
+
+    void onDraw(int loops, SkCanvas*) override {
+        // A tagged destination makes SkBlitter::Choose() pick SkRasterPipelineBlitter.
+        SkImageInfo info = SkImageInfo::MakeN32Premul(SK_ARRAY_COUNT(src), 1,
+                                                      SkColorSpace::MakeSRGB());
+        SkPixmap pixmap(info, src, sizeof(src));
+        SkPaint paint;
+        paint.setColor(0x80402010);
+
+        SkSTArenaAlloc<2048> alloc;
+        while (loops --> 0) {
+            SkBlitter::Choose(pixmap, SkMatrix::I(), paint, &alloc);
+            alloc.reset();
+        }
+    }
+};
+DEF_BENCH( return (new SkRasterPipelineBlitterSetupBench); )
+
+// Blits one row of antialiased runs shaped like a path edge: alternating 1-pixel partial
+// coverage runs with a few longer opaque and empty runs between them.
+class SkRasterPipelineBlitAntiHBench : public Benchmark {
+public:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return "SkRasterPipeline_blitAntiH"; }
+
+    void onDelayedSetup() override {
+        memset(fDst, 0, sizeof(fDst));
+        int x = 0;
+        while (x < kWidth) {
+            int run = 1;
+            SkAlpha alpha = SkToU8(17 * x);
+            switch (x % 32) {
+                case  8: run = 20; alpha = 0xff; break;
+                case 30: run =  8; alpha = 0x00; break;
+            }
+            run = SkTMin(run, kWidth - x);
+            fRuns[x] = SkToS16(run);
+            fAA[x]   = alpha;
+            x += run;
+        }
+        fRuns[kWidth] = 0;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        // A tagged destination makes SkBlitter::Choose() pick SkRasterPipelineBlitter.
+        SkImageInfo info = SkImageInfo::MakeN32Premul(kWidth, 1, SkColorSpace::MakeSRGB());
+        SkPixmap pixmap(info, fDst, sizeof(fDst));
+        SkPaint paint;
+        paint.setColor(0x80402010);
+
+        SkSTArenaAlloc<2048> alloc;
+        SkBlitter* blitter = SkBlitter::Choose(pixmap, SkMatrix::I(), paint, &alloc);
+        while (loops --> 0) {
+            blitter->blitAntiH(0,0, fAA, fRuns);
+        }
+    }
+
+private:
+    static constexpr int kWidth = 256;
+    uint32_t fDst[kWidth];
+    SkAlpha  fAA[kWidth];
+    int16_t  fRuns[kWidth + 1];
+};
+DEF_BENCH( return (new SkRasterPipelineBlitAntiHBench); )
+
 static SkColorSpaceTransferFn gamma(float g) {
     SkColorSpaceTransferFn fn = {0,0,0,0,0,0,0};
     fn.fG = g;
@@ -168,3 +271,46 @@ public:
     }
 };
 DEF_BENCH( return (new SkRasterPipelineToSRGB); )
+
+// A plain 8888 srcover blit of one row, the bread and butter of the lowp backends.
+// Wide rows show off the wider (e.g. 32-pixel skx_lowp) engines; narrow ones their tail handling.
+class SkRasterPipelineSrcover8888 : public Benchmark {
+public:
+    explicit SkRasterPipelineSrcover8888(int width) : fWidth(width) {
+        fName.printf("SkRasterPipeline_srcover_8888_%d", width);
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fSrc.reset(fWidth);
+        fDst.reset(fWidth);
+        for (int i = 0; i < fWidth; i++) {
+            fSrc[i] = 0x80402010 + i;  // Translucent, so srcover has to blend.
+            fDst[i] = 0xff102040;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkJumper_MemoryCtx src_ctx = {fSrc.get(), 0},
+                           dst_ctx = {fDst.get(), 0};
+
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipeline::load_8888, &src_ctx);
+        p.append(SkRasterPipeline::srcover_rgba_8888, &dst_ctx);
+
+        while (loops --> 0) {
+            p.run(0,0,fWidth,1);
+        }
+    }
+
+private:
+    SkString                fName;
+    int                     fWidth;
+    SkAutoTMalloc<uint32_t> fSrc,
+                            fDst;
+};
+DEF_BENCH( return (new SkRasterPipelineSrcover8888(  15)); )
+DEF_BENCH( return (new SkRasterPipelineSrcover8888( 256)); )
+DEF_BENCH( return (new SkRasterPipelineSrcover8888(1024)); )
@@ -34,6 +34,7 @@
 #include "SkData.h"
 #include "SkDebugfTracer.h"
 #include "SkEventTracingPriv.h"
+#include "SkExecutor.h"
 #include "SkGraphics.h"
 #include "SkLeanWindows.h"
 #include "SkOSFile.h"
@@ -133,6 +134,7 @@ DEFINE_string(benchType,  "",
         "Apply usual --match rules to bench type: micro, recording, piping, playback, skcodec, etc.");
 
 DEFINE_bool(forceRasterPipeline, false, "sets gSkForceRasterPipelineBlitter");
+DEFINE_bool(brdExecutor, false, "Decode BRD benches on the --threads thread pool?");
 
 static double now_ms() { return SkTime::GetNSecs() * 1e-6; }
 
@@ -915,7 +917,7 @@ public:
         }
 
         // Run AndroidCodecBenches
-        const int sampleSizes[] = { 2, 4, 8 };
+        const int sampleSizes[] = { 2, 4, 8, 16 };
         for (; fCurrentAndroidCodec < fImages.count(); fCurrentAndroidCodec++) {
             fSourceType = "image";
             fBenchType = "skandroidcodec";
@@ -1019,7 +1021,8 @@ public:
                         }
 
                         return new BitmapRegionDecoderBench(basename.c_str(), encoded.get(),
-                                colorType, sampleSize, subset);
+                                colorType, sampleSize, subset,
+                                FLAGS_brdExecutor ? &SkExecutor::GetDefault() : nullptr);
                     }
                     fCurrentSubsetType = 0;
                     fCurrentSampleSize++;
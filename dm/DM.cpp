@@ -934,6 +934,7 @@ static Sink* create_via(const SkString& tag, Sink* wrapped) {
     VIA("sp",        ViaSingletonPictures, wrapped);
     VIA("tiles",     ViaTiles, 256, 256, nullptr,            wrapped);
     VIA("tiles_rt",  ViaTiles, 256, 256, new SkRTreeFactory, wrapped);
+    VIA("threaded",  ViaThreaded, 8, 4,                      wrapped);
 
     if (FLAGS_matrix.count() == 4) {
         SkMatrix m;
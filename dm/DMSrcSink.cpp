@@ -48,6 +48,7 @@
 #include "SkStream.h"
 #include "SkSwizzler.h"
 #include "SkTaskGroup.h"
+#include "SkThreadedBMPDevice.h"
 #include "SkTLogic.h"
 #include <cmath>
 #include <functional>
@@ -2137,6 +2138,30 @@ Error ViaLite::draw(const Src& src, SkBitmap* bitmap, SkWStream* stream, SkStrin
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
+Error ViaThreaded::draw(const Src& src, SkBitmap* bitmap, SkWStream* stream, SkString* log) const {
+    return draw_to_canvas(fSink.get(), bitmap, stream, log, src.size(),
+                          [&](SkCanvas* canvas) -> Error {
+        SkPixmap pixmap;
+        if (!canvas->peekPixels(&pixmap)) {
+            return Error::Nonfatal("threaded only works with raster sinks.");
+        }
+        SkBitmap dst;
+        dst.installPixels(pixmap);
+        {
+            sk_sp<SkThreadedBMPDevice> device(new SkThreadedBMPDevice(dst, fTileCnt, fThreadCnt));
+            SkCanvas threadedCanvas(device.get());
+            Error err = src.draw(&threadedCanvas);
+            if (!err.isEmpty()) {
+                return err;
+            }
+            threadedCanvas.flush();
+        }
+        return check_against_reference(bitmap, src, fSink.get());
+    });
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
 ViaCSXform::ViaCSXform(Sink* sink, sk_sp<SkColorSpace> cs, bool colorSpin)
     : Via(sink)
     , fCS(std::move(cs))
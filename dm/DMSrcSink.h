@@ -528,6 +528,17 @@ public:
     Error draw(const Src&, SkBitmap*, SkWStream*, SkString*) const override;
 };
 
+// Draw through an SkThreadedBMPDevice that renders straight into the wrapped raster sink's pixels.
+class ViaThreaded : public Via {
+public:
+    ViaThreaded(int tiles, int threads, Sink* sink)
+        : Via(sink), fTileCnt(tiles), fThreadCnt(threads) {}
+    Error draw(const Src&, SkBitmap*, SkWStream*, SkString*) const override;
+private:
+    const int fTileCnt;
+    const int fThreadCnt;
+};
+
 class ViaCSXform : public Via {
 public:
     explicit ViaCSXform(Sink*, sk_sp<SkColorSpace>, bool colorSpin);
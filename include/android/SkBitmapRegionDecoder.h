@@ -13,6 +13,8 @@
 #include "SkEncodedImageFormat.h"
 #include "SkStream.h"
 
+class SkExecutor;
+
 /*
  * This class aims to provide an interface to test multiple implementations of
  * SkBitmapRegionDecoder.
@@ -75,6 +77,12 @@ public:
     int width() const { return fWidth; }
     int height() const { return fHeight; }
 
+    /*
+     * If not NULL, regions may be decoded in parallel on this executor, when the encoded
+     * format allows it.  The executor is unowned and must outlive any calls to decodeRegion().
+     */
+    void setExecutor(SkExecutor* executor) { fExecutor = executor; }
+
     virtual ~SkBitmapRegionDecoder() {}
 
 protected:
@@ -82,11 +90,15 @@ protected:
     SkBitmapRegionDecoder(int width, int height)
         : fWidth(width)
         , fHeight(height)
+        , fExecutor(nullptr)
     {}
 
+    SkExecutor* executor() const { return fExecutor; }
+
 private:
     const int fWidth;
     const int fHeight;
+    SkExecutor* fExecutor;
 };
 
 #endif
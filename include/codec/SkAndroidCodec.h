@@ -152,6 +152,7 @@ public:
             : fZeroInitialized(SkCodec::kNo_ZeroInitialized)
             , fSubset(nullptr)
             , fSampleSize(1)
+            , fExecutor(nullptr)
         {}
 
         /**
@@ -181,6 +182,14 @@ public:
          *  The default is 1, representing no downscaling.
          */
         int fSampleSize;
+
+        /**
+         *  Passed on to SkCodec::Options::fExecutor for decodes that the codec scales
+         *  natively, and for subset decodes.
+         *
+         *  The default is NULL, meaning the decode runs on the calling thread.
+         */
+        SkExecutor* fExecutor;
     };
 
     /**
@@ -26,6 +26,7 @@
 
 class SkColorSpace;
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkPngChunkReader;
 class SkSampler;
@@ -249,6 +250,7 @@ public:
             , fFrameIndex(0)
             , fPriorFrame(kNone)
             , fPremulBehavior(SkTransferFunctionBehavior::kRespect)
+            , fExecutor(nullptr)
         {}
 
         ZeroInitialized            fZeroInitialized;
@@ -300,6 +302,17 @@ public:
          *  we will always do a legacy premultiply.
          */
         SkTransferFunctionBehavior fPremulBehavior;
+
+        /**
+         *  If not NULL, codecs that can split the image into independently encoded parts
+         *  may decode them in parallel on this executor.  Currently only JPEG images with
+         *  restart markers at the start of MCU rows are split, in getPixels() and
+         *  incremental decodes, and only when the codec's stream is in memory (see
+         *  SkStream::getMemoryBase()).
+         *
+         *  The executor is unowned and must remain valid until the decode is finished.
+         */
+        SkExecutor*                fExecutor;
     };
 
     /**
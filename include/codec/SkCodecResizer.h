@@ -0,0 +1,46 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCodecResizer_DEFINED
+#define SkCodecResizer_DEFINED
+
+#include "SkCodec.h"
+
+class SkPixmap;
+
+/**
+ *  Decodes an SkCodec's image directly to a different size, one scanline at a time, so the
+ *  full size image is never held in memory.
+ */
+class SK_API SkCodecResizer {
+public:
+    enum Filter {
+        kBox_Filter,
+        kTriangle_Filter,
+        kMitchell_Filter,   // Mitchell-Netravali cubic, B = C = 1/3.
+    };
+
+    /**
+     *  Decode the image in codec, resampled with filter to the dimensions of dst.
+     *
+     *  If the codec can natively scale to a size that is at least as large as dst, it
+     *  decodes at that size first.  Source rows are read with SkCodec::getScanlines() and
+     *  filtered horizontally as they arrive.  Only as many filtered rows as the vertical
+     *  filter spans are kept, so memory use is proportional to dst's width times the
+     *  number of filter taps.
+     *
+     *  dst must be kRGBA_8888, kBGRA_8888 or kGray_8.  The codec must support scanline
+     *  decoding in kTopDown_SkScanlineOrder.
+     *
+     *  @return kSuccess, or kIncompleteInput if the codec ran out of data, in which case
+     *          the codec's fill for the missing rows has been resampled into dst.
+     *          Otherwise a value explaining the failure.
+     */
+    static SkCodec::Result Resize(SkCodec* codec, const SkPixmap& dst, Filter filter);
+};
+
+#endif // SkCodecResizer_DEFINED
@@ -96,6 +96,20 @@ public:
      */
     static int SetFontCachePointSizeLimit(int maxPointSize);
 
+    /**
+     *  Keep the font cache's glyph metrics, images and paths in the file at path, so that later
+     *  processes can read them back instead of generating them again. The file is read now, and
+     *  is written only by FlushFontCacheStore(). It will not grow past maxBytes. Strikes created
+     *  before this call do not use the file. Pass nullptr to stop using a file.
+     */
+    static void SetFontCacheStore(const char path[], size_t maxBytes);
+
+    /**
+     *  Write the file set by SetFontCacheStore(). Returns false if there is no such file or it
+     *  could not be written.
+     */
+    static bool FlushFontCacheStore();
+
     /**
      *  For debugging purposes, this will attempt to purge the font cache. It
      *  does not change the limit, but will cause subsequent font measures and
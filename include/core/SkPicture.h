@@ -12,10 +12,14 @@
 #include "SkRect.h"
 #include "SkTypes.h"
 
+#include <functional>
+#include <memory>
+
 class SkBigPicture;
 class SkCanvas;
 class SkData;
 struct SkDeserialProcs;
+class SkExecutor;
 class SkImage;
 class SkPictureData;
 class SkReadBuffer;
@@ -79,6 +83,18 @@ public:
     */
     virtual void playback(SkCanvas*, AbortCallback* = nullptr) const = 0;
 
+    /** Replays the drawing commands over a grid of tileSize tiles covering the cull rect,
+        drawing the tiles concurrently on executor (or SkExecutor::GetDefault() if null).
+
+        makeTileCanvas is called once for each tile, possibly from several threads at once, and
+        should return a canvas whose origin is the tile's top-left corner, or null to skip the
+        tile. Each tile only replays the ops whose bounds touch it, so large pictures don't make
+        every thread walk every op. This returns once all tiles are drawn.
+    */
+    void playbackParallel(
+            const std::function<std::unique_ptr<SkCanvas>(const SkIRect& tile)>& makeTileCanvas,
+            const SkISize& tileSize, SkExecutor* executor = nullptr) const;
+
     /** Return a cull rect for this picture.
         Ops recorded into this picture that attempt to draw outside the cull might not be drawn.
      */
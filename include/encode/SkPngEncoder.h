@@ -11,6 +11,7 @@
 #include "SkEncoder.h"
 #include "SkDataTable.h"
 
+class SkExecutor;
 class SkPngEncoderMgr;
 class SkWStream;
 
@@ -66,6 +67,18 @@ public:
          *  and the (2i + 1)-th entry is the text for the i-th comment.
          */
         sk_sp<SkDataTable> fComments;
+
+        /**
+         *  If this is nullptr, libpng filters and compresses the rows one at a time on the
+         *  calling thread.  Otherwise the rows are split into horizontal strips that are
+         *  filtered and compressed independently on this executor, then stitched into a single
+         *  zlib stream.  The output is a valid png that may be slightly larger than a serial
+         *  encode.  Strips never span calls to encodeRows(), so this works best when encoding
+         *  many rows at a time.
+         *
+         *  |fExecutor| is unowned and must remain valid for the lifetime of the encoder.
+         */
+        SkExecutor* fExecutor = nullptr;
     };
 
     /**
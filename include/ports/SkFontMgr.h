@@ -15,6 +15,7 @@
 
 class SkData;
 class SkFontData;
+class SkFontMatchCache;
 class SkStreamAsset;
 class SkString;
 class SkTypeface;
@@ -37,6 +38,9 @@ private:
 
 class SK_API SkFontMgr : public SkRefCnt {
 public:
+    SkFontMgr();
+    ~SkFontMgr() override;
+
     int countFamilies() const;
     void getFamilyName(int index, SkString* familyName) const;
     SkFontStyleSet* createStyleSet(int index) const;
@@ -158,6 +162,9 @@ private:
     /** Implemented by porting layer to return the default factory. */
     static sk_sp<SkFontMgr> Factory();
 
+    /** What matchFamilyStyle, matchFamilyStyleCharacter and legacyMakeTypeface returned. */
+    std::unique_ptr<SkFontMatchCache> fMatchCache;
+
     typedef SkRefCnt INHERITED;
 };
 
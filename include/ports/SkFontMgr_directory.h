@@ -18,4 +18,12 @@ class SkFontMgr;
  */
 SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir);
 
+/** As above, but keeps the family and style of each face found in the file at indexPath.
+ *  Font files that have not changed since the index was written are not scanned until used;
+ *  only their size, modification time and first and last few KB are checked, so creating the
+ *  font manager costs little more than listing the directory.
+ *  The index is rewritten if any file has been added, changed or removed.
+ */
+SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir, const char* indexPath);
+
 #endif // SkFontMgr_directory_DEFINED
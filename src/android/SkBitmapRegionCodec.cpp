@@ -105,6 +105,7 @@ bool SkBitmapRegionCodec::decodeRegion(SkBitmap* bitmap, SkBRDAllocator* allocat
     options.fSampleSize = sampleSize;
     options.fSubset = &subset;
     options.fZeroInitialized = zeroInit;
+    options.fExecutor = this->executor();
     void* dst = bitmap->getAddr(scaledOutX, scaledOutY);
 
     SkCodec::Result result = fCodec->getAndroidPixels(decodeInfo, dst, bitmap->rowBytes(),
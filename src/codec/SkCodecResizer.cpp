@@ -0,0 +1,246 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCodecResizer.h"
+#include "SkPixmap.h"
+#include "SkTDArray.h"
+#include "SkTemplates.h"
+
+#include <math.h>
+
+// The kernels are evaluated in source pixels at a 1:1 scale.
+static float box_kernel(float x) {
+    return (x >= -0.5f && x < 0.5f) ? 1.0f : 0.0f;
+}
+
+static float triangle_kernel(float x) {
+    x = fabsf(x);
+    return x < 1.0f ? 1.0f - x : 0.0f;
+}
+
+static float mitchell_kernel(float x) {
+    const float B = 1.0f / 3.0f;
+    const float C = 1.0f / 3.0f;
+    x = fabsf(x);
+    if (x < 1.0f) {
+        return ((12 - 9 * B - 6 * C) * x * x * x +
+                (-18 + 12 * B + 6 * C) * x * x +
+                (6 - 2 * B)) * (1.0f / 6.0f);
+    }
+    if (x < 2.0f) {
+        return ((-B - 6 * C) * x * x * x +
+                (6 * B + 30 * C) * x * x +
+                (-12 * B - 48 * C) * x +
+                (8 * B + 24 * C)) * (1.0f / 6.0f);
+    }
+    return 0.0f;
+}
+
+namespace {
+
+/*
+ *  For each destination coordinate, the span of source coordinates that contribute to it
+ *  and their normalized weights.  The spans never move backwards, so a destination row can
+ *  be produced once the last source row of its span has been read.
+ */
+class ResizeFilter {
+public:
+    struct Span {
+        int fStart;
+        int fCount;
+        int fWeightOffset;
+    };
+
+    ResizeFilter(SkCodecResizer::Filter filter, int srcSize, int dstSize)
+        : fMaxCount(0)
+    {
+        float (*kernel)(float) = box_kernel;
+        float support = 0.5f;
+        switch (filter) {
+            case SkCodecResizer::kBox_Filter:
+                break;
+            case SkCodecResizer::kTriangle_Filter:
+                kernel = triangle_kernel;
+                support = 1.0f;
+                break;
+            case SkCodecResizer::kMitchell_Filter:
+                kernel = mitchell_kernel;
+                support = 2.0f;
+                break;
+        }
+
+        // When downscaling, stretch the kernel to cover every source pixel.
+        const float ratio = (float) srcSize / dstSize;
+        const float scale = SkTMax(ratio, 1.0f);
+        const float invScale = 1.0f / scale;
+        support *= scale;
+
+        fSpans.setCount(dstSize);
+        for (int i = 0; i < dstSize; i++) {
+            const float center = (i + 0.5f) * ratio;
+            const int left = SkTMax(0, (int) floorf(center - support));
+            const int right = SkTMin(srcSize, (int) ceilf(center + support));
+
+            Span& span = fSpans[i];
+            span.fStart = left;
+            span.fCount = right - left;
+            span.fWeightOffset = fWeights.count();
+
+            float* weights = fWeights.append(span.fCount);
+            float sum = 0.0f;
+            for (int j = 0; j < span.fCount; j++) {
+                weights[j] = kernel(((left + j + 0.5f) - center) * invScale);
+                sum += weights[j];
+            }
+
+            if (sum != 0.0f) {
+                const float invSum = 1.0f / sum;
+                for (int j = 0; j < span.fCount; j++) {
+                    weights[j] *= invSum;
+                }
+            } else {
+                // Fall back to the nearest source pixel.
+                const int nearest = SkTPin((int) center, left, right - 1);
+                for (int j = 0; j < span.fCount; j++) {
+                    weights[j] = (left + j == nearest) ? 1.0f : 0.0f;
+                }
+            }
+
+            fMaxCount = SkTMax(fMaxCount, span.fCount);
+        }
+    }
+
+    const Span& span(int i) const { return fSpans[i]; }
+    const float* weights(const Span& span) const { return &fWeights[span.fWeightOffset]; }
+    int maxCount() const { return fMaxCount; }
+
+private:
+    SkTDArray<Span>  fSpans;
+    SkTDArray<float> fWeights;
+    int              fMaxCount;
+};
+
+}  // namespace
+
+static void filter_row(const ResizeFilter& filter, const uint8_t* src, int channels,
+                       float* dst, int dstWidth) {
+    for (int x = 0; x < dstWidth; x++) {
+        const ResizeFilter::Span& span = filter.span(x);
+        const float* weights = filter.weights(span);
+        const uint8_t* srcPtr = src + span.fStart * channels;
+        for (int c = 0; c < channels; c++) {
+            dst[c] = 0.0f;
+        }
+        for (int i = 0; i < span.fCount; i++) {
+            for (int c = 0; c < channels; c++) {
+                dst[c] += weights[i] * srcPtr[c];
+            }
+            srcPtr += channels;
+        }
+        dst += channels;
+    }
+}
+
+SkCodec::Result SkCodecResizer::Resize(SkCodec* codec, const SkPixmap& dst, Filter filter) {
+    if (!codec || !dst.addr() || dst.width() <= 0 || dst.height() <= 0) {
+        return SkCodec::kInvalidParameters;
+    }
+
+    // Each destination channel is resampled from 8-bit source channels.
+    switch (dst.colorType()) {
+        case kRGBA_8888_SkColorType:
+        case kBGRA_8888_SkColorType:
+        case kGray_8_SkColorType:
+            break;
+        default:
+            return SkCodec::kInvalidConversion;
+    }
+
+    // Let the codec do as much of the downscaling as it can, as long as it leaves at
+    // least one source pixel per destination pixel.
+    SkISize srcSize = codec->getInfo().dimensions();
+    const float desiredScale = SkTMax((float) dst.width() / srcSize.width(),
+                                      (float) dst.height() / srcSize.height());
+    if (desiredScale < 1.0f) {
+        const SkISize scaledSize = codec->getScaledDimensions(desiredScale);
+        if (scaledSize.width() >= dst.width() && scaledSize.height() >= dst.height()) {
+            srcSize = scaledSize;
+        }
+    }
+
+    const SkImageInfo srcInfo = dst.info().makeWH(srcSize.width(), srcSize.height());
+    SkCodec::Result result = codec->startScanlineDecode(srcInfo);
+    if (SkCodec::kSuccess != result) {
+        return result;
+    }
+    if (SkCodec::kTopDown_SkScanlineOrder != codec->getScanlineOrder()) {
+        return SkCodec::kUnimplemented;
+    }
+
+    const int dstWidth = dst.width();
+    const int dstHeight = dst.height();
+    const int channels = dst.info().bytesPerPixel();
+    const int rowFloats = dstWidth * channels;
+    const bool clampToAlpha = 4 == channels && kPremul_SkAlphaType == dst.alphaType();
+    const ResizeFilter xFilter(filter, srcSize.width(), dstWidth);
+    const ResizeFilter yFilter(filter, srcSize.height(), dstHeight);
+
+    // Horizontally filtered source rows, indexed by source row modulo ringRows.
+    const int ringRows = yFilter.maxCount();
+    SkAutoTMalloc<float> ring(ringRows * rowFloats);
+    SkAutoTMalloc<float> accum(rowFloats);
+    SkAutoTMalloc<uint8_t> srcRow(srcSize.width() * channels);
+
+    bool incomplete = false;
+    int nextSrcRow = 0;
+    for (int y = 0; y < dstHeight; y++) {
+        const ResizeFilter::Span& span = yFilter.span(y);
+
+        // Rows above the span are not needed by this or any later destination row.
+        if (nextSrcRow < span.fStart) {
+            if (!codec->skipScanlines(span.fStart - nextSrcRow)) {
+                incomplete = true;
+            }
+            nextSrcRow = span.fStart;
+        }
+
+        for (; nextSrcRow < span.fStart + span.fCount; nextSrcRow++) {
+            // On incomplete input, SkCodec fills the rows it could not decode.
+            if (1 != codec->getScanlines(srcRow.get(), 1, 0)) {
+                incomplete = true;
+            }
+            filter_row(xFilter, srcRow.get(), channels,
+                       ring.get() + (nextSrcRow % ringRows) * rowFloats, dstWidth);
+        }
+
+        const float* weights = yFilter.weights(span);
+        sk_bzero(accum.get(), rowFloats * sizeof(float));
+        for (int i = 0; i < span.fCount; i++) {
+            const float* row = ring.get() + ((span.fStart + i) % ringRows) * rowFloats;
+            for (int j = 0; j < rowFloats; j++) {
+                accum[j] += weights[i] * row[j];
+            }
+        }
+
+        uint8_t* dstRow = (uint8_t*) dst.writable_addr(0, y);
+        for (int j = 0; j < rowFloats; j++) {
+            dstRow[j] = (uint8_t) SkTPin((int) (accum[j] + 0.5f), 0, 255);
+        }
+
+        // Negative lobes can push colors above alpha.
+        if (clampToAlpha) {
+            for (int x = 0; x < dstWidth; x++) {
+                uint8_t* pixel = dstRow + 4 * x;
+                pixel[0] = SkTMin(pixel[0], pixel[3]);
+                pixel[1] = SkTMin(pixel[1], pixel[3]);
+                pixel[2] = SkTMin(pixel[2], pixel[3]);
+            }
+        }
+    }
+
+    return incomplete ? SkCodec::kIncompleteInput : SkCodec::kSuccess;
+}
@@ -11,10 +11,15 @@
 #include "SkCodecPriv.h"
 #include "SkColorData.h"
 #include "SkColorSpace_Base.h"
+#include "SkData.h"
+#include "SkExecutor.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkTypes.h"
 
+#include <vector>
+
 // stdio is needed for libjpeg-turbo
 #include <stdio.h>
 #include "SkJpegUtility.h"
@@ -300,8 +305,30 @@ SkJpegCodec::SkJpegCodec(int width, int height, const SkEncodedInfo& info,
     , fSwizzleSrcRow(nullptr)
     , fColorXformSrcRow(nullptr)
     , fSwizzlerSubset(SkIRect::MakeEmpty())
+    , fIncrementalDst(nullptr)
+    , fIncrementalRowBytes(0)
+    , fIncrementalFirstRow(0)
+    , fIncrementalRowCount(0)
+    , fIncrementalRowsDecoded(0)
+    , fIncrementalSubset(SkIRect::MakeEmpty())
+    , fTriedRestartIndex(false)
 {}
 
+/*
+ * Where the restart intervals of a single scan jpeg begin and end in the encoded data.
+ * Only built for images whose restart intervals each cover whole MCU rows.
+ */
+struct SkJpegCodec::RestartIndex {
+    sk_sp<SkData>       fData;
+    size_t              fHeightOffset;     // Offset of the 16-bit image height in the SOF.
+    size_t              fScanOffset;       // Offset of the first entropy coded byte.
+    std::vector<size_t> fIntervalEnds;     // Offset of the RSTn or EOI marker ending each interval.
+    int                 fMCUHeight;        // In pixels, before scaling.
+    int                 fMCURowsPerInterval;
+};
+
+SkJpegCodec::~SkJpegCodec() {}
+
 /*
  * Return the row bytes of a particular image type and width
  */
@@ -491,43 +518,50 @@ bool SkJpegCodec::onDimensionsSupported(const SkISize& size) {
 
 int SkJpegCodec::readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count,
                           const Options& opts) {
+    return this->readRows(fDecoderMgr.get(), fSwizzleSrcRow, fColorXformSrcRow, dstInfo, dst,
+                          rowBytes, count, opts);
+}
+
+int SkJpegCodec::readRows(JpegDecoderMgr* decoderMgr, uint8_t* swizzleSrcRow,
+                          uint32_t* colorXformSrcRow, const SkImageInfo& dstInfo, void* dst,
+                          size_t rowBytes, int count, const Options& opts) {
     // Set the jump location for libjpeg-turbo errors
-    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr->errorMgr());
     if (setjmp(jmp)) {
         return 0;
     }
 
-    // When fSwizzleSrcRow is non-null, it means that we need to swizzle.  In this case,
-    // we will always decode into fSwizzlerSrcRow before swizzling into the next buffer.
+    // When swizzleSrcRow is non-null, it means that we need to swizzle.  In this case,
+    // we will always decode into swizzleSrcRow before swizzling into the next buffer.
     // We can never swizzle "in place" because the swizzler may perform sampling and/or
     // subsetting.
-    // When fColorXformSrcRow is non-null, it means that we need to color xform and that
+    // When colorXformSrcRow is non-null, it means that we need to color xform and that
     // we cannot color xform "in place" (many times we can, but not when the dst is F16).
-    // In this case, we will color xform from fColorXformSrcRow into the dst.
+    // In this case, we will color xform from colorXformSrcRow into the dst.
     JSAMPLE* decodeDst = (JSAMPLE*) dst;
     uint32_t* swizzleDst = (uint32_t*) dst;
     size_t decodeDstRowBytes = rowBytes;
     size_t swizzleDstRowBytes = rowBytes;
     int dstWidth = opts.fSubset ? opts.fSubset->width() : dstInfo.width();
-    if (fSwizzleSrcRow && fColorXformSrcRow) {
-        decodeDst = (JSAMPLE*) fSwizzleSrcRow;
-        swizzleDst = fColorXformSrcRow;
+    if (swizzleSrcRow && colorXformSrcRow) {
+        decodeDst = (JSAMPLE*) swizzleSrcRow;
+        swizzleDst = colorXformSrcRow;
         decodeDstRowBytes = 0;
         swizzleDstRowBytes = 0;
         dstWidth = fSwizzler->swizzleWidth();
-    } else if (fColorXformSrcRow) {
-        decodeDst = (JSAMPLE*) fColorXformSrcRow;
-        swizzleDst = fColorXformSrcRow;
+    } else if (colorXformSrcRow) {
+        decodeDst = (JSAMPLE*) colorXformSrcRow;
+        swizzleDst = colorXformSrcRow;
         decodeDstRowBytes = 0;
         swizzleDstRowBytes = 0;
-    } else if (fSwizzleSrcRow) {
-        decodeDst = (JSAMPLE*) fSwizzleSrcRow;
+    } else if (swizzleSrcRow) {
+        decodeDst = (JSAMPLE*) swizzleSrcRow;
         decodeDstRowBytes = 0;
         dstWidth = fSwizzler->swizzleWidth();
     }
 
     for (int y = 0; y < count; y++) {
-        uint32_t lines = jpeg_read_scanlines(fDecoderMgr->dinfo(), &decodeDst, 1);
+        uint32_t lines = jpeg_read_scanlines(decoderMgr->dinfo(), &decodeDst, 1);
         if (0 == lines) {
             return y;
         }
@@ -605,6 +639,14 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
 
     this->allocateStorage(dstInfo);
 
+    if (options.fExecutor) {
+        Result result = this->decodeRestartIntervals(dstInfo, dst, dstRowBytes, options, 0,
+                                                     dstInfo.height(), rowsDecoded);
+        if (kUnimplemented != result) {
+            return result;
+        }
+    }
+
     int rows = this->readRows(dstInfo, dst, dstRowBytes, dstInfo.height(), options);
     if (rows < dstInfo.height()) {
         *rowsDecoded = rows;
@@ -614,21 +656,27 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
     return kSuccess;
 }
 
-void SkJpegCodec::allocateStorage(const SkImageInfo& dstInfo) {
+void SkJpegCodec::getStorageBytes(const SkImageInfo& dstInfo, size_t* swizzleBytes,
+                                  size_t* xformBytes) const {
     int dstWidth = dstInfo.width();
 
-    size_t swizzleBytes = 0;
+    *swizzleBytes = 0;
     if (fSwizzler) {
-        swizzleBytes = get_row_bytes(fDecoderMgr->dinfo());
+        *swizzleBytes = get_row_bytes(fDecoderMgr->dinfo());
         dstWidth = fSwizzler->swizzleWidth();
-        SkASSERT(!this->colorXform() || SkIsAlign4(swizzleBytes));
+        SkASSERT(!this->colorXform() || SkIsAlign4(*swizzleBytes));
     }
 
-    size_t xformBytes = 0;
+    *xformBytes = 0;
     if (this->colorXform() && (kRGBA_F16_SkColorType == dstInfo.colorType() ||
                                kRGB_565_SkColorType == dstInfo.colorType())) {
-        xformBytes = dstWidth * sizeof(uint32_t);
+        *xformBytes = dstWidth * sizeof(uint32_t);
     }
+}
+
+void SkJpegCodec::allocateStorage(const SkImageInfo& dstInfo) {
+    size_t swizzleBytes, xformBytes;
+    this->getStorageBytes(dstInfo, &swizzleBytes, &xformBytes);
 
     size_t totalBytes = swizzleBytes + xformBytes;
     if (totalBytes > 0) {
@@ -770,6 +818,416 @@ bool SkJpegCodec::onSkipScanlines(int count) {
     return (uint32_t) count == jpeg_skip_scanlines(fDecoderMgr->dinfo(), count);
 }
 
+SkCodec::Result SkJpegCodec::onStartIncrementalDecode(const SkImageInfo& dstInfo, void* pixels,
+        size_t rowBytes, const Options& options) {
+    // Setting up the decode is the same as for a scanline decode, which only looks at the
+    // x-dimension of the subset.
+    Result result = this->onStartScanlineDecode(dstInfo, options);
+    if (kSuccess != result) {
+        return result;
+    }
+
+    fIncrementalDst = pixels;
+    fIncrementalRowBytes = rowBytes;
+    fIncrementalFirstRow = 0;
+    fIncrementalRowCount = dstInfo.height();
+    fIncrementalRowsDecoded = 0;
+    if (options.fSubset) {
+        fIncrementalSubset = *options.fSubset;
+        fIncrementalFirstRow = fIncrementalSubset.top();
+        fIncrementalRowCount = fIncrementalSubset.height();
+    }
+    return kSuccess;
+}
+
+SkCodec::Result SkJpegCodec::onIncrementalDecode(int* rowsDecoded) {
+    Options options = this->options();
+    if (options.fSubset) {
+        options.fSubset = &fIncrementalSubset;
+    }
+
+    // SkSampledCodec may ask the swizzler to sample rows, in which case only every
+    // sampleY'th row of the subset is written to the destination.
+    const int sampleY = fSwizzler ? fSwizzler->sampleY() : 1;
+    const int rowsNeeded = get_scaled_dimension(fIncrementalRowCount, sampleY);
+
+    // Only the first call may split the image, since the rows decoded so far may have come
+    // from either path.
+    if (1 == sampleY && 0 == fIncrementalRowsDecoded &&
+            0 == fDecoderMgr->dinfo()->output_scanline &&
+            (options.fExecutor || fIncrementalFirstRow > 0)) {
+        int rows = 0;
+        Result result = this->decodeRestartIntervals(this->dstInfo(), fIncrementalDst,
+                                                     fIncrementalRowBytes, options,
+                                                     fIncrementalFirstRow, fIncrementalRowCount,
+                                                     &rows);
+        if (kSuccess == result) {
+            fIncrementalRowsDecoded = fIncrementalRowCount;
+            return kSuccess;
+        }
+        if (kUnimplemented != result) {
+            // Finish serially, starting at the first row that was not decoded.
+            fIncrementalRowsDecoded = rows;
+        }
+    }
+
+    // Set the jump location for libjpeg errors
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        if (rowsDecoded) {
+            *rowsDecoded = fIncrementalRowsDecoded;
+        }
+        return fDecoderMgr->returnFailure("onIncrementalDecode", kIncompleteInput);
+    }
+
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    while (fIncrementalRowsDecoded < rowsNeeded) {
+        const uint32_t nextRow = fIncrementalFirstRow + get_start_coord(sampleY) +
+                                 fIncrementalRowsDecoded * sampleY;
+        if (dinfo->output_scanline < nextRow) {
+            jpeg_skip_scanlines(dinfo, nextRow - dinfo->output_scanline);
+        }
+        if (dinfo->output_scanline != nextRow) {
+            break;
+        }
+
+        // Without sampling, the remaining rows are contiguous.
+        const int count = 1 == sampleY ? rowsNeeded - fIncrementalRowsDecoded : 1;
+        void* dst = SkTAddOffset<void>(fIncrementalDst,
+                                       fIncrementalRowsDecoded * fIncrementalRowBytes);
+        const int rows = this->readRows(this->dstInfo(), dst, fIncrementalRowBytes, count,
+                                        options);
+        fIncrementalRowsDecoded += rows;
+        if (rows < count) {
+            break;
+        }
+    }
+
+    if (fIncrementalRowsDecoded < rowsNeeded) {
+        if (rowsDecoded) {
+            *rowsDecoded = fIncrementalRowsDecoded;
+        }
+        return kIncompleteInput;
+    }
+
+    return kSuccess;
+}
+
+/*
+ * Finds the SOF image height and the start of the first scan.  Only baseline and extended
+ * sequential huffman images are accepted.
+ */
+static bool find_first_scan(const uint8_t* data, size_t size, size_t* heightOffset,
+                            size_t* scanOffset) {
+    if (size < 2 || 0xFF != data[0] || 0xD8 != data[1]) {
+        return false;
+    }
+
+    bool foundSOF = false;
+    size_t pos = 2;
+    while (pos + 4 <= size) {
+        if (0xFF != data[pos]) {
+            return false;
+        }
+
+        const uint8_t marker = data[pos + 1];
+        if (0xFF == marker) {
+            // Fill byte
+            pos++;
+            continue;
+        }
+
+        if ((marker >= 0xD0 && marker <= 0xD9) || 0x01 == marker) {
+            // Unexpected standalone marker
+            return false;
+        }
+
+        const size_t length = (data[pos + 2] << 8) | data[pos + 3];
+        if (length < 2) {
+            return false;
+        }
+
+        switch (marker) {
+            case 0xC0:
+            case 0xC1:
+                // Length (2 bytes), precision (1 byte), height (2 bytes), ...
+                if (foundSOF || length < 8 || pos + 7 > size) {
+                    return false;
+                }
+                *heightOffset = pos + 5;
+                foundSOF = true;
+                break;
+            case 0xC4:
+            case 0xC8:
+            case 0xCC:
+                // DHT, JPG and DAC, not SOF markers
+                break;
+            case 0xDA:
+                *scanOffset = pos + 2 + length;
+                return foundSOF && *scanOffset <= size;
+            default:
+                if (marker >= 0xC2 && marker <= 0xCF) {
+                    // Progressive, lossless, hierarchical or arithmetic coding
+                    return false;
+                }
+                break;
+        }
+
+        pos += 2 + length;
+    }
+
+    return false;
+}
+
+/*
+ * Records the offset of each RSTn marker in the scan starting at scanOffset, and of the EOI.
+ * Fails unless the scan ends at an EOI after exactly numIntervals intervals.
+ */
+static bool find_restart_markers(const uint8_t* data, size_t size, size_t scanOffset,
+                                 int numIntervals, std::vector<size_t>* intervalEnds) {
+    intervalEnds->reserve(numIntervals);
+
+    const uint8_t* ptr = data + scanOffset;
+    const uint8_t* end = data + size;
+    while (ptr < end) {
+        ptr = (const uint8_t*) memchr(ptr, 0xFF, end - ptr);
+        if (!ptr || ptr + 1 >= end) {
+            return false;
+        }
+
+        const uint8_t marker = ptr[1];
+        if (0x00 == marker) {
+            // Stuffed zero, this is entropy coded data
+            ptr += 2;
+            continue;
+        }
+        if (0xFF == marker) {
+            // Fill byte
+            ptr++;
+            continue;
+        }
+
+        const int count = (int) intervalEnds->size();
+        if (marker >= 0xD0 && marker <= 0xD7) {
+            if (marker - 0xD0 != count % 8 || count + 1 >= numIntervals) {
+                return false;
+            }
+            intervalEnds->push_back(ptr - data);
+            ptr += 2;
+            continue;
+        }
+
+        if (0xD9 == marker) {
+            intervalEnds->push_back(ptr - data);
+            return count + 1 == numIntervals;
+        }
+
+        // DNL or another scan
+        return false;
+    }
+
+    return false;
+}
+
+bool SkJpegCodec::indexRestartIntervals() {
+    if (fTriedRestartIndex) {
+        return fRestartIndex != nullptr;
+    }
+    fTriedRestartIndex = true;
+
+    // Each restart interval can be decoded independently if it starts at the beginning of
+    // an MCU row, and if the image has a single interleaved scan.
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    if (0 == dinfo->restart_interval || dinfo->progressive_mode || dinfo->arith_code ||
+            dinfo->comps_in_scan != dinfo->num_components) {
+        return false;
+    }
+
+    int mcuWidth = DCTSIZE;
+    int mcuHeight = DCTSIZE;
+    if (dinfo->comps_in_scan > 1) {
+        mcuWidth *= dinfo->max_h_samp_factor;
+        mcuHeight *= dinfo->max_v_samp_factor;
+    }
+    const int mcusPerRow = (dinfo->image_width + mcuWidth - 1) / mcuWidth;
+    const int mcuRows = (dinfo->image_height + mcuHeight - 1) / mcuHeight;
+    if (0 != dinfo->restart_interval % mcusPerRow) {
+        return false;
+    }
+    const int mcuRowsPerInterval = dinfo->restart_interval / mcusPerRow;
+    const int numIntervals = (mcuRows + mcuRowsPerInterval - 1) / mcuRowsPerInterval;
+    if (numIntervals < 2) {
+        return false;
+    }
+
+    // We need random access to all of the encoded data.  Copying a stream that is not
+    // already in memory would cost more than decoding it serially.
+    SkStream* stream = this->stream();
+    if (!stream->hasLength() || !stream->getMemoryBase()) {
+        return false;
+    }
+    sk_sp<SkData> data = SkData::MakeWithoutCopy(stream->getMemoryBase(), stream->getLength());
+
+    std::unique_ptr<RestartIndex> index(new RestartIndex);
+    if (!find_first_scan(data->bytes(), data->size(), &index->fHeightOffset,
+                         &index->fScanOffset) ||
+        !find_restart_markers(data->bytes(), data->size(), index->fScanOffset, numIntervals,
+                              &index->fIntervalEnds)) {
+        return false;
+    }
+
+    index->fData = std::move(data);
+    index->fMCUHeight = mcuHeight;
+    index->fMCURowsPerInterval = mcuRowsPerInterval;
+    fRestartIndex = std::move(index);
+    return true;
+}
+
+// Each band decodes at least this many restart intervals (when there are enough), plus one
+// above and one below it for context.
+static constexpr int kMinIntervalsPerBand = 8;
+static constexpr int kMaxBands = 64;
+
+SkCodec::Result SkJpegCodec::decodeRestartIntervals(const SkImageInfo& dstInfo, void* dst,
+        size_t rowBytes, const Options& options, int startRow, int count, int* rowsDecoded) {
+    if (!this->indexRestartIntervals()) {
+        return kUnimplemented;
+    }
+
+    const RestartIndex& index = *fRestartIndex;
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    const int outputRowsPerMCU = index.fMCUHeight * dinfo->scale_num / dinfo->scale_denom;
+    if (outputRowsPerMCU * (int) dinfo->scale_denom != index.fMCUHeight * (int) dinfo->scale_num) {
+        return kUnimplemented;
+    }
+
+    // Every interval but the last decodes to exactly this many rows.
+    const int rowsPerInterval = index.fMCURowsPerInterval * outputRowsPerMCU;
+    const int numIntervals = (int) index.fIntervalEnds.size();
+    const int firstInterval = startRow / rowsPerInterval;
+    const int lastInterval = (startRow + count - 1) / rowsPerInterval;
+    const int neededIntervals = lastInterval - firstInterval + 1;
+    SkASSERT(lastInterval < numIntervals);
+
+    int numBands = 1;
+    if (options.fExecutor) {
+        numBands = SkTPin(neededIntervals / kMinIntervalsPerBand, 1, kMaxBands);
+    }
+
+    size_t swizzleBytes, xformBytes;
+    this->getStorageBytes(dstInfo, &swizzleBytes, &xformBytes);
+
+    std::vector<int> bandRows(numBands, 0);
+    std::vector<int> bandCounts(numBands, 0);
+    auto decodeBand = [&](int band) {
+        // Decode the intervals [first, last) of this band, with an extra interval above and
+        // below so that chroma upsampling matches a decode of the whole image.
+        const int first = firstInterval + band * neededIntervals / numBands;
+        const int last = firstInterval + (band + 1) * neededIntervals / numBands;
+        const int contextFirst = SkTMax(first - 1, 0);
+        const int contextLast = SkTMin(last + 1, numIntervals);
+
+        const int bandStartRow = SkTMax(startRow, first * rowsPerInterval);
+        const int bandEndRow = SkTMin(startRow + count, last * rowsPerInterval);
+        bandCounts[band] = bandEndRow - bandStartRow;
+
+        const int pixelTop = contextFirst * index.fMCURowsPerInterval * index.fMCUHeight;
+        const int pixelBottom = SkTMin<int>(contextLast * index.fMCURowsPerInterval *
+                                            index.fMCUHeight, this->getInfo().height());
+
+        // Build a jpeg containing only these intervals: the original headers with the height
+        // changed, and the intervals with their RSTn markers renumbered from zero.
+        const uint8_t* data = index.fData->bytes();
+        const size_t dataStart = contextFirst > 0 ? index.fIntervalEnds[contextFirst - 1] + 2
+                                                  : index.fScanOffset;
+        const size_t dataEnd = index.fIntervalEnds[contextLast - 1];
+        const size_t headerBytes = index.fScanOffset;
+        SkAutoTMalloc<uint8_t> jpeg(headerBytes + (dataEnd - dataStart) + 2);
+        memcpy(jpeg.get(), data, headerBytes);
+        memcpy(jpeg.get() + headerBytes, data + dataStart, dataEnd - dataStart);
+        jpeg[index.fHeightOffset + 0] = (uint8_t) ((pixelBottom - pixelTop) >> 8);
+        jpeg[index.fHeightOffset + 1] = (uint8_t) ((pixelBottom - pixelTop) >> 0);
+        for (int i = contextFirst; i < contextLast - 1; i++) {
+            jpeg[headerBytes + index.fIntervalEnds[i] - dataStart + 1] =
+                    0xD0 + (i - contextFirst) % 8;
+        }
+        jpeg[headerBytes + dataEnd - dataStart + 0] = 0xFF;
+        jpeg[headerBytes + dataEnd - dataStart + 1] = 0xD9;
+
+        SkMemoryStream stream(jpeg.get(), headerBytes + (dataEnd - dataStart) + 2, false);
+        JpegDecoderMgr decoderMgr(&stream);
+        SkAutoTMalloc<uint8_t> storage(swizzleBytes + xformBytes);
+        void* bandDst = SkTAddOffset<void>(dst, (bandStartRow - startRow) * rowBytes);
+        bandRows[band] = this->decodeRestartBand(&decoderMgr, storage.get(), swizzleBytes,
+                                                 xformBytes, dstInfo, bandDst, rowBytes, options,
+                                                 bandStartRow - contextFirst * rowsPerInterval,
+                                                 bandCounts[band]);
+    };
+
+    if (1 == numBands) {
+        decodeBand(0);
+    } else {
+        SkTaskGroup tg(*options.fExecutor);
+        tg.batch(numBands, decodeBand);
+        tg.wait();
+    }
+
+    // Report the rows that were decoded before the first failure.
+    int rows = 0;
+    for (int band = 0; band < numBands; band++) {
+        rows += bandRows[band];
+        if (bandRows[band] < bandCounts[band]) {
+            *rowsDecoded = rows;
+            return kErrorInInput;
+        }
+    }
+
+    return kSuccess;
+}
+
+int SkJpegCodec::decodeRestartBand(JpegDecoderMgr* decoderMgr, uint8_t* storage,
+                                   size_t swizzleBytes, size_t xformBytes,
+                                   const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                   const Options& options, int skipRows, int count) {
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return 0;
+    }
+
+    decoderMgr->init();
+    jpeg_decompress_struct* dinfo = decoderMgr->dinfo();
+    if (JPEG_HEADER_OK != jpeg_read_header(dinfo, true)) {
+        return 0;
+    }
+
+    // Match the settings of the main decoder.
+    const jpeg_decompress_struct* mainInfo = fDecoderMgr->dinfo();
+    dinfo->out_color_space = mainInfo->out_color_space;
+    dinfo->dither_mode = mainInfo->dither_mode;
+    dinfo->scale_num = mainInfo->scale_num;
+    dinfo->scale_denom = mainInfo->scale_denom;
+    if (!jpeg_start_decompress(dinfo)) {
+        return 0;
+    }
+
+    if (options.fSubset) {
+        uint32_t startX = options.fSubset->x();
+        uint32_t width = options.fSubset->width();
+        jpeg_crop_scanline(dinfo, &startX, &width);
+    }
+    SkASSERT(dinfo->output_width == mainInfo->output_width);
+
+    if (skipRows > 0 && (uint32_t) skipRows != jpeg_skip_scanlines(dinfo, skipRows)) {
+        return 0;
+    }
+
+    uint8_t* swizzleSrcRow = swizzleBytes > 0 ? storage : nullptr;
+    uint32_t* colorXformSrcRow = xformBytes > 0 ?
+            SkTAddOffset<uint32_t>(storage, swizzleBytes) : nullptr;
+    return this->readRows(decoderMgr, swizzleSrcRow, colorXformSrcRow, dstInfo, dst, rowBytes,
+                          count, options);
+}
+
 static bool is_yuv_supported(jpeg_decompress_struct* dinfo) {
     // Scaling is not supported in raw data mode.
     SkASSERT(dinfo->scale_num == dinfo->scale_denom);
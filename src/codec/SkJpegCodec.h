@@ -33,6 +33,8 @@ public:
      */
     static std::unique_ptr<SkCodec> MakeFromStream(std::unique_ptr<SkStream>, Result*);
 
+    ~SkJpegCodec() override;
+
 protected:
 
     /*
@@ -56,6 +58,11 @@ protected:
 
     bool onRewind() override;
 
+    Result onStartIncrementalDecode(const SkImageInfo& dstInfo, void* pixels, size_t rowBytes,
+            const Options&) override;
+
+    Result onIncrementalDecode(int* rowsDecoded) override;
+
     bool onDimensionsSupported(const SkISize&) override;
 
     bool conversionSupported(const SkImageInfo&, SkColorType, bool,
@@ -120,7 +127,30 @@ private:
     void initializeSwizzler(const SkImageInfo& dstInfo, const Options& options,
                             bool needsCMYKToRGB);
     void allocateStorage(const SkImageInfo& dstInfo);
+    void getStorageBytes(const SkImageInfo& dstInfo, size_t* swizzleBytes,
+                         size_t* xformBytes) const;
     int readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count, const Options&);
+    int readRows(JpegDecoderMgr* decoderMgr, uint8_t* swizzleSrcRow, uint32_t* colorXformSrcRow,
+                 const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count,
+                 const Options&);
+
+    /*
+     * Decodes output rows [startRow, startRow + count) into dst by splitting the image at its
+     * restart markers and decoding the pieces with independent decompressors, in parallel
+     * if options.fExecutor is set.  Entropy decoding is skipped for the restart intervals
+     * that do not touch these rows.
+     *
+     * Must be called after the decode has been set up (swizzler, storage and crop).
+     * Returns kUnimplemented if the image cannot be split, in which case nothing has been
+     * written and the caller should decode serially.
+     */
+    Result decodeRestartIntervals(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                  const Options& options, int startRow, int count,
+                                  int* rowsDecoded);
+    int decodeRestartBand(JpegDecoderMgr* decoderMgr, uint8_t* storage, size_t swizzleBytes,
+                          size_t xformBytes, const SkImageInfo& dstInfo, void* dst,
+                          size_t rowBytes, const Options& options, int skipRows, int count);
+    bool indexRestartIntervals();
 
     /*
      * Scanline decoding.
@@ -149,6 +179,23 @@ private:
 
     std::unique_ptr<SkSwizzler>        fSwizzler;
 
+    // Incremental decoding writes rows [fIncrementalFirstRow, fIncrementalFirstRow +
+    // fIncrementalRowCount) to fIncrementalDst.  fIncrementalRowsDecoded allows a decode
+    // that ran out of data to resume.  The client's subset may not outlive
+    // startIncrementalDecode(), so it is copied to fIncrementalSubset.
+    void*                              fIncrementalDst;
+    size_t                             fIncrementalRowBytes;
+    int                                fIncrementalFirstRow;
+    int                                fIncrementalRowCount;
+    int                                fIncrementalRowsDecoded;
+    SkIRect                            fIncrementalSubset;
+
+    // Built on the first decode that could use it, since it requires scanning the entire
+    // stream, which must be in memory.  See indexRestartIntervals().
+    struct RestartIndex;
+    std::unique_ptr<RestartIndex>      fRestartIndex;
+    bool                               fTriedRestartIndex;
+
     friend class SkRawCodec;
 
     typedef SkCodec INHERITED;
@@ -9,109 +9,74 @@
 #include "SkColorData.h"
 #include "SkMaskSwizzler.h"
 
-static void swizzle_mask16_to_rgba_opaque(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    uint16_t* srcPtr = ((uint16_t*) srcRow) + startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint16_t p = srcPtr[0];
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        dstPtr[i] = SkPackARGB_as_RGBA(0xFF, red, green, blue);
-        srcPtr += sampleX;
+// Reads a little-endian pixel of kBytesPerPixel bytes.
+template <int kBytesPerPixel>
+static uint32_t read_pixel(const uint8_t* src) {
+    switch (kBytesPerPixel) {
+        case 2:
+            return *((const uint16_t*) src);
+        case 3:
+            return src[0] | (src[1] << 8) | (src[2] << 16);
+        default:
+            SkASSERT(4 == kBytesPerPixel);
+            return *((const uint32_t*) src);
     }
 }
 
-static void swizzle_mask16_to_bgra_opaque(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    uint16_t* srcPtr = ((uint16_t*) srcRow) + startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint16_t p = srcPtr[0];
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        dstPtr[i] = SkPackARGB_as_BGRA(0xFF, red, green, blue);
-        srcPtr += sampleX;
-    }
+// (x * y + 127) / 255, matching SkMulDiv255Round().
+static Sk4u mul_div_255_round(const Sk4u& x, const Sk4u& y) {
+    Sk4u prod = x * y + 128;
+    return (prod + (prod >> 8)) >> 8;
 }
 
-static void swizzle_mask16_to_rgba_unpremul(
+template <int kBytesPerPixel, bool kSwapRB, bool kOpaque, bool kPremul>
+static void swizzle_mask_to_n32(
         void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
         uint32_t startX, uint32_t sampleX) {
 
-    // Use the masks to decode to the destination
-    uint16_t* srcPtr = ((uint16_t*) srcRow) + startX;
+    const uint8_t* srcPtr = srcRow + kBytesPerPixel * startX;
+    const size_t srcDelta = kBytesPerPixel * sampleX;
     SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint16_t p = srcPtr[0];
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        uint8_t alpha = masks->getAlpha(p);
-        dstPtr[i] = SkPackARGB_as_RGBA(alpha, red, green, blue);
-        srcPtr += sampleX;
-    }
-}
 
-static void swizzle_mask16_to_bgra_unpremul(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    uint16_t* srcPtr = ((uint16_t*) srcRow) + startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint16_t p = srcPtr[0];
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        uint8_t alpha = masks->getAlpha(p);
-        dstPtr[i] = SkPackARGB_as_BGRA(alpha, red, green, blue);
-        srcPtr += sampleX;
+    // Use the masks to decode four pixels at a time.
+    for (; width >= 4; width -= 4) {
+        Sk4u p(read_pixel<kBytesPerPixel>(srcPtr),
+               read_pixel<kBytesPerPixel>(srcPtr + 1 * srcDelta),
+               read_pixel<kBytesPerPixel>(srcPtr + 2 * srcDelta),
+               read_pixel<kBytesPerPixel>(srcPtr + 3 * srcDelta));
+        Sk4u red = masks->getRed(p);
+        Sk4u green = masks->getGreen(p);
+        Sk4u blue = masks->getBlue(p);
+        Sk4u alpha = kOpaque ? Sk4u(0xFF) : masks->getAlpha(p);
+        if (kPremul) {
+            red = mul_div_255_round(red, alpha);
+            green = mul_div_255_round(green, alpha);
+            blue = mul_div_255_round(blue, alpha);
+        }
+        if (kSwapRB) {
+            SkTSwap(red, blue);
+        }
+        (red | (green << 8) | (blue << 16) | (alpha << 24)).store(dstPtr);
+        srcPtr += 4 * srcDelta;
+        dstPtr += 4;
     }
-}
-
-static void swizzle_mask16_to_rgba_premul(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
 
-    // Use the masks to decode to the destination
-    uint16_t* srcPtr = ((uint16_t*) srcRow) + startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint16_t p = srcPtr[0];
+    // Finish up the tail of [0,4) pixels.
+    for (; width > 0; width--) {
+        uint32_t p = read_pixel<kBytesPerPixel>(srcPtr);
         uint8_t red = masks->getRed(p);
         uint8_t green = masks->getGreen(p);
         uint8_t blue = masks->getBlue(p);
-        uint8_t alpha = masks->getAlpha(p);
-        dstPtr[i] = premultiply_argb_as_rgba(alpha, red, green, blue);
-        srcPtr += sampleX;
-    }
-}
-
-static void swizzle_mask16_to_bgra_premul(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    uint16_t* srcPtr = ((uint16_t*) srcRow) + startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint16_t p = srcPtr[0];
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        uint8_t alpha = masks->getAlpha(p);
-        dstPtr[i] = premultiply_argb_as_bgra(alpha, red, green, blue);
-        srcPtr += sampleX;
+        uint8_t alpha = kOpaque ? 0xFF : masks->getAlpha(p);
+        if (kPremul) {
+            *dstPtr = kSwapRB ? premultiply_argb_as_bgra(alpha, red, green, blue)
+                              : premultiply_argb_as_rgba(alpha, red, green, blue);
+        } else {
+            *dstPtr = kSwapRB ? SkPackARGB_as_BGRA(alpha, red, green, blue)
+                              : SkPackARGB_as_RGBA(alpha, red, green, blue);
+        }
+        srcPtr += srcDelta;
+        dstPtr++;
     }
 }
 
@@ -134,112 +99,6 @@ static void swizzle_mask16_to_565(
     }
 }
 
-static void swizzle_mask24_to_rgba_opaque(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    srcRow += 3 * startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint32_t p = srcRow[0] | (srcRow[1] << 8) | srcRow[2] << 16;
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        dstPtr[i] = SkPackARGB_as_RGBA(0xFF, red, green, blue);
-        srcRow += 3 * sampleX;
-    }
-}
-
-static void swizzle_mask24_to_bgra_opaque(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    srcRow += 3 * startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint32_t p = srcRow[0] | (srcRow[1] << 8) | srcRow[2] << 16;
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        dstPtr[i] = SkPackARGB_as_BGRA(0xFF, red, green, blue);
-        srcRow += 3 * sampleX;
-    }
-}
-
-static void swizzle_mask24_to_rgba_unpremul(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    srcRow += 3 * startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint32_t p = srcRow[0] | (srcRow[1] << 8) | srcRow[2] << 16;
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        uint8_t alpha = masks->getAlpha(p);
-        dstPtr[i] = SkPackARGB_as_RGBA(alpha, red, green, blue);
-        srcRow += 3 * sampleX;
-    }
-}
-
-static void swizzle_mask24_to_bgra_unpremul(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    srcRow += 3 * startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint32_t p = srcRow[0] | (srcRow[1] << 8) | srcRow[2] << 16;
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        uint8_t alpha = masks->getAlpha(p);
-        dstPtr[i] = SkPackARGB_as_BGRA(alpha, red, green, blue);
-        srcRow += 3 * sampleX;
-    }
-}
-
-static void swizzle_mask24_to_rgba_premul(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    srcRow += 3 * startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint32_t p = srcRow[0] | (srcRow[1] << 8) | srcRow[2] << 16;
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        uint8_t alpha = masks->getAlpha(p);
-        dstPtr[i] = premultiply_argb_as_rgba(alpha, red, green, blue);
-        srcRow += 3 * sampleX;
-    }
-}
-
-static void swizzle_mask24_to_bgra_premul(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    srcRow += 3 * startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint32_t p = srcRow[0] | (srcRow[1] << 8) | srcRow[2] << 16;
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        uint8_t alpha = masks->getAlpha(p);
-        dstPtr[i] = premultiply_argb_as_bgra(alpha, red, green, blue);
-        srcRow += 3 * sampleX;
-    }
-}
-
 static void swizzle_mask24_to_565(
         void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
         uint32_t startX, uint32_t sampleX) {
@@ -257,112 +116,6 @@ static void swizzle_mask24_to_565(
     }
 }
 
-static void swizzle_mask32_to_rgba_opaque(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    uint32_t* srcPtr = ((uint32_t*) srcRow) + startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint32_t p = srcPtr[0];
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        dstPtr[i] = SkPackARGB_as_RGBA(0xFF, red, green, blue);
-        srcPtr += sampleX;
-    }
-}
-
-static void swizzle_mask32_to_bgra_opaque(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    uint32_t* srcPtr = ((uint32_t*) srcRow) + startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint32_t p = srcPtr[0];
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        dstPtr[i] = SkPackARGB_as_BGRA(0xFF, red, green, blue);
-        srcPtr += sampleX;
-    }
-}
-
-static void swizzle_mask32_to_rgba_unpremul(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    uint32_t* srcPtr = ((uint32_t*) srcRow) + startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint32_t p = srcPtr[0];
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        uint8_t alpha = masks->getAlpha(p);
-        dstPtr[i] = SkPackARGB_as_RGBA(alpha, red, green, blue);
-        srcPtr += sampleX;
-    }
-}
-
-static void swizzle_mask32_to_bgra_unpremul(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    uint32_t* srcPtr = ((uint32_t*) srcRow) + startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint32_t p = srcPtr[0];
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        uint8_t alpha = masks->getAlpha(p);
-        dstPtr[i] = SkPackARGB_as_BGRA(alpha, red, green, blue);
-        srcPtr += sampleX;
-    }
-}
-
-static void swizzle_mask32_to_rgba_premul(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    uint32_t* srcPtr = ((uint32_t*) srcRow) + startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint32_t p = srcPtr[0];
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        uint8_t alpha = masks->getAlpha(p);
-        dstPtr[i] = premultiply_argb_as_rgba(alpha, red, green, blue);
-        srcPtr += sampleX;
-    }
-}
-
-static void swizzle_mask32_to_bgra_premul(
-        void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
-        uint32_t startX, uint32_t sampleX) {
-
-    // Use the masks to decode to the destination
-    uint32_t* srcPtr = ((uint32_t*) srcRow) + startX;
-    SkPMColor* dstPtr = (SkPMColor*) dstRow;
-    for (int i = 0; i < width; i++) {
-        uint32_t p = srcPtr[0];
-        uint8_t red = masks->getRed(p);
-        uint8_t green = masks->getGreen(p);
-        uint8_t blue = masks->getBlue(p);
-        uint8_t alpha = masks->getAlpha(p);
-        dstPtr[i] = premultiply_argb_as_bgra(alpha, red, green, blue);
-        srcPtr += sampleX;
-    }
-}
-
 static void swizzle_mask32_to_565(
         void* dstRow, const uint8_t* srcRow, int width, SkMasks* masks,
         uint32_t startX, uint32_t sampleX) {
@@ -395,14 +148,14 @@ SkMaskSwizzler* SkMaskSwizzler::CreateMaskSwizzler(const SkImageInfo& dstInfo,
             switch (dstInfo.colorType()) {
                 case kRGBA_8888_SkColorType:
                     if (kOpaque_SkAlphaType == srcInfo.alphaType()) {
-                        proc = &swizzle_mask16_to_rgba_opaque;
+                        proc = &swizzle_mask_to_n32<2, false, true, false>;
                     } else {
                         switch (dstInfo.alphaType()) {
                             case kUnpremul_SkAlphaType:
-                                proc = &swizzle_mask16_to_rgba_unpremul;
+                                proc = &swizzle_mask_to_n32<2, false, false, false>;
                                 break;
                             case kPremul_SkAlphaType:
-                                proc = &swizzle_mask16_to_rgba_premul;
+                                proc = &swizzle_mask_to_n32<2, false, false, true>;
                                 break;
                             default:
                                 break;
@@ -411,14 +164,14 @@ SkMaskSwizzler* SkMaskSwizzler::CreateMaskSwizzler(const SkImageInfo& dstInfo,
                     break;
                 case kBGRA_8888_SkColorType:
                     if (kOpaque_SkAlphaType == srcInfo.alphaType()) {
-                        proc = &swizzle_mask16_to_bgra_opaque;
+                        proc = &swizzle_mask_to_n32<2, true, true, false>;
                     } else {
                         switch (dstInfo.alphaType()) {
                             case kUnpremul_SkAlphaType:
-                                proc = &swizzle_mask16_to_bgra_unpremul;
+                                proc = &swizzle_mask_to_n32<2, true, false, false>;
                                 break;
                             case kPremul_SkAlphaType:
-                                proc = &swizzle_mask16_to_bgra_premul;
+                                proc = &swizzle_mask_to_n32<2, true, false, true>;
                                 break;
                             default:
                                 break;
@@ -436,14 +189,14 @@ SkMaskSwizzler* SkMaskSwizzler::CreateMaskSwizzler(const SkImageInfo& dstInfo,
             switch (dstInfo.colorType()) {
                 case kRGBA_8888_SkColorType:
                     if (kOpaque_SkAlphaType == srcInfo.alphaType()) {
-                        proc = &swizzle_mask24_to_rgba_opaque;
+                        proc = &swizzle_mask_to_n32<3, false, true, false>;
                     } else {
                         switch (dstInfo.alphaType()) {
                             case kUnpremul_SkAlphaType:
-                                proc = &swizzle_mask24_to_rgba_unpremul;
+                                proc = &swizzle_mask_to_n32<3, false, false, false>;
                                 break;
                             case kPremul_SkAlphaType:
-                                proc = &swizzle_mask24_to_rgba_premul;
+                                proc = &swizzle_mask_to_n32<3, false, false, true>;
                                 break;
                             default:
                                 break;
@@ -452,14 +205,14 @@ SkMaskSwizzler* SkMaskSwizzler::CreateMaskSwizzler(const SkImageInfo& dstInfo,
                     break;
                 case kBGRA_8888_SkColorType:
                     if (kOpaque_SkAlphaType == srcInfo.alphaType()) {
-                        proc = &swizzle_mask24_to_bgra_opaque;
+                        proc = &swizzle_mask_to_n32<3, true, true, false>;
                     } else {
                         switch (dstInfo.alphaType()) {
                             case kUnpremul_SkAlphaType:
-                                proc = &swizzle_mask24_to_bgra_unpremul;
+                                proc = &swizzle_mask_to_n32<3, true, false, false>;
                                 break;
                             case kPremul_SkAlphaType:
-                                proc = &swizzle_mask24_to_bgra_premul;
+                                proc = &swizzle_mask_to_n32<3, true, false, true>;
                                 break;
                             default:
                                 break;
@@ -477,14 +230,14 @@ SkMaskSwizzler* SkMaskSwizzler::CreateMaskSwizzler(const SkImageInfo& dstInfo,
             switch (dstInfo.colorType()) {
                 case kRGBA_8888_SkColorType:
                     if (kOpaque_SkAlphaType == srcInfo.alphaType()) {
-                        proc = &swizzle_mask32_to_rgba_opaque;
+                        proc = &swizzle_mask_to_n32<4, false, true, false>;
                     } else {
                         switch (dstInfo.alphaType()) {
                             case kUnpremul_SkAlphaType:
-                                proc = &swizzle_mask32_to_rgba_unpremul;
+                                proc = &swizzle_mask_to_n32<4, false, false, false>;
                                 break;
                             case kPremul_SkAlphaType:
-                                proc = &swizzle_mask32_to_rgba_premul;
+                                proc = &swizzle_mask_to_n32<4, false, false, true>;
                                 break;
                             default:
                                 break;
@@ -493,14 +246,14 @@ SkMaskSwizzler* SkMaskSwizzler::CreateMaskSwizzler(const SkImageInfo& dstInfo,
                     break;
                 case kBGRA_8888_SkColorType:
                     if (kOpaque_SkAlphaType == srcInfo.alphaType()) {
-                        proc = &swizzle_mask32_to_bgra_opaque;
+                        proc = &swizzle_mask_to_n32<4, true, true, false>;
                     } else {
                         switch (dstInfo.alphaType()) {
                             case kUnpremul_SkAlphaType:
-                                proc = &swizzle_mask32_to_bgra_unpremul;
+                                proc = &swizzle_mask_to_n32<4, true, false, false>;
                                 break;
                             case kPremul_SkAlphaType:
-                                proc = &swizzle_mask32_to_bgra_premul;
+                                proc = &swizzle_mask_to_n32<4, true, false, true>;
                                 break;
                             default:
                                 break;
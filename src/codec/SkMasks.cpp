@@ -81,6 +81,48 @@ uint8_t SkMasks::getAlpha(uint32_t pixel) const {
     return get_comp(pixel, fAlpha.mask, fAlpha.shift, fAlpha.size);
 }
 
+/*
+ *
+ * Convert four n bit components to 8-bit components
+ *
+ */
+static Sk4u convert_to_8(const Sk4u& components, uint32_t n) {
+    if (0 == n) {
+        return 0;
+    } else if (8 > n) {
+        // The lookup table holds component * 255 / (2^n - 1), rounded to the nearest integer.
+        // That quotient is never within 1/254 of a half, so float math rounds it exactly.
+        Sk4f scaled = SkNx_cast<float>(components) * (255.0f / ((1 << n) - 1)) + 0.5f;
+        Sk4i rounded = SkNx_cast<int32_t>(scaled);
+        return Sk4u::Load(&rounded);
+    } else {
+        SkASSERT(8 == n);
+        return components;
+    }
+}
+
+static Sk4u get_comp(const Sk4u& pixels, uint32_t mask, uint32_t shift, uint32_t size) {
+    return convert_to_8((pixels & mask) >> shift, size);
+}
+
+/*
+ *
+ * Get a color component from each of four pixels
+ *
+ */
+Sk4u SkMasks::getRed(const Sk4u& pixels) const {
+    return get_comp(pixels, fRed.mask, fRed.shift, fRed.size);
+}
+Sk4u SkMasks::getGreen(const Sk4u& pixels) const {
+    return get_comp(pixels, fGreen.mask, fGreen.shift, fGreen.size);
+}
+Sk4u SkMasks::getBlue(const Sk4u& pixels) const {
+    return get_comp(pixels, fBlue.mask, fBlue.shift, fBlue.size);
+}
+Sk4u SkMasks::getAlpha(const Sk4u& pixels) const {
+    return get_comp(pixels, fAlpha.mask, fAlpha.shift, fAlpha.size);
+}
+
 /*
  *
  * Process an input mask to obtain the necessary information
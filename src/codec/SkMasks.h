@@ -7,6 +7,7 @@
 #ifndef SkMasks_DEFINED
 #define SkMasks_DEFINED
 
+#include "SkNx.h"
 #include "SkTypes.h"
 
 /*
@@ -57,6 +58,17 @@ public:
     uint8_t getBlue(uint32_t pixel) const;
     uint8_t getAlpha(uint32_t pixel) const;
 
+    /*
+     *
+     * Get a color component from each of four pixels
+     * Matches the single pixel getters above
+     *
+     */
+    Sk4u getRed(const Sk4u& pixels) const;
+    Sk4u getGreen(const Sk4u& pixels) const;
+    Sk4u getBlue(const Sk4u& pixels) const;
+    Sk4u getAlpha(const Sk4u& pixels) const;
+
     /*
      *
      * Getter for the alpha mask
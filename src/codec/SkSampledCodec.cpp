@@ -76,6 +76,7 @@ SkCodec::Result SkSampledCodec::onGetAndroidPixels(const SkImageInfo& info, void
     SkCodec::Options codecOptions;
     codecOptions.fZeroInitialized = options.fZeroInitialized;
     codecOptions.fPremulBehavior = SkTransferFunctionBehavior::kIgnore;
+    codecOptions.fExecutor = options.fExecutor;
 
     SkIRect* subset = options.fSubset;
     if (!subset || subset->size() == this->codec()->getInfo().dimensions()) {
@@ -167,6 +168,16 @@ SkCodec::Result SkSampledCodec::sampledDecode(const SkImageInfo& info, void* pix
     // We should only call this function when sampling.
     SkASSERT(options.fSampleSize > 1);
 
+    // libjpeg cannot scale beyond 1/8 natively.  Rather than sampling a larger decode,
+    // average the cheapest one.
+    if (options.fSampleSize > 8 &&
+            this->codec()->getEncodedFormat() == SkEncodedImageFormat::kJPEG) {
+        SkCodec::Result result = this->areaAverageDecode(info, pixels, rowBytes, options);
+        if (SkCodec::kUnimplemented != result) {
+            return result;
+        }
+    }
+
     // Create options struct for the codec.
     SkCodec::Options sampledOptions;
     sampledOptions.fZeroInitialized = options.fZeroInitialized;
@@ -347,3 +358,114 @@ SkCodec::Result SkSampledCodec::sampledDecode(const SkImageInfo& info, void* pix
             return SkCodec::kUnimplemented;
     }
 }
+
+SkCodec::Result SkSampledCodec::areaAverageDecode(const SkImageInfo& info, void* pixels,
+        size_t rowBytes, const AndroidOptions& options) {
+    // Each output channel is an average of 8-bit input channels.
+    switch (info.colorType()) {
+        case kRGBA_8888_SkColorType:
+        case kBGRA_8888_SkColorType:
+        case kGray_8_SkColorType:
+            break;
+        default:
+            return SkCodec::kUnimplemented;
+    }
+
+    // At 1/8 scale, libjpeg replaces the IDCT of each block with its DC coefficient, and
+    // does not need to store the AC coefficients.
+    const int kDCSampleSize = 8;
+    const SkISize nativeSize = this->codec()->getScaledDimensions(
+            get_scale_from_sample_size(kDCSampleSize));
+
+    // The region of the 1/8 scale image that covers the subset, computed as in
+    // sampledDecode().
+    SkIRect src = SkIRect::MakeSize(nativeSize);
+    SkIRect scanlineSubset;
+    SkCodec::Options codecOptions;
+    codecOptions.fPremulBehavior = SkTransferFunctionBehavior::kIgnore;
+    if (options.fSubset) {
+        src.setXYWH(options.fSubset->x() / kDCSampleSize, options.fSubset->y() / kDCSampleSize,
+                    get_scaled_dimension(options.fSubset->width(), kDCSampleSize),
+                    get_scaled_dimension(options.fSubset->height(), kDCSampleSize));
+
+        // The scanline decoder only needs to be aware of subsetting in the x-dimension.
+        scanlineSubset.setXYWH(src.x(), 0, src.width(), nativeSize.height());
+        codecOptions.fSubset = &scanlineSubset;
+    }
+
+    const int dstWidth = info.width();
+    const int dstHeight = info.height();
+    if (src.width() < dstWidth || src.height() < dstHeight) {
+        // Every output pixel needs at least one input pixel.
+        return SkCodec::kUnimplemented;
+    }
+
+    const SkImageInfo nativeInfo = info.makeWH(nativeSize.width(), nativeSize.height());
+    SkCodec::Result result = this->codec()->startScanlineDecode(nativeInfo, &codecOptions);
+    if (SkCodec::kSuccess != result) {
+        return result;
+    }
+
+    // We handle filling uninitialized memory here instead of using this->codec(), whose
+    // subset is wider than the destination.
+    auto fillRemainingRows = [&](int rowsDecoded) {
+        const SkImageInfo fillInfo = info.makeWH(dstWidth, dstHeight - rowsDecoded);
+        SkSampler::Fill(fillInfo, SkTAddOffset<void>(pixels, rowsDecoded * rowBytes), rowBytes,
+                        this->codec()->getFillValue(info), options.fZeroInitialized);
+        return SkCodec::kIncompleteInput;
+    };
+
+    // JPEG is always decoded top-down.
+    SkASSERT(this->codec()->getScanlineOrder() == SkCodec::kTopDown_SkScanlineOrder);
+    if (!this->codec()->skipScanlines(src.y())) {
+        return fillRemainingRows(0);
+    }
+
+    // Output column x averages input columns [left[x], left[x + 1]).
+    const int channels = info.bytesPerPixel();
+    SkAutoTMalloc<int> left(dstWidth + 1);
+    for (int x = 0; x <= dstWidth; x++) {
+        left[x] = x * src.width() / dstWidth;
+    }
+
+    SkAutoTMalloc<uint8_t> srcRow(src.width() * channels);
+    SkAutoTMalloc<uint32_t> sums(dstWidth * channels);
+    uint8_t* dstRow = (uint8_t*) pixels;
+    for (int y = 0; y < dstHeight; y++) {
+        const int top = y * src.height() / dstHeight;
+        const int bottom = (y + 1) * src.height() / dstHeight;
+
+        sk_bzero(sums.get(), dstWidth * channels * sizeof(uint32_t));
+        for (int row = top; row < bottom; row++) {
+            if (1 != this->codec()->getScanlines(srcRow.get(), 1, 0)) {
+                return fillRemainingRows(y);
+            }
+
+            const uint8_t* srcPtr = srcRow.get();
+            uint32_t* sumPtr = sums.get();
+            for (int x = 0; x < dstWidth; x++) {
+                for (int i = left[x]; i < left[x + 1]; i++) {
+                    for (int c = 0; c < channels; c++) {
+                        sumPtr[c] += srcPtr[c];
+                    }
+                    srcPtr += channels;
+                }
+                sumPtr += channels;
+            }
+        }
+
+        const uint32_t* sumPtr = sums.get();
+        uint8_t* dstPtr = dstRow;
+        for (int x = 0; x < dstWidth; x++) {
+            const uint32_t area = (bottom - top) * (left[x + 1] - left[x]);
+            for (int c = 0; c < channels; c++) {
+                dstPtr[c] = (uint8_t) ((sumPtr[c] + area / 2) / area);
+            }
+            sumPtr += channels;
+            dstPtr += channels;
+        }
+        dstRow = SkTAddOffset<uint8_t>(dstRow, rowBytes);
+    }
+
+    return SkCodec::kSuccess;
+}
@@ -55,6 +55,16 @@ private:
     SkCodec::Result sampledDecode(const SkImageInfo& info, void* pixels, size_t rowBytes,
             const AndroidOptions& options);
 
+    /**
+     *  Called by sampledDecode() for JPEG sample sizes larger than 8.
+     *
+     *  Decodes at libjpeg's 1/8 scale, which only uses the DC coefficient of each block,
+     *  and area-averages the result down to the requested size.  Returns kUnimplemented
+     *  if the destination cannot be averaged, in which case the caller samples instead.
+     */
+    SkCodec::Result areaAverageDecode(const SkImageInfo& info, void* pixels, size_t rowBytes,
+            const AndroidOptions& options);
+
     typedef SkAndroidCodec INHERITED;
 };
 #endif // SkSampledCodec_DEFINED
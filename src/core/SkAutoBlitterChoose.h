@@ -10,6 +10,7 @@
 
 #include "SkArenaAlloc.h"
 #include "SkBlitter.h"
+#include "SkDraw.h"
 
 class SkMatrix;
 class SkPaint;
@@ -24,6 +25,11 @@ public:
                         const SkPaint& paint, bool drawCoverage = false) {
         fBlitter = SkBlitter::Choose(dst, matrix, paint, &fAlloc, drawCoverage);
     }
+    SkAutoBlitterChoose(const SkDraw& draw, const SkMatrix& matrix,
+                        const SkPaint& paint, bool drawCoverage = false) {
+        fBlitter = nullptr;
+        this->choose(draw, matrix, paint, drawCoverage);
+    }
 
     SkBlitter*  operator->() { return fBlitter; }
     SkBlitter*  get() const { return fBlitter; }
@@ -34,6 +40,13 @@ public:
         fBlitter = SkBlitter::Choose(dst, matrix, paint, &fAlloc, drawCoverage);
     }
 
+    // Choose a blitter for draw.fDst that also respects draw.fBlitBounds.
+    void choose(const SkDraw& draw, const SkMatrix& matrix,
+                const SkPaint& paint, bool drawCoverage = false) {
+        this->choose(draw.fDst, matrix, paint, drawCoverage);
+        fBlitter = draw.clipToBlitBounds(fBlitter, &fAlloc);
+    }
+
 private:
     // Owned by fAlloc, which will handle the delete.
     SkBlitter*          fBlitter;
@@ -39,6 +39,20 @@ void SkBigPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
                  callback);
 }
 
+void SkBigPicture::playback(SkCanvas* canvas, const SkBBoxHierarchy* bbh) const {
+    SkASSERT(canvas);
+
+    const bool useBBH = !canvas->getLocalClipBounds().contains(this->cullRect());
+
+    SkRecordDraw(*fRecord,
+                 canvas,
+                 this->drawablePicts(),
+                 nullptr,
+                 this->drawableCount(),
+                 useBBH ? bbh : nullptr,
+                 nullptr/*callback*/);
+}
+
 void SkBigPicture::partialPlayback(SkCanvas* canvas,
                                    int start,
                                    int stop,
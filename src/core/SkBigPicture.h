@@ -47,6 +47,9 @@ public:
     size_t approximateBytesUsed() const override;
     const SkBigPicture* asSkBigPicture() const override { return this; }
 
+// Used by SkPicture::playbackParallel to cull with a BBH other than our own.
+    void playback(SkCanvas*, const SkBBoxHierarchy*) const;
+
 // Used by GrLayerHoister
     void partialPlayback(SkCanvas*,
                          int start,
@@ -226,7 +226,12 @@ void SkBitmapDevice::drawBitmap(const SkBitmap& bitmap, SkScalar x, SkScalar y,
                                 const SkPaint& paint) {
     SkMatrix matrix = SkMatrix::MakeTrans(x, y);
     LogDrawScaleFactor(SkMatrix::Concat(this->ctm(), matrix), paint.getFilterQuality());
-    BDDraw(this).drawBitmap(bitmap, matrix, nullptr, paint);
+    this->drawBitmapWithMatrix(bitmap, matrix, nullptr, paint);
+}
+
+void SkBitmapDevice::drawBitmapWithMatrix(const SkBitmap& bitmap, const SkMatrix& matrix,
+                                          const SkRect* dstOrNull, const SkPaint& paint) {
+    BDDraw(this).drawBitmap(bitmap, matrix, dstOrNull, paint);
 }
 
 static inline bool CanApplyDstMatrixAsCTM(const SkMatrix& m, const SkPaint& paint) {
@@ -321,7 +326,7 @@ void SkBitmapDevice::drawBitmapRect(const SkBitmap& bitmap,
         // matrix with the CTM, and try to call drawSprite if it can. If not,
         // it will make a shader and call drawRect, as we do below.
         if (CanApplyDstMatrixAsCTM(matrix, paint)) {
-            BDDraw(this).drawBitmap(*bitmapPtr, matrix, dstPtr, paint);
+            this->drawBitmapWithMatrix(*bitmapPtr, matrix, dstPtr, paint);
             return;
         }
     }
@@ -99,6 +99,13 @@ protected:
     void drawBitmapRect(const SkBitmap&, const SkRect*, const SkRect&,
                         const SkPaint&, SkCanvas::SrcRectConstraint) override;
 
+    /**
+     *  Draw the bitmap with matrix pre-concatenated to the CTM. Both drawBitmap and drawBitmapRect
+     *  end up here, so a subclass that defers its drawing only needs to override this.
+     */
+    virtual void drawBitmapWithMatrix(const SkBitmap&, const SkMatrix&, const SkRect* dstOrNull,
+                                      const SkPaint&);
+
     /**
      *  Does not handle text decoration.
      *  Decorations (underline and stike-thru) will be handled by SkCanvas.
@@ -520,7 +520,8 @@ void SkRectClipBlitter::blitMask(const SkMask& mask, const SkIRect& clip) {
 }
 
 const SkPixmap* SkRectClipBlitter::justAnOpaqueColor(uint32_t* value) {
-    return fBlitter->justAnOpaqueColor(value);
+    // Callers that write the returned pixels directly wouldn't respect fClipRect.
+    return nullptr;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -381,6 +381,7 @@ private:
 
     friend class SkNoPixelsDevice;
     friend class SkBitmapDevice;
+    friend class SkThreadedBMPDevice; // to flush layers before drawing them
     void privateResize(int w, int h) {
         *const_cast<SkImageInfo*>(&fInfo) = fInfo.makeWH(w, h);
     }
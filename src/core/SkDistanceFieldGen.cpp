@@ -7,101 +7,109 @@
 
 #include "SkAutoMalloc.h"
 #include "SkDistanceFieldGen.h"
+#include "SkNx.h"
 #include "SkPointPriv.h"
 #include "SkTemplates.h"
 
+// The working data is kept one plane per field, so that the distance transform can work on
+// four texels of a row at a time. Texels are addressed by index into the planes.
 struct DFData {
-    float   fAlpha;      // alpha value of source texel
-    float   fDistSq;     // distance squared to nearest (so far) edge texel
-    SkPoint fDistVector; // distance vector to nearest (so far) edge texel
-};
-
-enum NeighborFlags {
-    kLeft_NeighborFlag        = 0x01,
-    kRight_NeighborFlag       = 0x02,
-    kTopLeft_NeighborFlag     = 0x04,
-    kTop_NeighborFlag         = 0x08,
-    kTopRight_NeighborFlag    = 0x10,
-    kBottomLeft_NeighborFlag  = 0x20,
-    kBottom_NeighborFlag      = 0x40,
-    kBottomRight_NeighborFlag = 0x80,
-    kAll_NeighborFlags        = 0xff,
-
-    kNeighborFlagCount        = 8
+    float* fAlpha;      // alpha value of source texel
+    float* fDistSq;     // distance squared to nearest (so far) edge texel
+    float* fDistX;      // distance vector to nearest (so far) edge texel
+    float* fDistY;
 };
 
 // We treat an "edge" as a place where we cross from >=128 to <128, or vice versa, or
 // where we have two non-zero pixels that are <128.
-// 'neighborFlags' is used to limit the directions in which we test to avoid indexing
-// outside of the image
-static bool found_edge(const unsigned char* imagePtr, int width, int neighborFlags) {
-    // the order of these should match the neighbor flags above
-    const int kNum8ConnectedNeighbors = 8;
-    const int offsets[8] = {-1, 1, -width-1, -width, -width+1, width-1, width, width+1 };
-    SkASSERT(kNum8ConnectedNeighbors == kNeighborFlagCount);
-
-    // search for an edge
-    unsigned char currVal = *imagePtr;
-    unsigned char currCheck = (currVal >> 7);
-    for (int i = 0; i < kNum8ConnectedNeighbors; ++i) {
-        unsigned char neighborVal;
-        if ((1 << i) & neighborFlags) {
-            const unsigned char* checkPtr = imagePtr + offsets[i];
-            neighborVal = *checkPtr;
-        } else {
-            neighborVal = 0;
-        }
-        unsigned char neighborCheck = (neighborVal >> 7);
-        SkASSERT(currCheck == 0 || currCheck == 1);
-        SkASSERT(neighborCheck == 0 || neighborCheck == 1);
-        // if sharp transition
-        if (currCheck != neighborCheck ||
-            // or both <128 and >0
-            (!currCheck && !neighborCheck && currVal && neighborVal)) {
-            return true;
-        }
-    }
+// Each texel gets one of these classes, and is an edge if any of its 8 neighbors has a class
+// in its edge_neighbors(). Texels outside the image are treated as 0.
+enum EdgeClass {
+    kHigh_EdgeClass = 0x01,  // >= 128
+    kLow_EdgeClass  = 0x02,  // > 0 and < 128
+    kZero_EdgeClass = 0x04,
+};
+
+static unsigned char edge_class(unsigned char val) {
+    return val >= 128 ? kHigh_EdgeClass : (val ? kLow_EdgeClass : kZero_EdgeClass);
+}
 
-    return false;
+static unsigned char edge_neighbors(unsigned char val) {
+    return val >= 128 ? kLow_EdgeClass | kZero_EdgeClass
+                      : (val ? kHigh_EdgeClass | kLow_EdgeClass : kHigh_EdgeClass);
 }
 
-static void init_glyph_data(DFData* data, unsigned char* edges, const unsigned char* image,
+static Sk16b edge_class(const Sk16b& val) {
+    return (val < 1).thenElse(kZero_EdgeClass, (val < 128).thenElse(kLow_EdgeClass,
+                                                                     kHigh_EdgeClass));
+}
+
+static Sk16b edge_neighbors(const Sk16b& val) {
+    return (val < 1).thenElse(kHigh_EdgeClass,
+                              (val < 128).thenElse(kHigh_EdgeClass | kLow_EdgeClass,
+                                                   kLow_EdgeClass | kZero_EdgeClass));
+}
+
+static void init_glyph_data(const DFData& data, unsigned char* classes, unsigned char* edges,
+                            const unsigned char* image,
                             int dataWidth, int dataHeight,
                             int imageWidth, int imageHeight,
                             int pad) {
-    data += pad*dataWidth;
-    data += pad;
-    edges += (pad*dataWidth + pad);
+    memset(classes, kZero_EdgeClass, dataWidth*dataHeight);
 
+    int offset = pad*dataWidth + pad;
+    float* alpha = data.fAlpha + offset;
+    classes += offset;
+    edges += offset;
+
+    // alpha and edge class
+    const unsigned char* row = image;
     for (int j = 0; j < imageHeight; ++j) {
-        for (int i = 0; i < imageWidth; ++i) {
-            if (255 == *image) {
-                data->fAlpha = 1.0f;
-            } else {
-                data->fAlpha = (*image)*0.00392156862f;  // 1/255
-            }
-            int checkMask = kAll_NeighborFlags;
-            if (i == 0) {
-                checkMask &= ~(kLeft_NeighborFlag|kTopLeft_NeighborFlag|kBottomLeft_NeighborFlag);
-            }
-            if (i == imageWidth-1) {
-                checkMask &= ~(kRight_NeighborFlag|kTopRight_NeighborFlag|kBottomRight_NeighborFlag);
+        int i = 0;
+        for (; i + 16 <= imageWidth; i += 16) {
+            Sk16b val = Sk16b::Load(row + i);
+            edge_class(val).store(classes + j*dataWidth + i);
+            for (int k = 0; k < 16; k += 4) {
+                Sk4f a = SkNx_cast<float>(Sk4b::Load(row + i + k));
+                (a == 255.0f).thenElse(1.0f, a*0.00392156862f)  // 1/255
+                             .store(alpha + j*dataWidth + i + k);
             }
-            if (j == 0) {
-                checkMask &= ~(kTopLeft_NeighborFlag|kTop_NeighborFlag|kTopRight_NeighborFlag);
+        }
+        for (; i < imageWidth; ++i) {
+            if (255 == row[i]) {
+                alpha[j*dataWidth + i] = 1.0f;
+            } else {
+                alpha[j*dataWidth + i] = row[i]*0.00392156862f;  // 1/255
             }
-            if (j == imageHeight-1) {
-                checkMask &= ~(kBottomLeft_NeighborFlag|kBottom_NeighborFlag|kBottomRight_NeighborFlag);
+            classes[j*dataWidth + i] = edge_class(row[i]);
+        }
+        row += imageWidth;
+    }
+
+    // edges, using 255 makes for convenient debug rendering
+    const int offsets[8] = { -dataWidth-1, -dataWidth, -dataWidth+1, -1, 1,
+                             dataWidth-1, dataWidth, dataWidth+1 };
+    row = image;
+    for (int j = 0; j < imageHeight; ++j) {
+        const unsigned char* currClass = classes + j*dataWidth;
+        unsigned char* currEdge = edges + j*dataWidth;
+        int i = 0;
+        for (; i + 16 <= imageWidth; i += 16) {
+            Sk16b neighbors = Sk16b::Load(currClass + i + offsets[0]);
+            for (int k = 1; k < 8; ++k) {
+                neighbors = neighbors | Sk16b::Load(currClass + i + offsets[k]);
             }
-            if (found_edge(image, imageWidth, checkMask)) {
-                *edges = 255;  // using 255 makes for convenient debug rendering
+            Sk16b found = neighbors & edge_neighbors(Sk16b::Load(row + i));
+            (Sk16b(0) < found).thenElse(255, 0).store(currEdge + i);
+        }
+        for (; i < imageWidth; ++i) {
+            unsigned char neighbors = 0;
+            for (int k = 0; k < 8; ++k) {
+                neighbors |= currClass[i + offsets[k]];
             }
-            ++data;
-            ++image;
-            ++edges;
+            currEdge[i] = (neighbors & edge_neighbors(row[i])) ? 255 : 0;
         }
-        data += 2*pad;
-        edges += 2*pad;
+        row += imageWidth;
     }
 }
 
@@ -147,169 +155,276 @@ static float edge_distance(const SkPoint& direction, float alpha) {
     return distance;
 }
 
-static void init_distances(DFData* data, unsigned char* edges, int width, int height) {
-    // skip one pixel border
-    DFData* currData = data;
-    DFData* prevData = data - width;
-    DFData* nextData = data + width;
+static void init_distances(const DFData& data, unsigned char* edges, int width, int height) {
+    // init distance to "far away"
+    for (int i = 0; i < width*height; ++i) {
+        data.fDistSq[i] = 2000000.f;
+        data.fDistX[i] = 1000.f;
+        data.fDistY[i] = 1000.f;
+    }
 
+    const float* alpha = data.fAlpha;
     for (int j = 0; j < height; ++j) {
         for (int i = 0; i < width; ++i) {
+            int curr = j*width + i;
             if (*edges) {
                 // we should not be in the one-pixel outside band
                 SkASSERT(i > 0 && i < width-1 && j > 0 && j < height-1);
+                int prev = curr - width;
+                int next = curr + width;
                 // gradient will point from low to high
                 // +y is down in this case
                 // i.e., if you're outside, gradient points towards edge
                 // if you're inside, gradient points away from edge
                 SkPoint currGrad;
-                currGrad.fX = (prevData+1)->fAlpha - (prevData-1)->fAlpha
-                             + SK_ScalarSqrt2*(currData+1)->fAlpha
-                             - SK_ScalarSqrt2*(currData-1)->fAlpha
-                             + (nextData+1)->fAlpha - (nextData-1)->fAlpha;
-                currGrad.fY = (nextData-1)->fAlpha - (prevData-1)->fAlpha
-                             + SK_ScalarSqrt2*nextData->fAlpha
-                             - SK_ScalarSqrt2*prevData->fAlpha
-                             + (nextData+1)->fAlpha - (prevData+1)->fAlpha;
+                currGrad.fX = alpha[prev+1] - alpha[prev-1]
+                             + SK_ScalarSqrt2*alpha[curr+1]
+                             - SK_ScalarSqrt2*alpha[curr-1]
+                             + alpha[next+1] - alpha[next-1];
+                currGrad.fY = alpha[next-1] - alpha[prev-1]
+                             + SK_ScalarSqrt2*alpha[next]
+                             - SK_ScalarSqrt2*alpha[prev]
+                             + alpha[next+1] - alpha[prev+1];
                 SkPointPriv::SetLengthFast(&currGrad, 1.0f);
 
                 // init squared distance to edge and distance vector
-                float dist = edge_distance(currGrad, currData->fAlpha);
-                currGrad.scale(dist, &currData->fDistVector);
-                currData->fDistSq = dist*dist;
-            } else {
-                // init distance to "far away"
-                currData->fDistSq = 2000000.f;
-                currData->fDistVector.fX = 1000.f;
-                currData->fDistVector.fY = 1000.f;
+                float dist = edge_distance(currGrad, alpha[curr]);
+                data.fDistX[curr] = currGrad.fX*dist;
+                data.fDistY[curr] = currGrad.fY*dist;
+                data.fDistSq[curr] = dist*dist;
             }
-            ++currData;
-            ++prevData;
-            ++nextData;
             ++edges;
         }
     }
 }
 
 // Danielsson's 8SSEDT
+//
+// Each pass below offers the current texel some of its neighbors' distance vectors, each moved
+// by one texel, and keeps the first that is strictly closer. The checks against the row above
+// (forward in Y) or below (backward in Y) only read a row that is already final, so they are
+// done for a whole row up front, four texels at a time. Only the checks against the left and
+// right neighbors, which depend on the texel just finished, are done one by one.
+
+// If the candidate is strictly closer than what curr has, take it.
+static inline void take_closer(const DFData& data, int curr, float distSq, float dx, float dy) {
+    if (distSq < data.fDistSq[curr]) {
+        data.fDistSq[curr] = distSq;
+        data.fDistX[curr] = dx;
+        data.fDistY[curr] = dy;
+    }
+}
+
+// Vector version of take_closer() on the lanes' own values.
+static inline void take_closer(const Sk4f& sq, const Sk4f& x, const Sk4f& y,
+                               Sk4f* distSq, Sk4f* dx, Sk4f* dy) {
+    auto closer = sq < *distSq;
+    *distSq = closer.thenElse(sq, *distSq);
+    *dx     = closer.thenElse(x,  *dx);
+    *dy     = closer.thenElse(y,  *dy);
+}
 
 // first stage forward pass
 // (forward in Y, forward in X)
-static void F1(DFData* curr, int width) {
+static void F1_above(const DFData& data, int curr, int width) {
+    const float* sq = data.fDistSq;
+    const float* x  = data.fDistX;
+    const float* y  = data.fDistY;
+
     // upper left
-    DFData* check = curr - width-1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq - 2.0f*(distVec.fX + distVec.fY - 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+    int check = curr - width-1;
+    take_closer(data, curr, sq[check] - 2.0f*(x[check] + y[check] - 1.0f),
+                x[check] - 1.0f, y[check] - 1.0f);
 
     // up
     check = curr - width;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*distVec.fY + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+    take_closer(data, curr, sq[check] - 2.0f*y[check] + 1.0f,
+                x[check], y[check] - 1.0f);
 
     // upper right
     check = curr - width+1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*(distVec.fX - distVec.fY + 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+    take_closer(data, curr, sq[check] + 2.0f*(x[check] - y[check] + 1.0f),
+                x[check] + 1.0f, y[check] - 1.0f);
+}
 
-    // left
-    check = curr - 1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
+// F1_above() for count texels from curr on, skipping edge texels.
+static void F1_above_row(const DFData& data, int curr, const unsigned char* edges,
+                         int width, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int c = curr + i;
+        Sk4f distSq = Sk4f::Load(data.fDistSq + c),
+             dx     = Sk4f::Load(data.fDistX  + c),
+             dy     = Sk4f::Load(data.fDistY  + c);
+
+        // upper left
+        int check = c - width-1;
+        Sk4f sq = Sk4f::Load(data.fDistSq + check),
+             x  = Sk4f::Load(data.fDistX  + check),
+             y  = Sk4f::Load(data.fDistY  + check);
+        take_closer(sq - (x + y - 1.0f)*2.0f, x - 1.0f, y - 1.0f, &distSq, &dx, &dy);
+
+        // up
+        check = c - width;
+        sq = Sk4f::Load(data.fDistSq + check);
+        x  = Sk4f::Load(data.fDistX  + check);
+        y  = Sk4f::Load(data.fDistY  + check);
+        take_closer(sq - y*2.0f + 1.0f, x, y - 1.0f, &distSq, &dx, &dy);
+
+        // upper right
+        check = c - width+1;
+        sq = Sk4f::Load(data.fDistSq + check);
+        x  = Sk4f::Load(data.fDistX  + check);
+        y  = Sk4f::Load(data.fDistY  + check);
+        take_closer(sq + (x - y + 1.0f)*2.0f, x + 1.0f, y - 1.0f, &distSq, &dx, &dy);
+
+        // don't need to calculate distance for edge pixels
+        auto isEdge = SkNx_cast<float>(Sk4b::Load(edges + i)) != 0.0f;
+        isEdge.thenElse(Sk4f::Load(data.fDistSq + c), distSq).store(data.fDistSq + c);
+        isEdge.thenElse(Sk4f::Load(data.fDistX  + c), dx    ).store(data.fDistX  + c);
+        isEdge.thenElse(Sk4f::Load(data.fDistY  + c), dy    ).store(data.fDistY  + c);
+    }
+    for (; i < count; ++i) {
+        if (!edges[i]) {
+            F1_above(data, curr + i, width);
+        }
     }
 }
 
-// second stage forward pass
-// (forward in Y, backward in X)
-static void F2(DFData* curr, int width) {
-    // right
-    DFData* check = curr + 1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq + 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
+// first stage backward pass, and the rest of the first stage forward pass
+// (forward in X)
+// The left check for count texels from curr on, skipping edge texels. Each texel checks the
+// one just finished, so that one is kept in registers rather than reloaded.
+static void left_row(const DFData& data, int curr, const unsigned char* edges, int count) {
+    float* sq = data.fDistSq + curr;
+    float* x  = data.fDistX  + curr;
+    float* y  = data.fDistY  + curr;
+    float prevSq = sq[-1], prevX = x[-1], prevY = y[-1];
+    for (int i = 0; i < count; ++i) {
+        float currSq = sq[i], currX = x[i], currY = y[i];
+        if (!edges[i]) {
+            // left
+            float distSq = prevSq - 2.0f*prevX + 1.0f;
+            if (distSq < currSq) {
+                currSq = distSq;
+                currX = prevX - 1.0f;
+                currY = prevY;
+                sq[i] = currSq;
+                x[i] = currX;
+                y[i] = currY;
+            }
+        }
+        prevSq = currSq;
+        prevX = currX;
+        prevY = currY;
     }
 }
 
-// first stage backward pass
-// (backward in Y, forward in X)
-static void B1(DFData* curr, int width) {
-    // left
-    DFData* check = curr - 1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq - 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
+// second stage forward pass
+// (backward in X)
+// Likewise for the right check, going back from the last texel. In the backward pass this also
+// offers each texel its entry in below, after the right check.
+static void right_row(const DFData& data, int curr, const unsigned char* edges, int count,
+                      const DFData* below) {
+    float* sq = data.fDistSq + curr;
+    float* x  = data.fDistX  + curr;
+    float* y  = data.fDistY  + curr;
+    float prevSq = sq[count], prevX = x[count], prevY = y[count];
+    for (int i = count-1; i >= 0; --i) {
+        float currSq = sq[i], currX = x[i], currY = y[i];
+        if (!edges[i]) {
+            // right
+            float distSq = prevSq + 2.0f*prevX + 1.0f;
+            bool changed = false;
+            if (distSq < currSq) {
+                currSq = distSq;
+                currX = prevX + 1.0f;
+                currY = prevY;
+                changed = true;
+            }
+            // bottom left, bottom, bottom right
+            if (below && below->fDistSq[i] < currSq) {
+                currSq = below->fDistSq[i];
+                currX = below->fDistX[i];
+                currY = below->fDistY[i];
+                changed = true;
+            }
+            if (changed) {
+                sq[i] = currSq;
+                x[i] = currX;
+                y[i] = currY;
+            }
+        }
+        prevSq = currSq;
+        prevX = currX;
+        prevY = currY;
     }
 }
 
 // second stage backward pass
 // (backward in Y, backwards in X)
-static void B2(DFData* curr, int width) {
-    // right
-    DFData* check = curr + 1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq + 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+// The right check comes before the ones below, so B2_below_row() can't apply those directly.
+// It finds the closest of the three for each texel into below, and right_row() offers that to
+// the texel after the right check. Keeping the first strictly closer candidate makes this the
+// same as checking all four in order.
+static void B2_below(const DFData& data, int curr, int width, const DFData& below, int b) {
+    const float* sq = data.fDistSq;
+    const float* x  = data.fDistX;
+    const float* y  = data.fDistY;
 
     // bottom left
-    check = curr + width-1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*(distVec.fX - distVec.fY - 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+    int check = curr + width-1;
+    below.fDistSq[b] = sq[check] - 2.0f*(x[check] - y[check] - 1.0f);
+    below.fDistX[b]  = x[check] - 1.0f;
+    below.fDistY[b]  = y[check] + 1.0f;
 
     // bottom
     check = curr + width;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*distVec.fY + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+    take_closer(below, b, sq[check] + 2.0f*y[check] + 1.0f,
+                x[check], y[check] + 1.0f);
 
     // bottom right
     check = curr + width+1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*(distVec.fX + distVec.fY + 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
+    take_closer(below, b, sq[check] + 2.0f*(x[check] + y[check] + 1.0f),
+                x[check] + 1.0f, y[check] + 1.0f);
+}
+
+// B2_below() for count texels from curr on, into the first count entries of below.
+static void B2_below_row(const DFData& data, int curr, int width, int count,
+                         const DFData& below) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int c = curr + i;
+
+        // bottom left
+        int check = c + width-1;
+        Sk4f sq = Sk4f::Load(data.fDistSq + check),
+             x  = Sk4f::Load(data.fDistX  + check),
+             y  = Sk4f::Load(data.fDistY  + check);
+        Sk4f distSq = sq - (x - y - 1.0f)*2.0f,
+             dx     = x - 1.0f,
+             dy     = y + 1.0f;
+
+        // bottom
+        check = c + width;
+        sq = Sk4f::Load(data.fDistSq + check);
+        x  = Sk4f::Load(data.fDistX  + check);
+        y  = Sk4f::Load(data.fDistY  + check);
+        take_closer(sq + y*2.0f + 1.0f, x, y + 1.0f, &distSq, &dx, &dy);
+
+        // bottom right
+        check = c + width+1;
+        sq = Sk4f::Load(data.fDistSq + check);
+        x  = Sk4f::Load(data.fDistX  + check);
+        y  = Sk4f::Load(data.fDistY  + check);
+        take_closer(sq + (x + y + 1.0f)*2.0f, x + 1.0f, y + 1.0f, &distSq, &dx, &dy);
+
+        distSq.store(below.fDistSq + i);
+        dx    .store(below.fDistX  + i);
+        dy    .store(below.fDistY  + i);
+    }
+    for (; i < count; ++i) {
+        B2_below(data, curr + i, width, below, i);
     }
 }
 
@@ -350,91 +465,59 @@ static bool generate_distance_field_from_image(unsigned char* distanceField,
     int dataWidth = width + 2*pad;
     int dataHeight = height + 2*pad;
 
-    // create zeroed temp DFData+edge storage
-    SkAutoFree storage(sk_calloc_throw(dataWidth*dataHeight*(sizeof(DFData) + 1)));
-    DFData*        dataPtr = (DFData*)storage.get();
-    unsigned char* edgePtr = (unsigned char*)storage.get() + dataWidth*dataHeight*sizeof(DFData);
+    // create temp DFData+edge+edge class storage, plus a row of DFData for the backward pass.
+    // Only alpha and edges need to start zeroed, the rest is all written before it is read.
+    int dataSize = dataWidth*dataHeight;
+    SkAutoFree storage(sk_malloc_throw((4*dataSize + 3*dataWidth)*sizeof(float) + 2*dataSize));
+    float* floatPtr = (float*)storage.get();
+    DFData data = { floatPtr, floatPtr + dataSize, floatPtr + 2*dataSize, floatPtr + 3*dataSize };
+    floatPtr += 4*dataSize;
+    DFData below = { nullptr, floatPtr, floatPtr + dataWidth, floatPtr + 2*dataWidth };
+    unsigned char* edgePtr = (unsigned char*)(floatPtr + 3*dataWidth);
+    unsigned char* classPtr = edgePtr + dataSize;
+    sk_bzero(data.fAlpha, dataSize*sizeof(float));
+    sk_bzero(edgePtr, dataSize);
 
     // copy glyph into distance field storage
-    init_glyph_data(dataPtr, edgePtr, copyPtr,
+    init_glyph_data(data, classPtr, edgePtr, copyPtr,
                     dataWidth, dataHeight,
                     width+2, height+2, SK_DistanceFieldPad);
 
     // create initial distance data, particularly at edges
-    init_distances(dataPtr, edgePtr, dataWidth, dataHeight);
+    init_distances(data, edgePtr, dataWidth, dataHeight);
 
     // now perform Euclidean distance transform to propagate distances
+    int rowCount = dataWidth-2; // skip outer buffer
 
     // forwards in y
-    DFData* currData = dataPtr+dataWidth+1; // skip outer buffer
-    unsigned char* currEdge = edgePtr+dataWidth+1;
     for (int j = 1; j < dataHeight-1; ++j) {
-        // forwards in x
-        for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                F1(currData, dataWidth);
-            }
-            ++currData;
-            ++currEdge;
-        }
-
-        // backwards in x
-        --currData; // reset to end
-        --currEdge;
-        for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                F2(currData, dataWidth);
-            }
-            --currData;
-            --currEdge;
-        }
+        int rowStart = j*dataWidth + 1;
+        const unsigned char* rowEdge = edgePtr + rowStart;
 
-        currData += dataWidth+1;
-        currEdge += dataWidth+1;
+        F1_above_row(data, rowStart, rowEdge, dataWidth, rowCount);
+        left_row(data, rowStart, rowEdge, rowCount);
+        right_row(data, rowStart, rowEdge, rowCount, nullptr);
     }
 
     // backwards in y
-    currData = dataPtr+dataWidth*(dataHeight-2) - 1; // skip outer buffer
-    currEdge = edgePtr+dataWidth*(dataHeight-2) - 1;
-    for (int j = 1; j < dataHeight-1; ++j) {
-        // forwards in x
-        for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                B1(currData, dataWidth);
-            }
-            ++currData;
-            ++currEdge;
-        }
-
-        // backwards in x
-        --currData; // reset to end
-        --currEdge;
-        for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                B2(currData, dataWidth);
-            }
-            --currData;
-            --currEdge;
-        }
+    for (int j = dataHeight-2; j > 0; --j) {
+        int rowStart = j*dataWidth - 1; // skip outer buffer
+        const unsigned char* rowEdge = edgePtr + rowStart;
 
-        currData -= dataWidth-1;
-        currEdge -= dataWidth-1;
+        left_row(data, rowStart, rowEdge, rowCount);
+        B2_below_row(data, rowStart, dataWidth, rowCount, below);
+        right_row(data, rowStart, rowEdge, rowCount, &below);
     }
 
     // copy results to final distance field data
-    currData = dataPtr + dataWidth+1;
-    currEdge = edgePtr + dataWidth+1;
     unsigned char *dfPtr = distanceField;
     for (int j = 1; j < dataHeight-1; ++j) {
         for (int i = 1; i < dataWidth-1; ++i) {
+            int curr = j*dataWidth + i;
 #if DUMP_EDGE
-            float alpha = currData->fAlpha;
+            float alpha = data.fAlpha[curr];
             float edge = 0.0f;
-            if (*currEdge) {
+            if (edgePtr[curr]) {
                 edge = 0.25f;
             }
             // blend with original image
@@ -443,18 +526,14 @@ static bool generate_distance_field_from_image(unsigned char* distanceField,
             *dfPtr++ = val;
 #else
             float dist;
-            if (currData->fAlpha > 0.5f) {
-                dist = -SkScalarSqrt(currData->fDistSq);
+            if (data.fAlpha[curr] > 0.5f) {
+                dist = -SkScalarSqrt(data.fDistSq[curr]);
             } else {
-                dist = SkScalarSqrt(currData->fDistSq);
+                dist = SkScalarSqrt(data.fDistSq[curr]);
             }
             *dfPtr++ = pack_distance_field_val<SK_DistanceFieldMagnitude>(dist);
 #endif
-            ++currData;
-            ++currEdge;
         }
-        currData += 2;
-        currEdge += 2;
     }
 
     return true;
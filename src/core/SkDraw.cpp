@@ -31,7 +31,10 @@
 #include "SkString.h"
 #include "SkStroke.h"
 #include "SkStrokeRec.h"
+#include "SkTArray.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
+#include "SkTextBlobRunIterator.h"
 #include "SkTextMapStateProc.h"
 #include "SkTLazy.h"
 #include "SkUtils.h"
@@ -68,6 +71,15 @@ bool SkDraw::computeConservativeLocalClipBounds(SkRect* localBounds) const {
     return true;
 }
 
+SkBlitter* SkDraw::clipToBlitBounds(SkBlitter* blitter, SkArenaAlloc* alloc) const {
+    if (!fBlitBounds || !blitter || blitter->isNullBlitter()) {
+        return blitter;
+    }
+    SkRectClipBlitter* clipper = alloc->make<SkRectClipBlitter>();
+    clipper->init(blitter, *fBlitBounds);
+    return clipper;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 typedef void (*BitmapXferProc)(void* pixels, size_t bytes, uint32_t data);
@@ -193,6 +205,9 @@ void SkDraw::drawPaint(const SkPaint& paint) const {
 
     SkIRect    devRect;
     devRect.set(0, 0, fDst.width(), fDst.height());
+    if (fBlitBounds && !devRect.intersect(*fBlitBounds)) {
+        return;
+    }
 
     if (fRC->isBW()) {
         /*  If we don't have a shader (i.e. we're just a solid color) we may
@@ -208,7 +223,7 @@ void SkDraw::drawPaint(const SkPaint& paint) const {
                 return;
             }
 
-            SkRegion::Iterator iter(fRC->bwRgn());
+            SkRegion::Cliperator iter(fRC->bwRgn(), devRect);
             while (!iter.done()) {
                 CallBitmapXferProc(fDst, iter.rect(), proc, procData);
                 iter.next();
@@ -218,7 +233,7 @@ void SkDraw::drawPaint(const SkPaint& paint) const {
     }
 
     // normal case: use a blitter
-    SkAutoBlitterChoose blitter(fDst, *fMatrix, paint);
+    SkAutoBlitterChoose blitter(*this, *fMatrix, paint);
     SkScan::FillIRect(devRect, *fRC, blitter.get());
 }
 
@@ -492,7 +507,7 @@ void SkDraw::drawPoints(SkCanvas::PointMode mode, size_t count,
 
     PtProcRec rec;
     if (!device && rec.init(mode, paint, fMatrix, fRC)) {
-        SkAutoBlitterChoose blitter(fDst, *fMatrix, paint);
+        SkAutoBlitterChoose blitter(*this, *fMatrix, paint);
 
         SkPoint             devPts[MAX_DEV_PTS];
         const SkMatrix*     matrix = fMatrix;
@@ -803,6 +818,14 @@ void SkDraw::drawRect(const SkRect& prePaintRect, const SkPaint& paint,
         const SkRasterClip& clip = looper.getRC();
         SkBlitter*          blitter = blitterStorage.get();
 
+        SkRectClipBlitter   blitBoundsClipper;
+        if (fBlitBounds) {
+            SkRect localBlitBounds;
+            looper.mapRect(&localBlitBounds, SkRect::Make(*fBlitBounds));
+            blitBoundsClipper.init(blitter, localBlitBounds.round());
+            blitter = &blitBoundsClipper;
+        }
+
         // we want to "fill" if we are kFill or kStrokeAndFill, since in the latter
         // case we are also hairline (if we've gotten to here), which devolves to
         // effectively just kFill
@@ -848,7 +871,7 @@ void SkDraw::drawDevMask(const SkMask& srcM, const SkPaint& paint) const {
     }
     SkAutoMaskFreeImage ami(dstM.fImage);
 
-    SkAutoBlitterChoose blitterChooser(fDst, *fMatrix, paint);
+    SkAutoBlitterChoose blitterChooser(*this, *fMatrix, paint);
     SkBlitter* blitter = blitterChooser.get();
 
     SkAAClipBlitterWrapper wrapper;
@@ -926,7 +949,7 @@ void SkDraw::drawRRect(const SkRRect& rrect, const SkPaint& paint) const {
         // Transform the rrect into device space.
         SkRRect devRRect;
         if (rrect.transform(*fMatrix, &devRRect)) {
-            SkAutoBlitterChoose blitter(fDst, *fMatrix, paint);
+            SkAutoBlitterChoose blitter(*this, *fMatrix, paint);
             if (paint.getMaskFilter()->filterRRect(devRRect, *fMatrix, *fRC, blitter.get())) {
                 return; // filterRRect() called the blitter, so we're done
             }
@@ -980,7 +1003,7 @@ void SkDraw::drawDevPath(const SkPath& devPath, const SkPaint& paint, bool drawC
     SkBlitter* blitter = nullptr;
     SkAutoBlitterChoose blitterStorage;
     if (nullptr == customBlitter) {
-        blitterStorage.choose(fDst, *fMatrix, paint, drawCoverage);
+        blitterStorage.choose(*this, *fMatrix, paint, drawCoverage);
         blitter = blitterStorage.get();
     } else {
         blitter = customBlitter;
@@ -1268,7 +1291,7 @@ void SkDraw::drawBitmap(const SkBitmap& bitmap, const SkMatrix& prematrix,
             SkBlitter* blitter = SkBlitter::ChooseSprite(fDst, *paint, pmap, ix, iy, &allocator);
             if (blitter) {
                 SkScan::FillIRect(SkIRect::MakeXYWH(ix, iy, pmap.width(), pmap.height()),
-                                  *fRC, blitter);
+                                  *fRC, this->clipToBlitBounds(blitter, &allocator));
                 return;
             }
             // if !blitter, then we fall-through to the slower case
@@ -1322,7 +1345,7 @@ void SkDraw::drawSprite(const SkBitmap& bitmap, int x, int y, const SkPaint& ori
         SkSTArenaAlloc<kSkBlitterContextSize> allocator;
         SkBlitter* blitter = SkBlitter::ChooseSprite(fDst, paint, pmap, x, y, &allocator);
         if (blitter) {
-            SkScan::FillIRect(bounds, *fRC, blitter);
+            SkScan::FillIRect(bounds, *fRC, this->clipToBlitBounds(blitter, &allocator));
             return;
         }
     }
@@ -1514,14 +1537,18 @@ private:
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-uint32_t SkDraw::scalerContextFlags() const {
+uint32_t SkDraw::ScalerContextFlags(const SkColorSpace* dstColorSpace) {
     uint32_t flags = SkPaint::kBoostContrast_ScalerContextFlag;
-    if (!fDst.colorSpace()) {
+    if (!dstColorSpace) {
         flags |= SkPaint::kFakeGamma_ScalerContextFlag;
     }
     return flags;
 }
 
+uint32_t SkDraw::scalerContextFlags() const {
+    return ScalerContextFlags(fDst.colorSpace());
+}
+
 void SkDraw::drawText(const char text[], size_t byteLength, SkScalar x, SkScalar y,
                       const SkPaint& paint, const SkSurfaceProps* props) const {
     SkASSERT(byteLength == 0 || text != nullptr);
@@ -1543,7 +1570,7 @@ void SkDraw::drawText(const char text[], size_t byteLength, SkScalar x, SkScalar
     SkAutoGlyphCache cache(paint, props, this->scalerContextFlags(), fMatrix);
 
     // The Blitter Choose needs to be live while using the blitter below.
-    SkAutoBlitterChoose    blitterChooser(fDst, *fMatrix, paint);
+    SkAutoBlitterChoose    blitterChooser(*this, *fMatrix, paint);
     SkAAClipBlitterWrapper wrapper(*fRC, blitterChooser.get());
     DrawOneGlyph           drawOneGlyph(*this, paint, cache.get(), wrapper.getBlitter());
 
@@ -1621,7 +1648,7 @@ void SkDraw::drawPosText(const char text[], size_t byteLength, const SkScalar po
     SkAutoGlyphCache cache(paint, props, this->scalerContextFlags(), fMatrix);
 
     // The Blitter Choose needs to be live while using the blitter below.
-    SkAutoBlitterChoose    blitterChooser(fDst, *fMatrix, paint);
+    SkAutoBlitterChoose    blitterChooser(*this, *fMatrix, paint);
     SkAAClipBlitterWrapper wrapper(*fRC, blitterChooser.get());
     DrawOneGlyph           drawOneGlyph(*this, paint, cache.get(), wrapper.getBlitter());
     SkPaint::Align         textAlignment = paint.getTextAlign();
@@ -1631,6 +1658,79 @@ void SkDraw::drawPosText(const char text[], size_t byteLength, const SkScalar po
         offset, *fMatrix, pos, scalarsPerPosition, textAlignment, cache.get(), drawOneGlyph);
 }
 
+void SkDraw::PrepareTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
+                             const SkPaint& paint, const SkMatrix& matrix,
+                             const SkBaseDevice& device, SkExecutor* executor) {
+    // Mirrors SkBaseDevice::drawTextBlob() and drawText()/drawPosText(), but only looks up the
+    // glyphs and their images instead of blitting them.
+    const SkSurfaceProps* surfaceProps = &device.surfaceProps();
+    uint32_t scalerContextFlags = ScalerContextFlags(device.imageInfo().colorSpace());
+
+    struct Run {
+        SkPaint         fPaint;
+        const uint16_t* fGlyphs;
+        size_t          fByteLength;
+        const SkScalar* fPos;
+        int             fScalarsPerPosition;  // 0 for default positioning.
+        SkPoint         fOffset;
+    };
+
+    SkTArray<Run> runs;
+    for (SkTextBlobRunIterator it(blob); !it.done(); it.next()) {
+        Run& run = runs.push_back();
+        run.fPaint = paint;
+        it.applyFontToPaint(&run.fPaint);
+        run.fPaint.setFlags(device.filterTextFlags(run.fPaint));
+        if (ShouldDrawTextAsPaths(run.fPaint, matrix)) {
+            runs.pop_back();
+            continue;
+        }
+        run.fGlyphs = it.glyphs();
+        run.fByteLength = it.glyphCount() * sizeof(uint16_t);
+        run.fPos = it.pos();
+        switch (it.positioning()) {
+            case SkTextBlob::kDefault_Positioning:
+                run.fScalarsPerPosition = 0;
+                run.fOffset = {x + it.offset().x(), y + it.offset().y()};
+                break;
+            case SkTextBlob::kHorizontal_Positioning:
+                run.fScalarsPerPosition = 1;
+                run.fOffset = {x, y + it.offset().y()};
+                break;
+            case SkTextBlob::kFull_Positioning:
+                run.fScalarsPerPosition = 2;
+                run.fOffset = {x, y};
+                break;
+        }
+    }
+
+    auto prepareRun = [&](int i) {
+        const Run& run = runs[i];
+        SkAutoGlyphCache cache(run.fPaint, surfaceProps, scalerContextFlags, &matrix);
+        auto findImage = [&cache](const SkGlyph& glyph, SkPoint, SkPoint) {
+            cache->findImage(glyph);
+        };
+        if (run.fScalarsPerPosition == 0) {
+            SkFindAndPlaceGlyph::ProcessText(
+                run.fPaint.getTextEncoding(), (const char*)run.fGlyphs, run.fByteLength,
+                run.fOffset, matrix, run.fPaint.getTextAlign(), cache.get(), findImage);
+        } else {
+            SkFindAndPlaceGlyph::ProcessPosText(
+                run.fPaint.getTextEncoding(), (const char*)run.fGlyphs, run.fByteLength,
+                run.fOffset, matrix, run.fPos, run.fScalarsPerPosition,
+                run.fPaint.getTextAlign(), cache.get(), findImage);
+        }
+    };
+
+    if (executor && runs.count() > 1) {
+        SkTaskGroup(*executor).batch(runs.count(), prepareRun);
+    } else {
+        for (int i = 0; i < runs.count(); ++i) {
+            prepareRun(i);
+        }
+    }
+}
+
 #if defined _WIN32
 #pragma warning ( pop )
 #endif
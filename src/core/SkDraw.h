@@ -17,14 +17,17 @@
 #include "SkStrokeRec.h"
 #include "SkVertices.h"
 
+class SkArenaAlloc;
 class SkBitmap;
 class SkClipStack;
 class SkBaseDevice;
 class SkBlitter;
+class SkExecutor;
 class SkMatrix;
 class SkPath;
 class SkRegion;
 class SkRasterClip;
+class SkTextBlob;
 struct SkDrawProcs;
 struct SkRect;
 class SkRRect;
@@ -121,6 +124,26 @@ public:
                                     int scalarsPerPosition, const SkPoint& offset,
                                     const SkPaint&, const SkSurfaceProps*) const;
     static SkScalar ComputeResScaleForStroking(const SkMatrix& );
+
+    /**
+     *  Generate the images of every glyph that drawing blob at (x, y) with paint under matrix
+     *  into device would use, so that the draw itself only has to blit. Runs are spread across
+     *  executor; if it is null the work is done on the calling thread. Glyphs that end up drawn
+     *  as paths are skipped.
+     */
+    static void PrepareTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
+                                const SkPaint& paint, const SkMatrix& matrix,
+                                const SkBaseDevice& device, SkExecutor* executor);
+
+    /** Returns the fake gamma and contrast flags used when drawing into dstColorSpace. */
+    static uint32_t ScalerContextFlags(const SkColorSpace* dstColorSpace);
+
+    /**
+     *  If fBlitBounds is set, return a blitter (allocated in alloc) that only passes on to blitter
+     *  what falls inside fBlitBounds. Otherwise just return blitter.
+     */
+    SkBlitter* clipToBlitBounds(SkBlitter* blitter, SkArenaAlloc* alloc) const;
+
 private:
     void    drawBitmapAsMask(const SkBitmap&, const SkPaint&) const;
 
@@ -149,6 +172,10 @@ public:
     SkPixmap        fDst;
     const SkMatrix* fMatrix;        // required
     const SkRasterClip* fRC;        // required
+    // Optional. When set, geometry is still rasterized against all of fRC, but only pixels inside
+    // these bounds are written. SkThreadedBMPDevice draws each tile this way, so that tile seams
+    // don't chop edges and its tiles add up to exactly what one whole-device draw would write.
+    const SkIRect*  fBlitBounds;
 
 #ifdef SK_DEBUG
     void validate() const;
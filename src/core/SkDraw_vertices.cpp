@@ -251,7 +251,8 @@ void SkDraw::drawVertices(SkVertices::VertexMode vmode, int count,
 
         if (!textures) {    // only tricolor shader
             SkASSERT(matrix43);
-            auto blitter = SkCreateRasterPipelineBlitter(fDst, p, *fMatrix, &outerAlloc);
+            auto blitter = this->clipToBlitBounds(
+                    SkCreateRasterPipelineBlitter(fDst, p, *fMatrix, &outerAlloc), &outerAlloc);
             while (vertProc(&state)) {
                 if (!update_tricolor_matrix(ctmInv, vertices, dstColors,
                                             state.f0, state.f1, state.f2,
@@ -286,7 +287,8 @@ void SkDraw::drawVertices(SkVertices::VertexMode vmode, int count,
                 SkPoint tmp[] = {
                     devVerts[state.f0], devVerts[state.f1], devVerts[state.f2]
                 };
-                auto blitter = SkCreateRasterPipelineBlitter(fDst, p, *ctm, &innerAlloc);
+                auto blitter = this->clipToBlitBounds(
+                        SkCreateRasterPipelineBlitter(fDst, p, *ctm, &innerAlloc), &innerAlloc);
                 SkScan::FillTriangle(tmp, *fRC, blitter);
             }
         }
@@ -294,7 +296,7 @@ void SkDraw::drawVertices(SkVertices::VertexMode vmode, int count,
         // no colors[] and no texture, stroke hairlines with paint's color.
         SkPaint p;
         p.setStyle(SkPaint::kStroke_Style);
-        SkAutoBlitterChoose blitter(fDst, *fMatrix, p);
+        SkAutoBlitterChoose blitter(*this, *fMatrix, p);
         // Abort early if we failed to create a shader context.
         if (blitter->isNullBlitter()) {
             return;
@@ -0,0 +1,195 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkFontMatchCache.h"
+#include "SkOpts.h"
+#include "SkTSort.h"
+
+#include <thread>
+
+static constexpr int kInitialCapacity = 64;
+
+SkFontMatchCache::Key::Key(Kind kind, const char familyName[], const SkFontStyle& style,
+                           const char* bcp47[], int bcp47Count, SkUnichar character) {
+    sk_bzero(&fHeader, sizeof(fHeader));
+    fHeader.fKind = kind;
+    fHeader.fWeight = style.weight();
+    fHeader.fWidth = style.width();
+    fHeader.fSlant = style.slant();
+    fHeader.fCharacter = character;
+    // nullptr asks for the default family, which is not the same as asking for "".
+    fHeader.fHasFamilyName = familyName != nullptr;
+
+    if (familyName) {
+        fNames.append(familyName, strlen(familyName) + 1);
+    }
+    for (int i = 0; i < bcp47Count; ++i) {
+        fNames.append(bcp47[i], strlen(bcp47[i]) + 1);
+    }
+
+    fHash = SkOpts::hash(fNames.c_str(), fNames.size(),
+                         SkOpts::hash(&fHeader, sizeof(fHeader)));
+}
+
+SkFontMatchCache::Table::Table(int capacity)
+    : fCapacity(capacity)
+    , fSlots(new std::atomic<Entry*>[capacity]) {
+    SkASSERT(SkIsPow2(capacity));
+    for (int i = 0; i < capacity; ++i) {
+        fSlots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+SkFontMatchCache::SkFontMatchCache()
+    : fClock(0)
+    , fEpoch(0)
+    , fOwnedTable(new Table(kInitialCapacity))
+    , fCount(0) {
+    fReaders[0].store(0, std::memory_order_relaxed);
+    fReaders[1].store(0, std::memory_order_relaxed);
+    fTable.store(fOwnedTable.get(), std::memory_order_release);
+}
+
+SkFontMatchCache::~SkFontMatchCache() {
+    for (int i = 0; i < fOwnedTable->fCapacity; ++i) {
+        delete fOwnedTable->fSlots[i].load(std::memory_order_relaxed);
+    }
+}
+
+const SkFontMatchCache::Entry* SkFontMatchCache::Find(const Table* table, const Key& key) {
+    int mask = table->fCapacity - 1;
+    for (int i = key.fHash & mask; ; i = (i + 1) & mask) {
+        // Tables are never more than half full, so this always finds an empty slot.
+        const Entry* entry = table->fSlots[i].load(std::memory_order_acquire);
+        if (!entry) {
+            return nullptr;
+        }
+        if (entry->fKey == key) {
+            return entry;
+        }
+    }
+}
+
+void SkFontMatchCache::Insert(Table* table, Entry* entry) {
+    int mask = table->fCapacity - 1;
+    for (int i = entry->fKey.fHash & mask; ; i = (i + 1) & mask) {
+        if (!table->fSlots[i].load(std::memory_order_relaxed)) {
+            // Release, so a lookup that sees the entry also sees its contents.
+            table->fSlots[i].store(entry, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+bool SkFontMatchCache::find(const Key& key, sk_sp<SkTypeface>* typeface) const {
+    // These are sequentially consistent, to pair with publish(): either publish() waits for us,
+    // or we load the table it published.
+    const int epoch = fEpoch.load();
+    fReaders[epoch].fetch_add(1);
+    const Entry* entry = Find(fTable.load(), key);
+    if (entry) {
+        // Only write when the stamp changes, so that hot entries don't bounce between caches.
+        const uint32_t now = fClock.load(std::memory_order_relaxed);
+        if (entry->fLastUse.load(std::memory_order_relaxed) != now) {
+            entry->fLastUse.store(now, std::memory_order_relaxed);
+        }
+        *typeface = entry->fTypeface;
+    }
+    fReaders[epoch].fetch_sub(1, std::memory_order_release);
+    return entry != nullptr;
+}
+
+void SkFontMatchCache::add(const Key& key, sk_sp<SkTypeface> typeface) {
+    SkAutoMutexAcquire lock(fMutex);
+    // Another thread may have matched and added the same key meanwhile.
+    if (Find(fOwnedTable.get(), key)) {
+        return;
+    }
+
+    if (fCount >= kMaxEntries) {
+        this->evict();
+    }
+
+    Table* table = fOwnedTable.get();
+    if (2 * (fCount + 1) > table->fCapacity) {
+        std::unique_ptr<Table> bigger(new Table(2 * table->fCapacity));
+        for (int i = 0; i < table->fCapacity; ++i) {
+            if (Entry* entry = table->fSlots[i].load(std::memory_order_relaxed)) {
+                Insert(bigger.get(), entry);
+            }
+        }
+        table = bigger.get();
+        this->publish(std::move(bigger), nullptr);
+    }
+
+    const uint32_t now = fClock.fetch_add(1, std::memory_order_relaxed) + 1;
+    Insert(table, new Entry(key, std::move(typeface), now));
+    ++fCount;
+}
+
+void SkFontMatchCache::evict() {
+    const Table* table = fOwnedTable.get();
+    const uint32_t now = fClock.load(std::memory_order_relaxed);
+
+    // Lookups keep stamping entries, so sort on a snapshot of their ages.
+    struct Aged {
+        uint32_t fAge;
+        Entry*   fEntry;
+    };
+    SkTDArray<Aged> entries;
+    for (int i = 0; i < table->fCapacity; ++i) {
+        if (Entry* entry = table->fSlots[i].load(std::memory_order_relaxed)) {
+            *entries.append() = { now - entry->fLastUse.load(std::memory_order_relaxed), entry };
+        }
+    }
+    SkASSERT(entries.count() == fCount);
+    SkTQSort(entries.begin(), entries.end() - 1, [](const Aged& a, const Aged& b) {
+        return a.fAge > b.fAge;  // oldest first
+    });
+
+    const int dropCount = SkTMin(entries.count(), kMaxEntries / 4);
+    SkTDArray<Entry*> dropped;
+    std::unique_ptr<Table> kept(new Table(table->fCapacity));
+    for (int i = 0; i < entries.count(); ++i) {
+        if (i < dropCount) {
+            *dropped.append() = entries[i].fEntry;
+        } else {
+            Insert(kept.get(), entries[i].fEntry);
+        }
+    }
+    fCount -= dropCount;
+    this->publish(std::move(kept), &dropped);
+}
+
+void SkFontMatchCache::publish(std::unique_ptr<Table> table, SkTDArray<Entry*>* dropped) {
+    fTable.store(table.get());
+    std::unique_ptr<Table> replaced = std::move(fOwnedTable);
+    fOwnedTable = std::move(table);
+
+    // A lookup that read fEpoch before a flip may only count itself in the old epoch after the
+    // wait for that epoch is over. It then reads the table published before the flip, which a
+    // later publish() replaces. Waiting out both epochs each time makes sure it is done as well.
+    for (int i = 0; i < 2; ++i) {
+        const int epoch = fEpoch.load(std::memory_order_relaxed);  // Only changed under fMutex.
+        fEpoch.store(epoch ^ 1);
+        while (fReaders[epoch].load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (dropped) {
+        for (Entry* entry : *dropped) {
+            delete entry;
+        }
+    }
+    // replaced is freed on return.
+}
+
+int SkFontMatchCache::count() const {
+    SkAutoMutexAcquire lock(fMutex);
+    return fCount;
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkFontMatchCache_DEFINED
+#define SkFontMatchCache_DEFINED
+
+#include "SkFontStyle.h"
+#include "SkMutex.h"
+#include "SkRefCnt.h"
+#include "SkString.h"
+#include "SkTDArray.h"
+#include "SkTypeface.h"
+
+#include <atomic>
+#include <memory>
+
+/**
+ *  Remembers what an SkFontMgr resolved a family, style and (for fallback) character to, so that
+ *  asking again does not go back to the platform font matching.
+ *
+ *  Lookups take no lock. They read the published table, and stamp the entry they find with the
+ *  current add count using a relaxed store. Adds are serialized by a mutex. A new entry goes into
+ *  the published table with a release store; when the table is half full, a bigger copy is
+ *  published instead.
+ *
+ *  The cache holds at most kMaxEntries results. Keys are per character for fallback, so text in a
+ *  large script cycles through entries. When the cache is full, the least recently used quarter of
+ *  the entries (including remembered misses) is dropped, and a table without them is published.
+ *  Replaced tables and dropped entries are only freed after every lookup that might still be
+ *  reading them has finished.
+ */
+class SkFontMatchCache {
+public:
+    enum Kind {
+        kFamilyStyle_Kind,
+        kFamilyStyleCharacter_Kind,
+        kLegacyMakeTypeface_Kind,
+    };
+
+    class Key {
+    public:
+        Key(Kind, const char familyName[], const SkFontStyle&,
+            const char* bcp47[] = nullptr, int bcp47Count = 0, SkUnichar character = 0);
+
+        bool operator==(const Key& that) const {
+            return fHash == that.fHash &&
+                   !memcmp(&fHeader, &that.fHeader, sizeof(fHeader)) &&
+                   fNames == that.fNames;
+        }
+
+    private:
+        friend class SkFontMatchCache;
+
+        struct Header {
+            int32_t   fKind;
+            int32_t   fWeight;
+            int32_t   fWidth;
+            int32_t   fSlant;
+            SkUnichar fCharacter;
+            int32_t   fHasFamilyName;
+        };
+        Header   fHeader;
+        SkString fNames;  // The family name then the bcp47 tags, each followed by a 0.
+        uint32_t fHash;
+    };
+
+    SkFontMatchCache();
+    ~SkFontMatchCache();
+
+    /**
+     *  If key is in the cache, returns true and sets typeface to what was added for it, which
+     *  may be nullptr. Otherwise returns false.
+     */
+    bool find(const Key&, sk_sp<SkTypeface>* typeface) const;
+
+    /** Remembers typeface, which may be nullptr, as the result for key. */
+    void add(const Key&, sk_sp<SkTypeface> typeface);
+
+    int count() const;
+
+    static constexpr int kMaxEntries = 4096;
+
+private:
+    struct Entry {
+        Entry(const Key& key, sk_sp<SkTypeface> typeface, uint32_t lastUse)
+            : fKey(key), fTypeface(std::move(typeface)), fLastUse(lastUse) {}
+
+        const Key                     fKey;
+        const sk_sp<SkTypeface>       fTypeface;
+        mutable std::atomic<uint32_t> fLastUse;  // fClock when this was last found or added.
+    };
+
+    struct Table {
+        explicit Table(int capacity);
+
+        int                                    fCapacity;  // Always a power of 2.
+        std::unique_ptr<std::atomic<Entry*>[]> fSlots;
+    };
+
+    static const Entry* Find(const Table*, const Key&);
+    static void Insert(Table*, Entry*);
+
+    // Drop the least recently used entries, and publish a table of the rest.
+    void evict();
+
+    // Publish table, then free the table it replaces and the entries in dropped once no lookup
+    // can be reading them any more.
+    void publish(std::unique_ptr<Table> table, SkTDArray<Entry*>* dropped);
+
+    std::atomic<Table*>     fTable;
+    std::atomic<uint32_t>   fClock;
+
+    // A lookup counts itself in fReaders[fEpoch] while it reads the table. Before freeing
+    // anything a lookup could see, publish() flips fEpoch and waits for the old count to drain,
+    // twice, so that every lookup that started before the new table was published has finished.
+    std::atomic<int>        fEpoch;
+    mutable std::atomic<int> fReaders[2];
+
+    mutable SkMutex         fMutex;
+    std::unique_ptr<Table>  fOwnedTable;  // guarded by fMutex; the same as fTable
+    int                     fCount;       // guarded by fMutex
+};
+
+#endif
@@ -6,6 +6,7 @@
  */
 
 #include "SkFontDescriptor.h"
+#include "SkFontMatchCache.h"
 #include "SkFontMgr.h"
 #include "SkOnce.h"
 #include "SkStream.h"
@@ -91,6 +92,22 @@ static SkFontStyleSet* emptyOnNull(SkFontStyleSet* fsset) {
     return fsset;
 }
 
+SkFontMgr::SkFontMgr() : fMatchCache(new SkFontMatchCache) {}
+
+SkFontMgr::~SkFontMgr() {}
+
+// Looks key up in cache, and on a miss calls match() and remembers what it returns.
+template <typename Match>
+static sk_sp<SkTypeface> find_or_match(SkFontMatchCache* cache, const SkFontMatchCache::Key& key,
+                                       Match&& match) {
+    sk_sp<SkTypeface> typeface;
+    if (!cache->find(key, &typeface)) {
+        typeface = match();
+        cache->add(key, typeface);
+    }
+    return typeface;
+}
+
 int SkFontMgr::countFamilies() const {
     return this->onCountFamilies();
 }
@@ -109,13 +126,21 @@ SkFontStyleSet* SkFontMgr::matchFamily(const char familyName[]) const {
 
 SkTypeface* SkFontMgr::matchFamilyStyle(const char familyName[],
                                         const SkFontStyle& fs) const {
-    return this->onMatchFamilyStyle(familyName, fs);
+    SkFontMatchCache::Key key(SkFontMatchCache::kFamilyStyle_Kind, familyName, fs);
+    return find_or_match(fMatchCache.get(), key, [&] {
+        return sk_sp<SkTypeface>(this->onMatchFamilyStyle(familyName, fs));
+    }).release();
 }
 
 SkTypeface* SkFontMgr::matchFamilyStyleCharacter(const char familyName[], const SkFontStyle& style,
                                                  const char* bcp47[], int bcp47Count,
                                                  SkUnichar character) const {
-    return this->onMatchFamilyStyleCharacter(familyName, style, bcp47, bcp47Count, character);
+    SkFontMatchCache::Key key(SkFontMatchCache::kFamilyStyleCharacter_Kind, familyName, style,
+                              bcp47, bcp47Count, character);
+    return find_or_match(fMatchCache.get(), key, [&] {
+        return sk_sp<SkTypeface>(this->onMatchFamilyStyleCharacter(familyName, style,
+                                                                   bcp47, bcp47Count, character));
+    }).release();
 }
 
 SkTypeface* SkFontMgr::matchFaceStyle(const SkTypeface* face,
@@ -161,7 +186,10 @@ sk_sp<SkTypeface> SkFontMgr::makeFromFile(const char path[], int ttcIndex) const
 }
 
 sk_sp<SkTypeface> SkFontMgr::legacyMakeTypeface(const char familyName[], SkFontStyle style) const {
-    return this->onLegacyMakeTypeface(familyName, style);
+    SkFontMatchCache::Key key(SkFontMatchCache::kLegacyMakeTypeface_Kind, familyName, style);
+    return find_or_match(fMatchCache.get(), key, [&] {
+        return this->onLegacyMakeTypeface(familyName, style);
+    });
 }
 
 sk_sp<SkTypeface> SkFontMgr::onMakeFromStreamArgs(std::unique_ptr<SkStreamAsset> stream,
@@ -155,12 +155,19 @@ public:
     int8_t      fRsbDelta, fLsbDelta;  // used by auto-kerning
     int8_t      fForceBW;
 
+    // Bookkeeping for the strike that owns fImage: how many bytes were allocated for it, and the
+    // strike's use count when it was last asked for, so cold images can be evicted.
+    uint32_t    fImageAllocSize;
+    uint32_t    fLastUse;
+
     void initWithGlyphID(SkPackedGlyphID glyph_id) {
         fID             = glyph_id;
         fImage          = nullptr;
         fPathData       = nullptr;
         fMaskFormat     = MASK_FORMAT_UNKNOWN;
         fForceBW        = 0;
+        fImageAllocSize = 0;
+        fLastUse        = 0;
     }
 
     static size_t BitsToBytes(size_t bits) {
@@ -224,6 +231,7 @@ public:
             SK_ABORT("Unknown mask format.");
             break;
         }
+        fImageAllocSize = SkToU32(allocSize);
         return allocSize;
     }
 
@@ -8,13 +8,16 @@
 #include "SkGlyphCache.h"
 #include "SkGlyphCache_Globals.h"
 #include "SkGraphics.h"
+#include "SkMakeUnique.h"
 #include "SkOnce.h"
 #include "SkPath.h"
 #include "SkTemplates.h"
+#include "SkTSort.h"
 #include "SkTraceMemoryDump.h"
 #include "SkTypeface.h"
 
 #include <cctype>
+#include <utility>
 
 //#define SPEW_PURGE_STATUS
 
@@ -44,10 +47,19 @@ SkGlyphCache::SkGlyphCache(const SkDescriptor* desc, std::unique_ptr<SkScalerCon
     fScalerContext->getFontMetrics(&fFontMetrics);
 
     fMemoryUsed = sizeof(*this);
+    fMemoryAccounted = 0;
+    fPinCount = 0;
+    fUseCount = 0;
+    fStoredStrike = nullptr;
+
+    fImageAlloc = skstd::make_unique<SkArenaAlloc>(kMinAllocAmount);
+    fImageBytesAllocated = 0;
+    fImageBytesLive = 0;
 }
 
 SkGlyphCache::~SkGlyphCache() {
-    fGlyphMap.foreach([](SkGlyph* g) {
+    fGlyphMap.foreach([](SkGlyph** glyph) {
+        const SkGlyph* g = *glyph;
         if (g->fPathData) {
             delete g->fPathData->fPath;
         }
@@ -73,6 +85,18 @@ SkGlyphCache::CharGlyphRec* SkGlyphCache::getCharGlyphRec(SkPackedUnicharID pack
 SkGlyphID SkGlyphCache::unicharToGlyph(SkUnichar charCode) {
     VALIDATE();
     SkPackedUnicharID packedUnicharID(charCode);
+    {
+        SkAutoSharedMutexShared lock(fLock);
+        if (fPackedUnicharIDToPackedGlyphID) {
+            const CharGlyphRec& rec =
+                    fPackedUnicharIDToPackedGlyphID[packedUnicharID.hash() & kHashMask];
+            if (rec.fPackedUnicharID == packedUnicharID) {
+                return rec.fPackedGlyphID.code();
+            }
+        }
+    }
+
+    SkAutoExclusive lock(fLock);
     CharGlyphRec* rec = this->getCharGlyphRec(packedUnicharID);
 
     if (rec->fPackedUnicharID == packedUnicharID) {
@@ -88,17 +112,30 @@ SkGlyphID SkGlyphCache::unicharToGlyph(SkUnichar charCode) {
 }
 
 SkUnichar SkGlyphCache::glyphToUnichar(SkGlyphID glyphID) {
+    SkAutoExclusive lock(fLock);
     return fScalerContext->glyphIDToChar(glyphID);
 }
 
 unsigned SkGlyphCache::getGlyphCount() const {
+    SkAutoExclusive lock(fLock);
     return fScalerContext->getGlyphCount();
 }
 
 int SkGlyphCache::countCachedGlyphs() const {
+    SkAutoSharedMutexShared lock(fLock);
     return fGlyphMap.count();
 }
 
+size_t SkGlyphCache::getImageBytesLive() const {
+    SkAutoSharedMutexShared lock(fLock);
+    return fImageBytesLive;
+}
+
+size_t SkGlyphCache::getImageBytesFragmented() const {
+    SkAutoSharedMutexShared lock(fLock);
+    return fImageBytesAllocated - fImageBytesLive;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 const SkGlyph& SkGlyphCache::getUnicharAdvance(SkUnichar charCode) {
@@ -138,74 +175,216 @@ const SkGlyph& SkGlyphCache::getGlyphIDMetrics(uint16_t glyphID, SkFixed x, SkFi
 
 SkGlyph* SkGlyphCache::lookupByChar(SkUnichar charCode, MetricsType type, SkFixed x, SkFixed y) {
     SkPackedUnicharID id(charCode, x, y);
+    {
+        SkAutoSharedMutexShared lock(fLock);
+        if (fPackedUnicharIDToPackedGlyphID) {
+            const CharGlyphRec& rec = fPackedUnicharIDToPackedGlyphID[id.hash() & kHashMask];
+            if (rec.fPackedUnicharID == id) {
+                if (SkGlyph* glyph = this->findExistingGlyph(rec.fPackedGlyphID, type)) {
+                    return glyph;
+                }
+            }
+        }
+    }
+
+    SkAutoExclusive lock(fLock);
     CharGlyphRec* rec = this->getCharGlyphRec(id);
     if (rec->fPackedUnicharID != id) {
         rec->fPackedUnicharID = id;
         rec->fPackedGlyphID = SkPackedGlyphID(fScalerContext->charToGlyphID(charCode), x, y);
     }
-    return this->lookupByPackedGlyphID(rec->fPackedGlyphID, type);
+    return this->internalLookupByPackedGlyphID(rec->fPackedGlyphID, type);
+}
+
+SkGlyph* SkGlyphCache::findExistingGlyph(SkPackedGlyphID packedGlyphID, MetricsType type) const {
+    SkGlyph** glyph = fGlyphMap.find(packedGlyphID);
+    if (glyph && (type == kJustAdvance_MetricsType || !(*glyph)->isJustAdvance())) {
+        return *glyph;
+    }
+    return nullptr;
 }
 
 SkGlyph* SkGlyphCache::lookupByPackedGlyphID(SkPackedGlyphID packedGlyphID, MetricsType type) {
-    SkGlyph* glyph = fGlyphMap.find(packedGlyphID);
+    {
+        SkAutoSharedMutexShared lock(fLock);
+        if (SkGlyph* glyph = this->findExistingGlyph(packedGlyphID, type)) {
+            return glyph;
+        }
+    }
+
+    // Another thread may add the glyph between dropping the shared lock and taking the exclusive
+    // one, so look it up again.
+    SkAutoExclusive lock(fLock);
+    return this->internalLookupByPackedGlyphID(packedGlyphID, type);
+}
 
-    if (nullptr == glyph) {
+SkGlyph* SkGlyphCache::internalLookupByPackedGlyphID(SkPackedGlyphID packedGlyphID,
+                                                     MetricsType type) {
+    SkGlyph** found = fGlyphMap.find(packedGlyphID);
+
+    if (nullptr == found) {
+        return this->allocateNewGlyph(packedGlyphID, type);
+    }
+    SkGlyph* glyph = *found;
+    if (type == kFull_MetricsType && glyph->isJustAdvance()) {
+        // Other threads may be reading the just-advance glyph without holding fLock, so it must
+        // not change. Publish a new glyph with full metrics in its place instead.
         glyph = this->allocateNewGlyph(packedGlyphID, type);
-    } else {
-        if (type == kFull_MetricsType && glyph->isJustAdvance()) {
-           fScalerContext->getMetrics(glyph);
-        }
     }
     return glyph;
 }
 
+void SkGlyphCache::generateMetrics(SkGlyph* glyph) {
+    fScalerContext->getMetrics(glyph);
+    if (fStoredStrike) {
+        fStoredStrike->addMetrics(*glyph);
+    }
+}
+
 SkGlyph* SkGlyphCache::allocateNewGlyph(SkPackedGlyphID packedGlyphID, MetricsType mtype) {
     fMemoryUsed += sizeof(SkGlyph);
 
-    SkGlyph* glyphPtr;
-    {
-        SkGlyph glyph;
-        glyph.initWithGlyphID(packedGlyphID);
-        glyphPtr = fGlyphMap.set(glyph);
-    }
-
-    if (kJustAdvance_MetricsType == mtype) {
-        fScalerContext->getAdvance(glyphPtr);
-    } else {
-        SkASSERT(kFull_MetricsType == mtype);
-        fScalerContext->getMetrics(glyphPtr);
+    SkGlyph* glyphPtr = fAlloc.make<SkGlyph>();
+    glyphPtr->initWithGlyphID(packedGlyphID);
+    // This replaces any just-advance glyph with the same ID, which stays in fAlloc for readers
+    // still holding on to it.
+    fGlyphMap.set(glyphPtr);
+
+    // The store only holds full metrics, which satisfy either request.
+    if (!fStoredStrike || !fStoredStrike->findMetrics(glyphPtr)) {
+        if (kJustAdvance_MetricsType == mtype) {
+            fScalerContext->getAdvance(glyphPtr);
+        } else {
+            SkASSERT(kFull_MetricsType == mtype);
+            this->generateMetrics(glyphPtr);
+        }
     }
 
     SkASSERT(glyphPtr->fID != SkPackedGlyphID());
     return glyphPtr;
 }
 
+// Record that the glyph's image was asked for. Many threads may do this at once for a glyph
+// under the shared lock, so only write when the value changes.
+static void mark_used(const SkGlyph& glyph, uint32_t useCount) {
+    if (sk_atomic_load(&glyph.fLastUse, sk_memory_order_relaxed) != useCount) {
+        sk_atomic_store(&const_cast<SkGlyph&>(glyph).fLastUse, useCount,
+                        sk_memory_order_relaxed);
+    }
+}
+
 const void* SkGlyphCache::findImage(const SkGlyph& glyph) {
     if (glyph.fWidth > 0 && glyph.fWidth < kMaxGlyphWidth) {
+        const uint32_t useCount = fUseCount.load(std::memory_order_relaxed);
+        {
+            SkAutoSharedMutexShared lock(fLock);
+            if (glyph.fImage) {
+                mark_used(glyph, useCount);
+                return glyph.fImage;
+            }
+        }
+        SkAutoExclusive lock(fLock);
         if (nullptr == glyph.fImage) {
-            size_t  size = const_cast<SkGlyph&>(glyph).allocImage(&fAlloc);
+            size_t  size = const_cast<SkGlyph&>(glyph).allocImage(fImageAlloc.get());
             // check that alloc() actually succeeded
             if (glyph.fImage) {
-                fScalerContext->getImage(glyph);
-                // TODO: the scaler may have changed the maskformat during
-                // getImage (e.g. from AA or LCD to BW) which means we may have
-                // overallocated the buffer. Check if the new computedImageSize
-                // is smaller, and if so, strink the alloc size in fImageAlloc.
+                if (!fStoredStrike || !fStoredStrike->findImage(glyph)) {
+                    fScalerContext->getImage(glyph);
+                    if (fStoredStrike) {
+                        fStoredStrike->addImage(glyph);
+                    }
+                }
+                // The scaler may have changed the mask format during getImage (e.g. from AA or
+                // LCD to BW), leaving the buffer larger than the image. The difference counts
+                // as fragmentation until the image store is compacted.
+                fImageBytesAllocated += size;
+                fImageBytesLive += glyph.computeImageSize();
                 fMemoryUsed += size;
             }
         }
+        mark_used(glyph, useCount);
     }
     return glyph.fImage;
 }
 
+void SkGlyphCache::trimImages(size_t bytesNeeded) {
+    SkAutoExclusive lock(fLock);
+    if (fImageBytesAllocated == 0) {
+        return;
+    }
+    const uint32_t useCount = fUseCount.load(std::memory_order_relaxed);
+
+    SkTDArray<SkGlyph*> cold;
+    fGlyphMap.foreach([&cold, useCount](SkGlyph** glyph) {
+        if ((*glyph)->fImage && useCount - (*glyph)->fLastUse >= kColdUseCount) {
+            *cold.append() = *glyph;
+        }
+    });
+    if (!cold.isEmpty()) {
+        // Oldest first; among glyphs last used together, the largest images go first.
+        SkTQSort(cold.begin(), cold.end() - 1, [useCount](const SkGlyph* a, const SkGlyph* b) {
+            uint32_t ageA = useCount - a->fLastUse,
+                     ageB = useCount - b->fLastUse;
+            return ageA != ageB ? ageA > ageB : a->fImageAllocSize > b->fImageAllocSize;
+        });
+    }
+
+    size_t evicted = 0;
+    for (SkGlyph* glyph : cold) {
+        if (evicted >= bytesNeeded) {
+            break;
+        }
+        evicted += glyph->fImageAllocSize;
+        fImageBytesLive -= glyph->computeImageSize();
+        glyph->fImage = nullptr;
+        glyph->fImageAllocSize = 0;
+    }
+
+    // Compacting copies every live image, so only do it once a good part of the store is waste.
+    // Compacted images are packed without padding, so a freshly compacted store isn't
+    // fragmented at all, and has to lose a quarter of itself again before it's recompacted.
+    size_t fragmented = fImageBytesAllocated - fImageBytesLive;
+    if (fragmented > 0 && fragmented >= fImageBytesAllocated / 4) {
+        this->compactImages();
+    }
+}
+
+void SkGlyphCache::compactImages() {
+    auto alloc = skstd::make_unique<SkArenaAlloc>(SkTMax(fImageBytesLive, kMinAllocAmount));
+    size_t allocated = 0;
+    fGlyphMap.foreach([&alloc, &allocated](SkGlyph** glyphPtr) {
+        SkGlyph* glyph = *glyphPtr;
+        if (const void* image = glyph->fImage) {
+            // The glyph's mask format is final now, so this allocates exactly its image size.
+            allocated += glyph->allocImage(alloc.get());
+            memcpy(glyph->fImage, image, glyph->computeImageSize());
+        }
+    });
+    fImageAlloc = std::move(alloc);
+    fMemoryUsed = fMemoryUsed - fImageBytesAllocated + allocated;
+    fImageBytesAllocated = allocated;
+}
+
 const SkPath* SkGlyphCache::findPath(const SkGlyph& glyph) {
     if (glyph.fWidth) {
+        {
+            SkAutoSharedMutexShared lock(fLock);
+            if (glyph.fPathData) {
+                return glyph.fPathData->fPath;
+            }
+        }
+        SkAutoExclusive lock(fLock);
         if (glyph.fPathData == nullptr) {
             SkGlyph::PathData* pathData = fAlloc.make<SkGlyph::PathData>();
             const_cast<SkGlyph&>(glyph).fPathData = pathData;
             pathData->fIntercept = nullptr;
             SkPath* path = pathData->fPath = new SkPath;
-            fScalerContext->getPath(glyph.getPackedID(), path);
+            if (!fStoredStrike || !fStoredStrike->findPath(glyph.getPackedID(), path)) {
+                fScalerContext->getPath(glyph.getPackedID(), path);
+                if (fStoredStrike) {
+                    fStoredStrike->addPath(glyph.getPackedID(), *path);
+                }
+            }
             fMemoryUsed += sizeof(SkPath) + path->countPoints() * sizeof(SkPoint);
         }
     }
@@ -312,6 +491,7 @@ const SkGlyph::Intercept* SkGlyphCache::MatchBounds(const SkGlyph* glyph,
 
 void SkGlyphCache::findIntercepts(const SkScalar bounds[2], SkScalar scale, SkScalar xPos,
         bool yAxis, SkGlyph* glyph, SkScalar* array, int* count) {
+    SkAutoExclusive lock(fLock);
     const SkGlyph::Intercept* match = MatchBounds(glyph, bounds);
 
     if (match) {
@@ -396,7 +576,7 @@ void SkGlyphCache::dump() const {
                matrix[SkMatrix::kMScaleX], matrix[SkMatrix::kMSkewX],
                matrix[SkMatrix::kMSkewY], matrix[SkMatrix::kMScaleY],
                rec.fLumBits & 0xFF, rec.fDeviceGamma, rec.fPaintGamma, rec.fContrast,
-               fGlyphMap.count());
+               this->countCachedGlyphs());
     SkDebugf("%s\n", msg.c_str());
 }
 
@@ -472,6 +652,16 @@ void SkGlyphCache_Globals::purgeAll() {
     this->internalPurge(fTotalMemoryUsed);
 }
 
+sk_sp<SkStrikeStore> SkGlyphCache_Globals::getStore() const {
+    SkAutoExclusive ac(fLock);
+    return fStore;
+}
+
+void SkGlyphCache_Globals::setStore(sk_sp<SkStrikeStore> store) {
+    SkAutoExclusive ac(fLock);
+    fStore = std::move(store);
+}
+
 /*  This guy calls the visitor from within the mutext lock, so the visitor
     cannot:
     - take too much time
@@ -506,15 +696,15 @@ SkGlyphCache* SkGlyphCache::VisitCache(SkTypeface* typeface,
 
         globals.validate();
 
-        for (cache = globals.internalGetHead(); cache != nullptr; cache = cache->fNext) {
-            if (*cache->fDesc == *desc) {
-                globals.internalDetachCache(cache);
-                if (!proc(cache, context)) {
-                    globals.internalAttachCacheToHead(cache);
-                    cache = nullptr;
-                }
-                return cache;
+        cache = globals.internalFind(*desc);
+        if (cache) {
+            globals.internalMoveToHead(cache);
+            if (!proc(cache, context)) {
+                return nullptr;
             }
+            cache->fPinCount += 1;
+            cache->fUseCount.fetch_add(1, std::memory_order_relaxed);
+            return cache;
         }
     }
 
@@ -532,21 +722,48 @@ SkGlyphCache* SkGlyphCache::VisitCache(SkTypeface* typeface,
         }
         cache = new SkGlyphCache(desc, std::move(ctx));
     }
+    if (sk_sp<SkStrikeStore> store = globals.getStore()) {
+        cache->fStoredStrike = store->findOrAddStrike(typeface, *desc);
+        if (cache->fStoredStrike) {
+            cache->fStore = std::move(store);
+        }
+    }
 
     AutoValidate av(cache);
 
-    if (!proc(cache, context)) {   // need to reattach
-        globals.attachCacheToHead(cache);
-        cache = nullptr;
+    SkGlyphCache* raced;
+    {
+        SkAutoExclusive ac(globals.fLock);
+
+        // Another thread may have added a strike for this descriptor while we built ours.
+        // Share theirs so there is only ever one strike per descriptor.
+        raced = globals.internalFind(*desc);
+        if (raced) {
+            globals.internalMoveToHead(raced);
+            std::swap(cache, raced);
+        } else {
+            globals.internalAttachCacheToHead(cache);
+        }
+
+        if (proc(cache, context)) {
+            cache->fPinCount += 1;
+            cache->fUseCount.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            cache = nullptr;
+        }
+        if (!raced) {
+            globals.internalPurge();
+        }
     }
+    av.forget();
+    delete raced;
     return cache;
 }
 
 void SkGlyphCache::AttachCache(SkGlyphCache* cache) {
     SkASSERT(cache);
-    SkASSERT(cache->fNext == nullptr);
 
-    get_globals().attachCacheToHead(cache);
+    get_globals().unpinCache(cache);
 }
 
 static void dump_visitor(const SkGlyphCache& cache, void* context) {
@@ -593,6 +810,10 @@ static void sk_trace_dump_visitor(const SkGlyphCache& cache, void* context) {
 
     dump->dumpNumericValue(dumpName.c_str(), "size", "bytes", cache.getMemoryUsed());
     dump->dumpNumericValue(dumpName.c_str(), "glyph_count", "objects", cache.countCachedGlyphs());
+    dump->dumpNumericValue(dumpName.c_str(), "image_live_size", "bytes",
+                           cache.getImageBytesLive());
+    dump->dumpNumericValue(dumpName.c_str(), "image_fragmented_size", "bytes",
+                           cache.getImageBytesFragmented());
     dump->setMemoryBacking(dumpName.c_str(), "malloc", nullptr);
 }
 
@@ -627,16 +848,51 @@ void SkGlyphCache::VisitAll(Visitor visitor, void* context) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void SkGlyphCache_Globals::attachCacheToHead(SkGlyphCache* cache) {
+void SkGlyphCache_Globals::unpinCache(SkGlyphCache* cache) {
     SkAutoExclusive ac(fLock);
 
     this->validate();
     cache->validate();
 
-    this->internalAttachCacheToHead(cache);
+    SkASSERT(cache->fPinCount > 0);
+    cache->fPinCount -= 1;
+
+    // Pick up whatever the strike grew by while it was in use.
+    this->internalAccountMemory(cache);
+
+    this->internalMoveToHead(cache);
     this->internalPurge();
 }
 
+void SkGlyphCache_Globals::internalAccountMemory(SkGlyphCache* cache) {
+    size_t memoryUsed = cache->getMemoryUsed();
+    fTotalMemoryUsed = fTotalMemoryUsed - cache->fMemoryAccounted + memoryUsed;
+    cache->fMemoryAccounted = memoryUsed;
+}
+
+SkGlyphCache* SkGlyphCache_Globals::internalFind(const SkDescriptor& desc) const {
+    for (SkGlyphCache* cache = fHead; cache != nullptr; cache = cache->fNext) {
+        if (*cache->fDesc == desc) {
+            return cache;
+        }
+    }
+    return nullptr;
+}
+
+void SkGlyphCache_Globals::internalMoveToHead(SkGlyphCache* cache) {
+    if (fHead == cache) {
+        return;
+    }
+    cache->fPrev->fNext = cache->fNext;
+    if (cache->fNext) {
+        cache->fNext->fPrev = cache->fPrev;
+    }
+    cache->fPrev = nullptr;
+    cache->fNext = fHead;
+    fHead->fPrev = cache;
+    fHead = cache;
+}
+
 SkGlyphCache* SkGlyphCache_Globals::internalGetTail() const {
     SkGlyphCache* cache = fHead;
     if (cache) {
@@ -675,17 +931,39 @@ size_t SkGlyphCache_Globals::internalPurge(size_t minBytesNeeded) {
     size_t  bytesFreed = 0;
     int     countFreed = 0;
 
+    // First evict cold glyph images from idle strikes, so that long-lived strikes give up the
+    // glyphs nobody draws any more rather than whole strikes being thrown away. Not worth it if
+    // everything is going anyway. Trimming scans every glyph of a strike under the global lock,
+    // so only the least recently used few strikes with images are trimmed per purge.
+    int trimmed = 0;
+    for (SkGlyphCache* cache = this->internalGetTail();
+         cache != nullptr && bytesFreed < bytesNeeded && bytesNeeded < fTotalMemoryUsed &&
+         trimmed < kMaxStrikesTrimmedPerPurge;
+         cache = cache->fPrev) {
+        if (cache->fPinCount == 0 && cache->fImageBytesAllocated > 0) {
+            trimmed += 1;
+            size_t before = cache->fMemoryAccounted;
+            cache->trimImages(bytesNeeded - bytesFreed);
+            this->internalAccountMemory(cache);
+            if (cache->fMemoryAccounted < before) {
+                bytesFreed += before - cache->fMemoryAccounted;
+            }
+        }
+    }
+
     // we start at the tail and proceed backwards, as the linklist is in LRU
-    // order, with unimportant entries at the tail.
+    // order, with unimportant entries at the tail. Strikes that are in use are skipped.
     SkGlyphCache* cache = this->internalGetTail();
     while (cache != nullptr &&
            (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
         SkGlyphCache* prev = cache->fPrev;
-        bytesFreed += cache->fMemoryUsed;
-        countFreed += 1;
+        if (cache->fPinCount == 0) {
+            bytesFreed += cache->fMemoryAccounted;
+            countFreed += 1;
 
-        this->internalDetachCache(cache);
-        delete cache;
+            this->internalDetachCache(cache);
+            delete cache;
+        }
         cache = prev;
     }
 
@@ -710,13 +988,14 @@ void SkGlyphCache_Globals::internalAttachCacheToHead(SkGlyphCache* cache) {
     fHead = cache;
 
     fCacheCount += 1;
-    fTotalMemoryUsed += cache->fMemoryUsed;
+    cache->fMemoryAccounted = cache->getMemoryUsed();
+    fTotalMemoryUsed += cache->fMemoryAccounted;
 }
 
 void SkGlyphCache_Globals::internalDetachCache(SkGlyphCache* cache) {
     SkASSERT(fCacheCount > 0);
     fCacheCount -= 1;
-    fTotalMemoryUsed -= cache->fMemoryUsed;
+    fTotalMemoryUsed -= cache->fMemoryAccounted;
 
     if (cache->fPrev) {
         cache->fPrev->fNext = cache->fNext;
@@ -752,7 +1031,7 @@ void SkGlyphCache_Globals::validate() const {
 
     const SkGlyphCache* head = fHead;
     while (head != nullptr) {
-        computedBytes += head->fMemoryUsed;
+        computedBytes += head->fMemoryAccounted;
         computedCount += 1;
         head = head->fNext;
     }
@@ -802,6 +1081,15 @@ int SkGraphics::SetFontCachePointSizeLimit(int limit) {
     return get_globals().setCachePointSizeLimit(limit);
 }
 
+void SkGraphics::SetFontCacheStore(const char path[], size_t maxBytes) {
+    get_globals().setStore(path ? SkStrikeStore::Make(path, maxBytes) : nullptr);
+}
+
+bool SkGraphics::FlushFontCacheStore() {
+    sk_sp<SkStrikeStore> store = get_globals().getStore();
+    return store && store->flush();
+}
+
 void SkGraphics::PurgeFontCache() {
     get_globals().purgeAll();
     SkTypefaceCache::PurgeAll();
@@ -14,8 +14,11 @@
 #include "SkPaint.h"
 #include "SkTHash.h"
 #include "SkScalerContext.h"
+#include "SkSharedMutex.h"
+#include "SkStrikeStore.h"
 #include "SkTemplates.h"
 #include "SkTDArray.h"
+#include <atomic>
 #include <memory>
 
 class SkTraceMemoryDump;
@@ -30,7 +33,10 @@ class SkGlyphCache_Globals;
     it and then adding it to the strike.
 
     The strikes are held in a global list, available to all threads. To interact with one, call
-    either VisitCache() or DetachCache().
+    either VisitCache() or DetachCache(). A strike may be used by several threads at once: glyph
+    lookups that hit take a shared lock on the strike, and only generating a new glyph, image or
+    path takes it exclusively. Glyphs never move once created, so returned references stay valid
+    for as long as the strike is held.
 */
 class SkGlyphCache {
 public:
@@ -106,32 +112,38 @@ public:
     }
 
     /** Return the approx RAM usage for this cache. */
-    size_t getMemoryUsed() const { return fMemoryUsed; }
+    size_t getMemoryUsed() const { return fMemoryUsed.load(std::memory_order_relaxed); }
+
+    /** Return the bytes of glyph images in use, and the bytes the image store holds beyond that
+        (evicted images, and images that came out smaller than allocated). The latter are
+        released when the store is compacted.
+    */
+    size_t getImageBytesLive() const;
+    size_t getImageBytesFragmented() const;
 
     void dump() const;
 
     SkScalerContext* getScalerContext() const { return fScalerContext.get(); }
 
     /** Find a matching cache entry, and call proc() with it. If none is found create a new one.
-        If the proc() returns true, detach the cache and return it, otherwise leave it and return
-        nullptr.
+        If the proc() returns true, pin the cache (so it cannot be purged) and return it, otherwise
+        leave it and return nullptr.
     */
     static SkGlyphCache* VisitCache(SkTypeface*, const SkScalerContextEffects&, const SkDescriptor*,
                                     bool (*proc)(const SkGlyphCache*, void*),
                                     void* context);
 
-    /** Given a strike that was returned by either VisitCache() or DetachCache() add it back into
-        the global cache list (after which the caller should not reference it anymore.
+    /** Given a strike that was returned by either VisitCache() or DetachCache() unpin it, making
+        it purgeable again (after which the caller should not reference it anymore).
     */
     static void AttachCache(SkGlyphCache*);
     using AttachCacheFunctor = SkFunctionWrapper<void, SkGlyphCache, AttachCache>;
 
-    /** Detach a strike from the global cache matching the specified descriptor. Once detached,
-        it can be queried/modified by the current thread, and when finished, be reattached to the
-        global cache with AttachCache(). While detached, if another request is made with the same
-        descriptor, a different strike will be generated. This is fine. It does mean we can have
-        more than 1 strike for the same descriptor, but that will eventually get purged, and the
-        win is that different thread will never block each other while a strike is being used.
+    /** Return the strike from the global cache matching the specified descriptor, creating it
+        if needed. The strike stays in the global list but is pinned, so it will not be purged
+        until it is handed back with AttachCache(). Other threads asking for the same descriptor
+        get the same strike and may use it concurrently; each of them must call AttachCache()
+        once when done.
     */
     static SkGlyphCache* DetachCache(SkTypeface* typeface, const SkScalerContextEffects& effects,
                                      const SkDescriptor* desc) {
@@ -175,6 +187,7 @@ public:
 
 private:
     friend class SkGlyphCache_Globals;
+    friend class GlyphCacheTestingAccess;
 
     enum MetricsType {
         kJustAdvance_MetricsType,
@@ -195,20 +208,46 @@ private:
     SkGlyphCache(const SkDescriptor*, std::unique_ptr<SkScalerContext>);
     ~SkGlyphCache();
 
+    struct GlyphHashTraits {
+        static SkPackedGlyphID GetKey(const SkGlyph* glyph) { return glyph->getPackedID(); }
+        static uint32_t Hash(SkPackedGlyphID glyphId) { return glyphId.hash(); }
+    };
+
     // Return the SkGlyph* associated with MakeID. The id parameter is the
     // combined glyph/x/y id generated by MakeID. If it is just a glyph id
     // then x and y are assumed to be zero.
     SkGlyph* lookupByPackedGlyphID(SkPackedGlyphID packedGlyphID, MetricsType type);
 
+    // Return the glyph if it is already cached with at least the metrics asked for by type,
+    // otherwise nullptr. Requires fLock to be held, shared or exclusive.
+    SkGlyph* findExistingGlyph(SkPackedGlyphID packedGlyphID, MetricsType type) const;
+
+    // As lookupByPackedGlyphID, but requires fLock to be held exclusively.
+    SkGlyph* internalLookupByPackedGlyphID(SkPackedGlyphID packedGlyphID, MetricsType type);
+
     // Return a SkGlyph* associated with unicode id and position x and y.
     SkGlyph* lookupByChar(SkUnichar id, MetricsType type, SkFixed x = 0, SkFixed y = 0);
 
-    // Return a new SkGlyph for the glyph ID and subpixel position id. Limit the amount
-    // of work using type.
+    // Return a new SkGlyph for the glyph ID and subpixel position id, replacing any glyph
+    // already in the map for it. Limit the amount of work using type.
     SkGlyph* allocateNewGlyph(SkPackedGlyphID packedGlyphID, MetricsType type);
 
+    // Ask the scaler context for the glyph's full metrics, and record them in the store.
+    void generateMetrics(SkGlyph*);
+
     static bool DetachProc(const SkGlyphCache*, void*) { return true; }
 
+    // Images not asked for in this many uses of the strike may be evicted.
+    static constexpr uint32_t kColdUseCount = 32;
+
+    // Drop cold glyph images, least recently used first, until at least bytesNeeded are evicted
+    // or none are left, then compact the image store if it is fragmented enough. Only call
+    // while the strike is unpinned, so no one can be holding on to the images.
+    void trimImages(size_t bytesNeeded);
+
+    // Copy the live images into a new arena and free the old one.
+    void compactImages();
+
     // The id arg is a combined id generated by MakeID.
     CharGlyphRec* getCharGlyphRec(SkPackedUnicharID id);
 
@@ -232,8 +271,15 @@ private:
     const std::unique_ptr<SkScalerContext> fScalerContext;
     SkPaint::FontMetrics   fFontMetrics;
 
-    // Map from a combined GlyphID and sub-pixel position to a SkGlyph.
-    SkTHashTable<SkGlyph, SkPackedGlyphID, SkGlyph::HashTraits> fGlyphMap;
+    // Guards the glyph map, the char map, fAlloc, the image store and the lazily generated parts
+    // of each glyph.
+    mutable SkSharedMutex  fLock;
+
+    // Map from a combined GlyphID and sub-pixel position to a SkGlyph. The glyphs themselves
+    // live in fAlloc so that growing the table does not move them. A glyph's metrics never
+    // change once it is in the map, since callers read them without holding fLock; asking for
+    // full metrics of a just-advance glyph replaces it with a new glyph.
+    SkTHashTable<SkGlyph*, SkPackedGlyphID, GlyphHashTraits> fGlyphMap;
 
     // so we don't grow our arrays a lot
     static constexpr size_t kMinGlyphCount = 8;
@@ -242,10 +288,28 @@ private:
 
     SkArenaAlloc            fAlloc {kMinAllocAmount};
 
+    // Glyph images live in their own arena, so that it can be compacted after eviction.
+    std::unique_ptr<SkArenaAlloc> fImageAlloc;
+    size_t                  fImageBytesAllocated;
+    size_t                  fImageBytesLive;
+
     std::unique_ptr<CharGlyphRec[]> fPackedUnicharIDToPackedGlyphID;
 
     // used to track (approx) how much ram is tied-up in this cache
-    size_t                  fMemoryUsed;
+    std::atomic<size_t>     fMemoryUsed;
+
+    // Where to look for glyphs before asking fScalerContext, and to record the ones it makes.
+    // Null unless SkGraphics::SetFontCacheStore() was in effect when the strike was created.
+    sk_sp<SkStrikeStore>    fStore;
+    SkStrikeStore::Strike*  fStoredStrike;
+
+    // The following are only touched while holding the SkGlyphCache_Globals lock.
+    // How much of fMemoryUsed has been added to the global total.
+    size_t                  fMemoryAccounted;
+    // Number of outstanding DetachCache()/VisitCache() handles. Pinned strikes are not purged.
+    int                     fPinCount;
+    // Number of times the strike has been pinned; the clock for SkGlyph::fLastUse.
+    std::atomic<uint32_t>   fUseCount;
 };
 
 class SkAutoGlyphCache : public std::unique_ptr<SkGlyphCache, SkGlyphCache::AttachCacheFunctor> {
@@ -11,6 +11,7 @@
 #include "SkGlyphCache.h"
 #include "SkMutex.h"
 #include "SkSpinlock.h"
+#include "SkStrikeStore.h"
 #include "SkTLS.h"
 
 #ifndef SK_DEFAULT_FONT_CACHE_COUNT_LIMIT
@@ -72,25 +73,36 @@ public:
 
     void purgeAll(); // does not change budget
 
-    // call when a glyphcache is available for caching (i.e. not in use)
-    void attachCacheToHead(SkGlyphCache*);
+    sk_sp<SkStrikeStore> getStore() const;
+    void setStore(sk_sp<SkStrikeStore>);
+
+    // call when a user of a glyphcache returned by VisitCache() is done with it
+    void unpinCache(SkGlyphCache*);
 
     // can only be called when the mutex is already held
+    SkGlyphCache* internalFind(const SkDescriptor&) const;
     void internalDetachCache(SkGlyphCache*);
     void internalAttachCacheToHead(SkGlyphCache*);
+    void internalMoveToHead(SkGlyphCache*);
+    // Bring the totals up to date with the strike's current memory use.
+    void internalAccountMemory(SkGlyphCache*);
+
+    // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
+    // and attempt to purge caches to match.
+    // Returns number of bytes freed.
+    size_t internalPurge(size_t minBytesNeeded = 0);
 
 private:
+    // Bounds the glyphs internalPurge() scans for cold images, see SkGlyphCache::trimImages().
+    static constexpr int kMaxStrikesTrimmedPerPurge = 8;
+
     SkGlyphCache* fHead;
     size_t  fTotalMemoryUsed;
     size_t  fCacheSizeLimit;
     int32_t fCacheCountLimit;
     int32_t fCacheCount;
     int32_t fPointSizeLimit;
-
-    // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
-    // and attempt to purge caches to match.
-    // Returns number of bytes freed.
-    size_t internalPurge(size_t minBytesNeeded = 0);
+    sk_sp<SkStrikeStore> fStore;
 };
 
 #endif
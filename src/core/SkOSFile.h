@@ -65,6 +65,10 @@ bool    sk_exists(const char *path, SkFILE_Flags = (SkFILE_Flags)0);
 // Returns true if a directory exists at this path.
 bool    sk_isdir(const char *path);
 
+// Gets the size and last modification time (in seconds) of the file at this path.
+// Returns false if there is no such file.
+bool    sk_stat(const char* path, uint64_t* size, int64_t* modTime);
+
 // Like pread, but may affect the file position marker.
 // Returns the number of bytes read or SIZE_MAX if failed.
 size_t sk_qread(FILE*, void* buffer, size_t count, size_t offset);
@@ -75,6 +79,12 @@ size_t sk_qread(FILE*, void* buffer, size_t count, size_t offset);
 // Description of the error, if any, will be written to stderr.
 bool    sk_mkdir(const char* path);
 
+// Move the file at from to to, replacing any file already there; returns true if successful.
+bool    sk_rename(const char* from, const char* to);
+
+// Delete the file at path; returns true if successful.
+bool    sk_remove(const char* path);
+
 class SkOSFile {
 public:
     class Iter {
@@ -43,7 +43,18 @@ namespace SkOpts {
                         grayA_to_RGBA,         // i.e. expand to color channels
                         grayA_to_rgbA,         // i.e. expand to color channels and premultiply
                         inverted_CMYK_to_RGB1, // i.e. convert color space
-                        inverted_CMYK_to_BGR1; // i.e. convert color space
+                        inverted_CMYK_to_BGR1, // i.e. convert color space
+                        RGB16_to_RGB1,         // i.e. strip to 8-bit + an opaque alpha
+                        RGB16_to_BGR1,         // i.e. strip to 8-bit, swap RB + an opaque alpha
+                        RGBA16_to_RGBA,        // i.e. strip to 8-bit
+                        RGBA16_to_BGRA,        // i.e. strip to 8-bit and swap RB
+                        RGBA16_to_rgbA,        // i.e. strip to 8-bit and premultiply
+                        RGBA16_to_bgrA;        // i.e. strip to 8-bit, swap RB and premultiply
+
+    // Cumulates a row of SkCoverageDeltaMask deltas into coverages and converts them to alphas.
+    // count must be a multiple of SkCoverageDeltaMask::SIMD_WIDTH.
+    extern void (*coverage_deltas_to_alphas)(uint8_t[], const int32_t[], int,
+                                             bool isEvenOdd, bool isInverse, bool isConvex);
 
     extern void (*memset16)(uint16_t[], uint16_t, int);
     extern void SK_API (*memset32)(uint32_t[], uint32_t, int);
@@ -6,6 +6,9 @@
  */
 
 #include "SkAtomics.h"
+#include "SkBigPicture.h"
+#include "SkCanvas.h"
+#include "SkExecutor.h"
 #include "SkImageGenerator.h"
 #include "SkMathPriv.h"
 #include "SkPicture.h"
@@ -14,7 +17,11 @@
 #include "SkPicturePlayback.h"
 #include "SkPictureRecord.h"
 #include "SkPictureRecorder.h"
+#include "SkRecord.h"
+#include "SkRecordDraw.h"
+#include "SkRTree.h"
 #include "SkSerialProcs.h"
+#include "SkTaskGroup.h"
 
 #if defined(SK_DISALLOW_CROSSPROCESS_PICTUREIMAGEFILTERS)
 static bool g_AllPictureIOSecurityPrecautionsEnabled = true;
@@ -54,6 +61,54 @@ uint32_t SkPicture::uniqueID() const {
     return id;
 }
 
+void SkPicture::playbackParallel(
+        const std::function<std::unique_ptr<SkCanvas>(const SkIRect&)>& makeTileCanvas,
+        const SkISize& tileSize, SkExecutor* executor) const {
+    const SkIRect bounds = this->cullRect().roundOut();
+    if (bounds.isEmpty() || tileSize.isEmpty()) {
+        return;
+    }
+
+    // Every tile queries a BBH to find the ops it needs, so build a throwaway one for big
+    // pictures recorded without one.  Control ops (save, clip, concat...) are bounded by the
+    // draws they affect, so each tile still sees the matrix and clip state of its draws.
+    const SkBigPicture* big = this->asSkBigPicture();
+    sk_sp<const SkBBoxHierarchy> bbh;
+    if (big) {
+        bbh = sk_ref_sp(big->bbh());
+        if (!bbh) {
+            const SkRecord& record = *big->record();
+            SkAutoTMalloc<SkRect> opBounds(record.count());
+            SkRecordFillBounds(this->cullRect(), record, opBounds.get());
+            sk_sp<SkRTree> rtree = sk_make_sp<SkRTree>();
+            rtree->insert(opBounds.get(), record.count());
+            bbh = std::move(rtree);
+        }
+    }
+
+    SkTaskGroup tg(executor ? *executor : SkExecutor::GetDefault());
+    for (int y = bounds.top(); y < bounds.bottom(); y += tileSize.height()) {
+        for (int x = bounds.left(); x < bounds.right(); x += tileSize.width()) {
+            SkIRect tile = SkIRect::MakeXYWH(x, y, tileSize.width(), tileSize.height());
+            SkAssertResult(tile.intersect(bounds));
+            tg.add([=, &makeTileCanvas] {
+                std::unique_ptr<SkCanvas> canvas = makeTileCanvas(tile);
+                if (!canvas) {
+                    return;
+                }
+                canvas->clipRect(SkRect::MakeIWH(tile.width(), tile.height()));
+                canvas->translate(-SkIntToScalar(tile.x()), -SkIntToScalar(tile.y()));
+                if (big) {
+                    big->playback(canvas.get(), bbh.get());
+                } else {
+                    this->playback(canvas.get());
+                }
+            });
+        }
+    }
+    tg.wait();
+}
+
 static const char kMagic[] = { 's', 'k', 'i', 'a', 'p', 'i', 'c', 't' };
 
 SkPictInfo SkPicture::createHeader() const {
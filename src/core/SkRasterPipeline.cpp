@@ -53,20 +53,30 @@ void SkRasterPipeline::extend(const SkRasterPipeline& src) {
 }
 
 void SkRasterPipeline::dump() const {
-    SkDebugf("SkRasterPipeline, %d stages\n", fNumStages);
-    std::vector<const char*> stages;
+    std::vector<StockStage> stages;
     for (auto st = fStages; st; st = st->prev) {
+        stages.push_back(st->stage);
+    }
+    std::reverse(stages.begin(), stages.end());
+
+    int missing = 0;
+    for (StockStage stage : stages) {
+        missing += lowp_supports(stage) ? 0 : 1;
+    }
+    SkDebugf("SkRasterPipeline, %d stages, %s\n",
+             fNumStages, missing ? "highp" : "lowp");
+
+    for (StockStage stage : stages) {
         const char* name = "";
-        switch (st->stage) {
+        switch (stage) {
         #define M(x) case x: name = #x; break;
             SK_RASTER_PIPELINE_STAGES(M)
         #undef M
         }
-        stages.push_back(name);
+        SkDebugf("\t%s%s\n", name, lowp_supports(stage) ? "" : "\t(no lowp)");
     }
-    std::reverse(stages.begin(), stages.end());
-    for (const char* name : stages) {
-        SkDebugf("\t%s\n", name);
+    if (missing) {
+        SkDebugf("%d of %d stages have no lowp version\n", missing, fNumStages);
     }
     SkDebugf("\n");
 }
@@ -168,6 +178,8 @@ void SkRasterPipeline::append_seed_shader() {
     static const float iota[] = {
         0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f,
         8.5f, 9.5f,10.5f,11.5f,12.5f,13.5f,14.5f,15.5f,
+       16.5f,17.5f,18.5f,19.5f,20.5f,21.5f,22.5f,23.5f,
+       24.5f,25.5f,26.5f,27.5f,28.5f,29.5f,30.5f,31.5f,
     };
     this->unchecked_append(SkRasterPipeline::seed_shader, const_cast<float*>(iota));
 }
@@ -124,6 +124,8 @@ public:
     // Allocates a thunk which amortizes run() setup cost in alloc.
     std::function<void(size_t, size_t, size_t, size_t)> compile() const;
 
+    // Logs each stage, marking those the lowp engine can't run (which force the whole
+    // pipeline onto the float engine).
     void dump() const;
 
     // Appends a stage for the specified matrix.
@@ -154,6 +156,9 @@ private:
     };
 
     const SkJumper_Engine& build_pipeline(void**) const;
+
+    // Can the 8-bit lowp engine chosen for this CPU run this stage?  (Used by dump().)
+    static bool lowp_supports(StockStage);
     void unchecked_append(StockStage, void*);
 
     SkArenaAlloc* fAlloc;
@@ -23,10 +23,12 @@
 class SkRasterPipelineBlitter final : public SkBlitter {
 public:
     // This is our common entrypoint for creating the blitter once we've sorted out shaders.
+    // If we already know shaderPipeline just produces one color, pass it as solidColor.
     static SkBlitter* Create(const SkPixmap&, const SkPaint&, SkArenaAlloc*,
                              const SkRasterPipeline& shaderPipeline,
                              SkShaderBase::Context*,
-                             bool is_opaque, bool is_constant);
+                             bool is_opaque, bool is_constant,
+                             const SkPM4f* solidColor = nullptr);
 
     SkRasterPipelineBlitter(SkPixmap dst,
                             SkBlendMode blend,
@@ -54,6 +56,9 @@ private:
     // If we have an burst context, use it to fill our shader buffer.
     void burst_shade(int x, int y, int w);
 
+    // Blit the first w values of fCoverageRow as a one-row A8 mask at (x,y).
+    void blit_coverage_row(int x, int y, int w);
+
     SkPixmap               fDst;
     SkBlendMode            fBlend;
     SkArenaAlloc*          fAlloc;
@@ -70,16 +75,15 @@ private:
 
     // Built lazily on first use.
     std::function<void(size_t, size_t, size_t, size_t)> fBlitRect,
-                                                        fBlitAntiH,
                                                         fBlitMaskA8,
                                                         fBlitMaskLCD16;
 
     // These values are pointed to by the blit pipelines above,
     // which allows us to adjust them from call to call.
-    float fCurrentCoverage = 0.0f;
     float fDitherRate      = 0.0f;
 
-    std::vector<SkPM4f> fShaderBuffer;
+    std::vector<SkPM4f>  fShaderBuffer;
+    std::vector<uint8_t> fCoverageRow;   // blitAntiH() expands its runs into this.
 
     typedef SkBlitter INHERITED;
 };
@@ -100,7 +104,7 @@ SkBlitter* SkCreateRasterPipelineBlitter(const SkPixmap& dst,
              is_constant  = true;
         return SkRasterPipelineBlitter::Create(dst, paint, alloc,
                                                shaderPipeline, nullptr,
-                                               is_opaque, is_constant);
+                                               is_opaque, is_constant, &paintColor);
     }
 
     bool is_opaque    = shader->isOpaque() && paintColor.a() == 1.0f;
@@ -144,7 +148,8 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
                                            const SkRasterPipeline& shaderPipeline,
                                            SkShaderBase::Context* burstCtx,
                                            bool is_opaque,
-                                           bool is_constant) {
+                                           bool is_constant,
+                                           const SkPM4f* solidColor) {
     auto blitter = alloc->make<SkRasterPipelineBlitter>(dst,
                                                         paint.getBlendMode(),
                                                         alloc,
@@ -190,11 +195,17 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
     // A pipeline that's still constant here can collapse back into a constant color.
     if (is_constant) {
         SkPM4f constantColor;
-        SkJumper_MemoryCtx constantColorPtr = { &constantColor, 0 };
-        colorPipeline->append(SkRasterPipeline::store_f32, &constantColorPtr);
-        colorPipeline->run(0,0,1,1);
-        colorPipeline->reset();
-        colorPipeline->append_constant_color(alloc, constantColor);
+        if (solidColor && !paint.getColorFilter()) {
+            // colorPipeline is still just solidColor, so there's no need to run it to find that.
+            // Plain solid-color draws are common enough that this setup cost adds up.
+            constantColor = *solidColor;
+        } else {
+            SkJumper_MemoryCtx constantColorPtr = { &constantColor, 0 };
+            colorPipeline->append(SkRasterPipeline::store_f32, &constantColorPtr);
+            colorPipeline->run(0,0,1,1);
+            colorPipeline->reset();
+            colorPipeline->append_constant_color(alloc, constantColor);
+        }
 
         is_opaque = constantColor.a() == 1.0f;
     }
@@ -333,39 +344,55 @@ void SkRasterPipelineBlitter::blitRect(int x, int y, int w, int h) {
     }
 }
 
-void SkRasterPipelineBlitter::blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) {
-    if (!fBlitAntiH) {
-        SkRasterPipeline p(fAlloc);
-        p.extend(fColorPipeline);
-        if (SkBlendMode_ShouldPreScaleCoverage(fBlend, /*rgb_coverage=*/false)) {
-            p.append(SkRasterPipeline::scale_1_float, &fCurrentCoverage);
-            this->append_load_dst(&p);
-            SkBlendMode_AppendStages(fBlend, &p);
-        } else {
-            this->append_load_dst(&p);
-            SkBlendMode_AppendStages(fBlend, &p);
-            p.append(SkRasterPipeline::lerp_1_float, &fCurrentCoverage);
-        }
-
-        this->append_store(&p);
-        fBlitAntiH = p.compile();
-    }
+// Opaque runs at least this long are blitted with blitH() (often a memset) rather than through
+// the coverage row. Shorter ones are cheaper to leave in the row than to split it around.
+static constexpr int kMinOpaqueRunToSplit = 16;
 
+void SkRasterPipelineBlitter::blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) {
+    // Antialiased edges come as many short runs, and running a pipeline per run pays its setup
+    // (and a burst_shade()) per pixel. Instead, expand each span of partial coverage into
+    // fCoverageRow and blit it in one pass with the A8 mask pipeline. Zero runs end a span.
+    int spanX = x,
+        spanW = 0;
     for (int16_t run = *runs; run > 0; run = *runs) {
-        switch (*aa) {
-            case 0x00:                       break;
-            case 0xff: this->blitH(x,y,run); break;
-            default:
-                fCurrentCoverage = *aa * (1/255.0f);
-                if (fBurstCtx) {
-                    this->burst_shade(x,y,run);
-                }
-                fBlitAntiH(x,y,run,1);
+        bool opaque = *aa == 0xff && run >= kMinOpaqueRunToSplit;
+        if (*aa == 0x00 || opaque) {
+            if (spanW > 0) {
+                this->blit_coverage_row(spanX,y,spanW);
+                spanW = 0;
+            }
+            if (opaque) {
+                this->blitH(x,y,run);
+            }
+        } else {
+            if (spanW == 0) {
+                spanX = x;
+            }
+            if (spanW + run > SkToInt(fCoverageRow.size())) {
+                fCoverageRow.resize(spanW + run);
+            }
+            memset(fCoverageRow.data() + spanW, *aa, run);
+            spanW += run;
         }
         x    += run;
         runs += run;
         aa   += run;
     }
+    if (spanW > 0) {
+        this->blit_coverage_row(spanX,y,spanW);
+    }
+}
+
+void SkRasterPipelineBlitter::blit_coverage_row(int x, int y, int w) {
+    SkIRect clip = {x,y, x+w,y+1};
+
+    SkMask mask;
+    mask.fImage    = fCoverageRow.data();
+    mask.fBounds   = clip;
+    mask.fRowBytes = w;
+    mask.fFormat   = SkMask::kA8_Format;
+
+    this->blitMask(mask, clip);
 }
 
 void SkRasterPipelineBlitter::blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) {
@@ -9,10 +9,12 @@
 #include "SkMessageBus.h"
 #include "SkMipMap.h"
 #include "SkMutex.h"
+#include "SkOnce.h"
 #include "SkOpts.h"
 #include "SkResourceCache.h"
 #include "SkTraceMemoryDump.h"
 
+#include <atomic>
 #include <stddef.h>
 #include <stdlib.h>
 
@@ -201,6 +203,14 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
         byteLimit = fTotalByteLimit;
     }
 
+    this->purge(byteLimit, countLimit, forcePurge);
+}
+
+void SkResourceCache::purgeToBytes(size_t bytes) {
+    this->purge(bytes, SK_MaxS32, false);
+}
+
+void SkResourceCache::purge(size_t byteLimit, int countLimit, bool forcePurge) {
     Rec* rec = fTail;
     while (rec) {
         if (!forcePurge && fTotalBytesUsed < byteLimit && fCount < countLimit) {
@@ -440,85 +450,217 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-SK_DECLARE_STATIC_MUTEX(gMutex);
-static SkResourceCache* gResourceCache = nullptr;
+SkShardedResourceCache::SkShardedResourceCache(SkResourceCache::DiscardableFactory factory)
+    : fTotalByteLimit(0)
+    , fDiscardableFactory(factory) {
+    for (Shard& shard : fShards) {
+        shard.fCache = new SkResourceCache(factory);
+        shard.fBytesUsed = 0;
+    }
+}
+
+SkShardedResourceCache::SkShardedResourceCache(size_t byteLimit)
+    : fTotalByteLimit(byteLimit)
+    , fDiscardableFactory(nullptr) {
+    for (Shard& shard : fShards) {
+        // Every shard may use up to the whole limit on its own, so big Recs still fit.
+        shard.fCache = new SkResourceCache(byteLimit);
+        shard.fBytesUsed = 0;
+    }
+}
+
+SkShardedResourceCache::~SkShardedResourceCache() {
+    for (Shard& shard : fShards) {
+        delete shard.fCache;
+    }
+}
+
+// SkTHashTable indexes with the low bits of the hash, so pick the shard with the high ones.
+SkShardedResourceCache::Shard& SkShardedResourceCache::shardFor(uint32_t hash) {
+    return fShards[(hash >> 24) % kShardCount];
+}
+
+size_t SkShardedResourceCache::sumBytesUsed() const {
+    size_t used = 0;
+    for (const Shard& shard : fShards) {
+        used += shard.fBytesUsed.load(std::memory_order_relaxed);
+    }
+    return used;
+}
+
+// Purge the shards until together they're within fTotalByteLimit. The other shards go first, each
+// down to no less than its fair share of the limit, so the shard that just grew (and likely holds
+// the most recently used Recs) is purged last. Only one shard is locked at a time.
+void SkShardedResourceCache::purgeShards(int grownShard) {
+    size_t limit = fTotalByteLimit.load(std::memory_order_relaxed);
+    if (fDiscardableFactory || 0 == limit) {
+        return;  // discardable memory has no byte limit
+    }
+
+    for (size_t floor : { limit / kShardCount, (size_t)0 }) {
+        for (int i = 1; i <= kShardCount; ++i) {
+            size_t used = this->sumBytesUsed();
+            if (used <= limit) {
+                return;
+            }
+
+            Shard& shard = fShards[(grownShard + i) % kShardCount];
+            SkAutoMutexAcquire am(shard.fMutex);
+            size_t shardUsed = shard.fCache->getTotalBytesUsed(),
+                   excess    = used - limit;
+            if (shardUsed > floor) {
+                shard.fCache->purgeToBytes(SkTMax(floor, shardUsed - SkTMin(shardUsed, excess)));
+                shard.updateBytesUsed();
+            }
+        }
+    }
+}
+
+template <typename Fn>
+void SkShardedResourceCache::forEachShard(Fn&& fn) const {
+    for (const Shard& shard : fShards) {
+        SkAutoMutexAcquire am(shard.fMutex);
+        fn(shard.fCache);
+        shard.updateBytesUsed();
+    }
+}
+
+bool SkShardedResourceCache::find(const SkResourceCache::Key& key,
+                                  SkResourceCache::FindVisitor visitor, void* context) {
+    Shard& shard = this->shardFor(key.hash());
+    SkAutoMutexAcquire am(shard.fMutex);
+    bool found = shard.fCache->find(key, visitor, context);
+    shard.updateBytesUsed();
+    return found;
+}
 
-/** Must hold gMutex when calling. */
-static SkResourceCache* get_cache() {
-    // gMutex is always held when this is called, so we don't need to be fancy in here.
-    gMutex.assertHeld();
-    if (nullptr == gResourceCache) {
+void SkShardedResourceCache::add(SkResourceCache::Rec* rec, void* payload) {
+    Shard& shard = this->shardFor(rec->getHash());
+    {
+        SkAutoMutexAcquire am(shard.fMutex);
+        shard.fCache->add(rec, payload);
+        shard.updateBytesUsed();
+    }
+    this->purgeShards(SkToInt(&shard - fShards));
+}
+
+void SkShardedResourceCache::visitAll(SkResourceCache::Visitor visitor, void* context) {
+    this->forEachShard([&](SkResourceCache* cache) { cache->visitAll(visitor, context); });
+}
+
+size_t SkShardedResourceCache::getTotalBytesUsed() const {
+    size_t used = 0;
+    this->forEachShard([&](SkResourceCache* cache) { used += cache->getTotalBytesUsed(); });
+    return used;
+}
+
+size_t SkShardedResourceCache::getTotalByteLimit() const {
+    return fTotalByteLimit.load(std::memory_order_relaxed);
+}
+
+size_t SkShardedResourceCache::setTotalByteLimit(size_t newLimit) {
+    size_t prevLimit = fTotalByteLimit.exchange(newLimit);
+    this->forEachShard([&](SkResourceCache* cache) { cache->setTotalByteLimit(newLimit); });
+    this->purgeShards(0);
+    return prevLimit;
+}
+
+size_t SkShardedResourceCache::setSingleAllocationByteLimit(size_t size) {
+    size_t prevLimit = 0;
+    this->forEachShard([&](SkResourceCache* cache) {
+        prevLimit = cache->setSingleAllocationByteLimit(size);
+    });
+    return prevLimit;
+}
+
+size_t SkShardedResourceCache::getSingleAllocationByteLimit() const {
+    SkAutoMutexAcquire am(fShards[0].fMutex);
+    return fShards[0].fCache->getSingleAllocationByteLimit();
+}
+
+size_t SkShardedResourceCache::getEffectiveSingleAllocationByteLimit() const {
+    SkAutoMutexAcquire am(fShards[0].fMutex);
+    return fShards[0].fCache->getEffectiveSingleAllocationByteLimit();
+}
+
+void SkShardedResourceCache::purgeAll() {
+    this->forEachShard([](SkResourceCache* cache) { cache->purgeAll(); });
+}
+
+void SkShardedResourceCache::dump() const {
+    this->forEachShard([](SkResourceCache* cache) { cache->dump(); });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static SkShardedResourceCache* get_cache() {
+    static SkOnce once;
+    static SkShardedResourceCache* cache;
+    once([] {
 #ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
+        cache = new SkShardedResourceCache(SkDiscardableMemory::Create);
 #else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+        cache = new SkShardedResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
 #endif
-    }
-    return gResourceCache;
+    });
+    return cache;
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->getTotalBytesUsed();
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->getTotalByteLimit();
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->setTotalByteLimit(newLimit);
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->discardableFactory();
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->newCachedData(bytes);
+    // This doesn't touch any Recs, so there's no need to lock a shard.
+    if (DiscardableFactory factory = GetDiscardableFactory()) {
+        SkDiscardableMemory* dm = factory(bytes);
+        return dm ? new SkCachedData(bytes, dm) : nullptr;
+    } else {
+        return new SkCachedData(sk_malloc_throw(bytes), bytes);
+    }
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexAcquire am(gMutex);
     get_cache()->dump();
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->setSingleAllocationByteLimit(size);
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->getSingleAllocationByteLimit();
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->getEffectiveSingleAllocationByteLimit();
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->purgeAll();
+    get_cache()->purgeAll();
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
     return get_cache()->find(key, visitor, context);
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexAcquire am(gMutex);
     get_cache()->add(rec, payload);
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
     get_cache()->visitAll(visitor, context);
 }
 
@@ -10,8 +10,11 @@
 
 #include "SkBitmap.h"
 #include "SkMessageBus.h"
+#include "SkMutex.h"
 #include "SkTDArray.h"
 
+#include <atomic>
+
 class SkCachedData;
 class SkDiscardableMemory;
 class SkTraceMemoryDump;
@@ -25,6 +28,7 @@ class SkTraceMemoryDump;
  *
  *  As a convenience, a global instance is also defined, which can be safely
  *  access across threads via the static methods (e.g. FindAndLock, etc.).
+ *  The global cache is an SkShardedResourceCache (see below).
  */
 class SkResourceCache {
 public:
@@ -248,6 +252,12 @@ public:
         this->purgeAsNeeded(true);
     }
 
+    /**
+     *  Purge the least recently used Recs until this cache uses at most the
+     *  given number of bytes, or until nothing else can be purged.
+     */
+    void purgeToBytes(size_t bytes);
+
     DiscardableFactory discardableFactory() const { return fDiscardableFactory; }
 
     SkCachedData* newCachedData(size_t bytes);
@@ -275,6 +285,7 @@ private:
 
     void checkMessages();
     void purgeAsNeeded(bool forcePurge = false);
+    void purge(size_t byteLimit, int countLimit, bool forcePurge);
 
     // linklist management
     void moveToHead(Rec*);
@@ -290,4 +301,68 @@ private:
     void validate() const {}
 #endif
 };
+
+/**
+ *  A thread-safe cache split into shards by key hash, each an SkResourceCache
+ *  with its own lock and LRU list, so threads looking up different keys rarely
+ *  contend. The total byte limit is enforced across all of the shards: any one
+ *  shard may use up to the whole limit, but whenever the shards add up to more
+ *  than the limit they are purged back under it.
+ *
+ *  The global cache behind SkResourceCache's static methods is one of these.
+ */
+class SkShardedResourceCache {
+public:
+    SkShardedResourceCache(SkResourceCache::DiscardableFactory);
+    explicit SkShardedResourceCache(size_t byteLimit);
+    ~SkShardedResourceCache();
+
+    bool find(const SkResourceCache::Key&, SkResourceCache::FindVisitor, void* context);
+    void add(SkResourceCache::Rec*, void* payload = nullptr);
+    void visitAll(SkResourceCache::Visitor, void* context);
+
+    size_t getTotalBytesUsed() const;
+    size_t getTotalByteLimit() const;
+    size_t setTotalByteLimit(size_t newLimit);
+
+    size_t setSingleAllocationByteLimit(size_t maximumAllocationSize);
+    size_t getSingleAllocationByteLimit() const;
+    size_t getEffectiveSingleAllocationByteLimit() const;
+
+    void purgeAll();
+
+    SkResourceCache::DiscardableFactory discardableFactory() const { return fDiscardableFactory; }
+
+    void dump() const;
+
+#ifndef SK_RESOURCE_CACHE_SHARD_COUNT
+    #define SK_RESOURCE_CACHE_SHARD_COUNT   8
+#endif
+    static constexpr int kShardCount = SK_RESOURCE_CACHE_SHARD_COUNT;
+
+private:
+    struct Shard {
+        mutable SkMutex     fMutex;
+        SkResourceCache*    fCache;
+        // fCache->getTotalBytesUsed(), readable without fMutex
+        mutable std::atomic<size_t> fBytesUsed;
+
+        void updateBytesUsed() const {
+            fMutex.assertHeld();
+            fBytesUsed.store(fCache->getTotalBytesUsed(), std::memory_order_relaxed);
+        }
+    };
+
+    Shard& shardFor(uint32_t hash);
+    size_t sumBytesUsed() const;
+    void purgeShards(int grownShard);
+
+    template <typename Fn>
+    void forEachShard(Fn&& fn) const;
+
+    Shard                               fShards[kShardCount];
+    std::atomic<size_t>                 fTotalByteLimit;
+    SkResourceCache::DiscardableFactory fDiscardableFactory;
+};
+
 #endif
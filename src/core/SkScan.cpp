@@ -20,6 +20,7 @@ std::atomic<bool> gSkForceAnalyticAA{false};
 #endif
 
 std::atomic<bool> gSkForceDeltaAA{false};
+std::atomic<SkExecutor*> gSkDeltaAAExecutor{nullptr};
 
 static inline void blitrect(SkBlitter* blitter, const SkIRect& r) {
     blitter->blitRect(r.fLeft, r.fTop, r.width(), r.height());
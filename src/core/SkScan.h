@@ -16,6 +16,7 @@
 class SkRasterClip;
 class SkRegion;
 class SkBlitter;
+class SkExecutor;
 class SkPath;
 
 /** Defines a fixed-point rectangle, identical to the integer SkIRect, but its
@@ -25,6 +26,8 @@ typedef SkIRect SkXRect;
 
 extern std::atomic<bool> gSkUseDeltaAA;
 extern std::atomic<bool> gSkForceDeltaAA;
+// When set, tall DAA paths generate their coverage deltas in horizontal bands on this executor.
+extern std::atomic<SkExecutor*> gSkDeltaAAExecutor;
 extern std::atomic<bool> gSkUseAnalyticAA;
 extern std::atomic<bool> gSkForceAnalyticAA;
 
@@ -12,6 +12,7 @@
 #include "SkCoverageDelta.h"
 #include "SkEdge.h"
 #include "SkEdgeBuilder.h"
+#include "SkExecutor.h"
 #include "SkGeometry.h"
 #include "SkMask.h"
 #include "SkPath.h"
@@ -21,9 +22,12 @@
 #include "SkScan.h"
 #include "SkScanPriv.h"
 #include "SkTSort.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkUtils.h"
 
+#include <algorithm>
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /*
@@ -149,80 +153,111 @@ public:
     }
 };
 
-template<class Deltas> static SK_ALWAYS_INLINE
-void gen_alpha_deltas(const SkPath& path, const SkIRect& clipBounds, Deltas& result,
-        SkBlitter* blitter, bool skipRect, bool pathContainedInClip) {
-    // 1. Build edges
-    SkEdgeBuilder builder;
-    SkIRect ir               = path.getBounds().roundOut();
-    int  count               = builder.build_edges(path, &clipBounds, 0, pathContainedInClip,
-                                                   SkEdgeBuilder::kBezier);
-    if (count == 0) {
-        return;
+// The y range of a bezier's control points. Cubics aren't chopped at their y extrema, so all of
+// the points count.
+static SkScalar bezier_top(const SkBezier* bezier) {
+    SkScalar top = SkTMin(bezier->fP0.fY, bezier->fP1.fY);
+    if (bezier->fCount == 3) {
+        top = SkTMin(top, static_cast<const SkQuad*>(bezier)->fP2.fY);
+    } else if (bezier->fCount == 4) {
+        const SkCubic* cubic = static_cast<const SkCubic*>(bezier);
+        top = SkTMin(top, SkTMin(cubic->fP2.fY, cubic->fP3.fY));
     }
-    SkBezier** list = builder.bezierList();
+    return top;
+}
 
-    // 2. Try to find the rect part because blitAntiRect is so much faster than blitCoverageDeltas
-    int rectTop = ir.fBottom;   // the rect is initialized to be empty as top = bot
-    int rectBot = ir.fBottom;
-    if (skipRect) {             // only find that rect is skipRect == true
-        YLessThan lessThan;     // sort edges in YX order
-        SkTQSort(list, list + count - 1, lessThan);
-        for(int i = 0; i < count - 1; ++i) {
-            SkBezier* lb = list[i];
-            SkBezier* rb = list[i + 1];
-
-            // fCount == 2 ensures that lb and rb are lines instead of quads or cubics.
-            bool lDX0 = lb->fP0.fX == lb->fP1.fX && lb->fCount == 2;
-            bool rDX0 = rb->fP0.fX == rb->fP1.fX && rb->fCount == 2;
-            if (!lDX0 || !rDX0) { // make sure that the edges are vertical
-                continue;
-            }
+static SkScalar bezier_bottom(const SkBezier* bezier) {
+    SkScalar bottom = SkTMax(bezier->fP0.fY, bezier->fP1.fY);
+    if (bezier->fCount == 3) {
+        bottom = SkTMax(bottom, static_cast<const SkQuad*>(bezier)->fP2.fY);
+    } else if (bezier->fCount == 4) {
+        const SkCubic* cubic = static_cast<const SkCubic*>(bezier);
+        bottom = SkTMax(bottom, SkTMax(cubic->fP2.fY, cubic->fP3.fY));
+    }
+    return bottom;
+}
+
+class TopLessThan {
+public:
+    bool operator()(const SkBezier* a, const SkBezier* b) {
+        return bezier_top(a) < bezier_top(b);
+    }
+};
+
+// A bezier lies within the y range of its control points, so it can't add any deltas to rows
+// outside of that range. Leave a row of slack for the edges' fixed point snapping.
+static bool bezier_misses_rows(const SkBezier* bezier, int top, int bottom) {
+    return bezier_bottom(bezier) + 1 < top || bezier_top(bezier) - 1 >= bottom;
+}
+
+// 1. Build edges, and 2. try to find the rect part because blitAntiRect is so much faster than
+// blitCoverageDeltas. The rect is returned in antiRect, whose fHeight is 0 if there is none.
+static int build_edges_and_find_rect(SkEdgeBuilder* builder, const SkPath& path,
+                                     const SkIRect& clipBounds, bool skipRect,
+                                     bool pathContainedInClip, SkAntiRect* antiRect) {
+    *antiRect = {0, 0, 0, 0, 0, 0};
+    int count = builder->build_edges(path, &clipBounds, 0, pathContainedInClip,
+                                     SkEdgeBuilder::kBezier);
+    if (count == 0 || !skipRect) {  // only find that rect is skipRect == true
+        return count;
+    }
+    SkBezier** list = builder->bezierList();
+
+    YLessThan lessThan;     // sort edges in YX order
+    SkTQSort(list, list + count - 1, lessThan);
+    for(int i = 0; i < count - 1; ++i) {
+        SkBezier* lb = list[i];
+        SkBezier* rb = list[i + 1];
+
+        // fCount == 2 ensures that lb and rb are lines instead of quads or cubics.
+        bool lDX0 = lb->fP0.fX == lb->fP1.fX && lb->fCount == 2;
+        bool rDX0 = rb->fP0.fX == rb->fP1.fX && rb->fCount == 2;
+        if (!lDX0 || !rDX0) { // make sure that the edges are vertical
+            continue;
+        }
 
-            SkAnalyticEdge l, r;
-            l.setLine(lb->fP0, lb->fP1);
-            r.setLine(rb->fP0, rb->fP1);
-
-            SkFixed xorUpperY = l.fUpperY ^ r.fUpperY;
-            SkFixed xorLowerY = l.fLowerY ^ r.fLowerY;
-            if ((xorUpperY | xorLowerY) == 0) { // equal upperY and lowerY
-                rectTop = SkFixedCeilToInt(l.fUpperY);
-                rectBot = SkFixedFloorToInt(l.fLowerY);
-                if (rectBot > rectTop) { // if bot == top, the rect is too short for blitAntiRect
-                    int L = SkFixedCeilToInt(l.fUpperX);
-                    int R = SkFixedFloorToInt(r.fUpperX);
-                    if (L <= R) {
-                        SkAlpha la = (SkIntToFixed(L) - l.fUpperX) >> 8;
-                        SkAlpha ra = (r.fUpperX - SkIntToFixed(R)) >> 8;
-                        result.setAntiRect(L - 1, rectTop, R - L, rectBot - rectTop, la, ra);
-                    } else { // too thin to use blitAntiRect; reset the rect region to be emtpy
-                        rectTop = rectBot = ir.fBottom;
-                    }
+        SkAnalyticEdge l, r;
+        l.setLine(lb->fP0, lb->fP1);
+        r.setLine(rb->fP0, rb->fP1);
+
+        SkFixed xorUpperY = l.fUpperY ^ r.fUpperY;
+        SkFixed xorLowerY = l.fLowerY ^ r.fLowerY;
+        if ((xorUpperY | xorLowerY) == 0) { // equal upperY and lowerY
+            int rectTop = SkFixedCeilToInt(l.fUpperY);
+            int rectBot = SkFixedFloorToInt(l.fLowerY);
+            if (rectBot > rectTop) { // if bot == top, the rect is too short for blitAntiRect
+                int L = SkFixedCeilToInt(l.fUpperX);
+                int R = SkFixedFloorToInt(r.fUpperX);
+                if (L <= R) { // otherwise it's too thin to use blitAntiRect
+                    SkAlpha la = (SkIntToFixed(L) - l.fUpperX) >> 8;
+                    SkAlpha ra = (r.fUpperX - SkIntToFixed(R)) >> 8;
+                    *antiRect = {L - 1, rectTop, R - L, rectBot - rectTop, la, ra};
                 }
-                break;
             }
-
+            break;
         }
     }
+    return count;
+}
 
-    // 3. Sort edges in x so we may need less sorting for delta based on x. This only helps
-    //    SkCoverageDeltaList. And we don't want to sort more than SORT_THRESHOLD edges where
-    //    the log(count) factor of the quick sort may become a bottleneck; when there are so
-    //    many edges, we're unlikely to make deltas sorted anyway.
-    constexpr int SORT_THRESHOLD = 256;
-    if (std::is_same<Deltas, SkCoverageDeltaList>::value && count < SORT_THRESHOLD) {
-        XLessThan lessThan;
-        SkTQSort(list, list + count - 1, lessThan);
-    }
+// 4. iterate through edges and generate deltas. Edges that can't reach the rows of result are
+// skipped, and the rows of antiRect are left to blitAntiRect. The edge list is only read, so
+// several bands may share it.
+template<class Deltas> static SK_ALWAYS_INLINE
+void gen_edge_deltas(SkBezier* const* list, int count, const SkAntiRect& antiRect,
+                     Deltas& result) {
+    const int rectTop = antiRect.fY;
+    const int rectBot = antiRect.fY + antiRect.fHeight;
 
-    // Future todo: parallize and SIMD the following code.
-    // 4. iterate through edges and generate deltas
     for(int index = 0; index < count; ++index) {
         SkAnalyticCubicEdge storage;
         SkASSERT(sizeof(SkAnalyticQuadraticEdge) >= sizeof(SkAnalyticEdge));
         SkASSERT(sizeof(SkAnalyticCubicEdge) >= sizeof(SkAnalyticQuadraticEdge));
 
-        SkBezier* bezier        = list[index];
+        const SkBezier* bezier  = list[index];
+        if (bezier_misses_rows(bezier, result.top(), result.bottom())) {
+            continue;
+        }
         SkAnalyticEdge* currE   = &storage;
         bool edgeSet            = false;
 
@@ -235,7 +270,7 @@ void gen_alpha_deltas(const SkPath& path, const SkIRect& clipBounds, Deltas& res
                 break;
             }
             case 3: {
-                SkQuad* quad = static_cast<SkQuad*>(bezier);
+                const SkQuad* quad = static_cast<const SkQuad*>(bezier);
                 SkPoint pts[3] = {quad->fP0, quad->fP1, quad->fP2};
                 edgeSet = static_cast<SkAnalyticQuadraticEdge*>(currE)->setQuadratic(pts);
                 originalWinding = static_cast<SkAnalyticQuadraticEdge*>(currE)->fQEdge.fWinding;
@@ -243,7 +278,7 @@ void gen_alpha_deltas(const SkPath& path, const SkIRect& clipBounds, Deltas& res
             }
             case 4: {
                 sortY = false;
-                SkCubic* cubic = static_cast<SkCubic*>(bezier);
+                const SkCubic* cubic = static_cast<const SkCubic*>(bezier);
                 SkPoint pts[4] = {cubic->fP0, cubic->fP1, cubic->fP2, cubic->fP3};
                 edgeSet = static_cast<SkAnalyticCubicEdge*>(currE)->setCubic(pts, sortY);
                 originalWinding = static_cast<SkAnalyticCubicEdge*>(currE)->fCEdge.fWinding;
@@ -255,7 +290,16 @@ void gen_alpha_deltas(const SkPath& path, const SkIRect& clipBounds, Deltas& res
             continue;
         }
 
+        // The deltas may only cover a band of the path (see fill_path_in_bands). Segments outside
+        // [result.top(), result.bottom()) are skipped, and full rows above the band are jumped
+        // over at once, so x lands on the band exactly where it would without bands.
+        SkFixed resultTop    = SkIntToFixed(result.top());
+        SkFixed resultBottom = SkIntToFixed(result.bottom());
+
         do {
+            if (currE->fLowerY <= resultTop || currE->fUpperY >= resultBottom) {
+                continue;
+            }
             currE->fX =  currE->fUpperX;
 
             SkFixed upperFloor  = SkFixedFloorToFixed(currE->fUpperY);
@@ -265,7 +309,7 @@ void gen_alpha_deltas(const SkPath& path, const SkIRect& clipBounds, Deltas& res
             if (lowerCeil <= upperFloor + SK_Fixed1) { // only one row is affected by the currE
                 SkFixed rowHeight = currE->fLowerY - currE->fUpperY;
                 SkFixed nextX = currE->fX + SkFixedMul(currE->fDX, rowHeight);
-                if (iy >= clipBounds.fTop && iy < clipBounds.fBottom) {
+                if (iy >= result.top() && iy < result.bottom()) {
                     add_coverage_delta_segment<true>(iy, rowHeight, currE, nextX, &result);
                 }
                 continue;
@@ -276,22 +320,34 @@ void gen_alpha_deltas(const SkPath& path, const SkIRect& clipBounds, Deltas& res
             SkFixed nextX;
             if (rowHeight != SK_Fixed1) {   // it's a partial row
                 nextX = currE->fX + SkFixedMul(currE->fDX, rowHeight);
-                add_coverage_delta_segment<true>(iy, rowHeight, currE, nextX, &result);
+                if (iy >= result.top()) {
+                    add_coverage_delta_segment<true>(iy, rowHeight, currE, nextX, &result);
+                }
             } else {                        // it's a full row so we can leave it to the while loop
                 iy--;                       // compensate the iy++ in the while loop
                 nextX = currE->fX;
             }
 
+            // Jump over the full rows above the band; the loop below would only advance x there.
+            // Stop at the last partial row (floor(fLowerY)) so the loop still breaks on it.
+            int skipRows = SkTMin(result.top(), SkFixedFloorToInt(currE->fLowerY)) - (iy + 1);
+            if (skipRows > 0) {
+                iy    += skipRows;
+                nextX += (SkFixed)((int64_t)skipRows * currE->fDX);
+            }
+
             while (true) { // process the full rows in the middle
                 iy++;
                 SkFixed y = SkIntToFixed(iy);
                 currE->fX = nextX;
                 nextX += currE->fDX;
 
-                if (y + SK_Fixed1 > currE->fLowerY) {
+                if (y + SK_Fixed1 > currE->fLowerY || iy >= result.bottom()) {
                     break; // no full rows left, break
                 }
 
+                SkASSERT(iy >= result.top());
+
                 // Check whether we're in the rect part that will be covered by blitAntiRect
                 if (iy >= rectTop && iy < rectBot) {
                     SkASSERT(currE->fDX == 0);  // If yes, we must be on an edge with fDX = 0.
@@ -305,7 +361,7 @@ void gen_alpha_deltas(const SkPath& path, const SkIRect& clipBounds, Deltas& res
 
             // last partial row
             if (SkIntToFixed(iy) < currE->fLowerY &&
-                    iy >= clipBounds.fTop && iy < clipBounds.fBottom) {
+                    iy >= result.top() && iy < result.bottom()) {
                 rowHeight = currE->fLowerY - SkIntToFixed(iy);
                 nextX = currE->fX + SkFixedMul(currE->fDX, rowHeight);
                 add_coverage_delta_segment<true>(iy, rowHeight, currE, nextX, &result);
@@ -315,6 +371,108 @@ void gen_alpha_deltas(const SkPath& path, const SkIRect& clipBounds, Deltas& res
     }
 }
 
+template<class Deltas> static SK_ALWAYS_INLINE
+void gen_alpha_deltas(const SkPath& path, const SkIRect& clipBounds, Deltas& result,
+        SkBlitter* blitter, bool skipRect, bool pathContainedInClip) {
+    SkEdgeBuilder builder;
+    SkAntiRect    antiRect;
+    int count = build_edges_and_find_rect(&builder, path, clipBounds, skipRect,
+                                          pathContainedInClip, &antiRect);
+    if (count == 0) {
+        return;
+    }
+    SkBezier** list = builder.bezierList();
+    if (antiRect.fHeight) {
+        result.setAntiRect(antiRect.fX, antiRect.fY, antiRect.fWidth, antiRect.fHeight,
+                           antiRect.fLeftAlpha, antiRect.fRightAlpha);
+    }
+
+    // 3. Sort edges in x so we may need less sorting for delta based on x. This only helps
+    //    SkCoverageDeltaList. And we don't want to sort more than SORT_THRESHOLD edges where
+    //    the log(count) factor of the quick sort may become a bottleneck; when there are so
+    //    many edges, we're unlikely to make deltas sorted anyway.
+    constexpr int SORT_THRESHOLD = 256;
+    if (std::is_same<Deltas, SkCoverageDeltaList>::value && count < SORT_THRESHOLD) {
+        XLessThan lessThan;
+        SkTQSort(list, list + count - 1, lessThan);
+    }
+
+    // Future todo: parallize and SIMD the following code.
+    gen_edge_deltas(list, count, antiRect, result);
+}
+
+// Big paths can be split into horizontal bands whose deltas are generated in parallel. The edges
+// are built, sorted by their top and searched for the anti-rect once, on the calling thread. Each
+// band then gets its own arena and SkCoverageDeltaList, and reads the shared edge list only up to
+// the first edge that starts below it, so the worker threads never write any shared memory. A band
+// only steps through its own rows, yet computes the same x on each of them as the unbanded path
+// would, so the result is identical.
+// The bands are then blitted in order on the calling thread since blitters aren't thread-safe.
+static constexpr int kMinDAABandHeight = 64;
+static constexpr int kMaxDAABands      = 16;
+
+static bool fill_path_in_bands(const SkPath& path, SkBlitter* blitter, const SkIRect& clippedIR,
+                               const SkIRect& clipBounds, bool isEvenOdd, bool isConvex,
+                               bool skipRect, bool containedInClip, SkArenaAlloc* alloc) {
+    SkExecutor* executor = gSkDeltaAAExecutor;
+    int bandCount = SkTMin(clippedIR.height() / kMinDAABandHeight, kMaxDAABands);
+    if (!executor || bandCount < 2) {
+        return false;
+    }
+
+    SkEdgeBuilder builder;
+    SkAntiRect    antiRect;
+    int count = build_edges_and_find_rect(&builder, path, clipBounds, skipRect, containedInClip,
+                                          &antiRect);
+    if (count == 0) {
+        return true;
+    }
+    SkBezier** list = builder.bezierList();
+    TopLessThan lessThan;
+    SkTQSort(list, list + count - 1, lessThan);
+
+    SkCoverageDeltaList** bands = alloc->makeArrayDefault<SkCoverageDeltaList*>(bandCount);
+    int top = clippedIR.fTop;
+    for (int i = 0; i < bandCount; ++i) {
+        int bottom = clippedIR.fTop + (int)((int64_t)clippedIR.height() * (i + 1) / bandCount);
+        // The band's own arena allocates from the heap; it's destroyed along with alloc.
+        SkArenaAlloc* bandAlloc = alloc->make<SkArenaAlloc>(16 << 10);
+        bands[i] = bandAlloc->make<SkCoverageDeltaList>(bandAlloc, top, bottom, false);
+        top = bottom;
+    }
+
+    SkTaskGroup tg(*executor);
+    tg.batch(bandCount, [&](int i) {
+        SkCoverageDeltaList* band = bands[i];
+
+        // The edges from the first one that starts below this band (see bezier_misses_rows) on
+        // can't reach it.
+        int bandEnd = std::lower_bound(list, list + count, band->bottom(),
+                                       [](const SkBezier* bezier, int bottom) {
+                                           return bezier_top(bezier) - 1 < bottom;
+                                       }) - list;
+
+        // Only blit the rows of the anti-rect that belong to this band.
+        SkAntiRect bandRect = antiRect;
+        if (antiRect.fHeight) {
+            int rectTop = SkTMax(antiRect.fY, band->top()),
+                rectBot = SkTMin(antiRect.fY + antiRect.fHeight, band->bottom());
+            bandRect.fY      = rectTop;
+            bandRect.fHeight = SkTMax(rectBot - rectTop, 0);
+            band->setAntiRect(bandRect.fX, bandRect.fY, bandRect.fWidth, bandRect.fHeight,
+                              bandRect.fLeftAlpha, bandRect.fRightAlpha);
+        }
+
+        gen_edge_deltas(list, bandEnd, bandRect, *band);
+    });
+    tg.wait();
+
+    for (int i = 0; i < bandCount; ++i) {
+        blitter->blitCoverageDeltas(bands[i], clipBounds, isEvenOdd, false, isConvex);
+    }
+    return true;
+}
+
 // For threaded backend with out-of-order init-once, we probably have to take care of the
 // blitRegion, sk_blit_above, sk_blit_below in SkScan::AntiFillPath to maintain the draw order. If
 // we do that, be caureful that blitRect may throw exception if the rect is empty.
@@ -351,7 +509,9 @@ void SkScan::DAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect&
         gen_alpha_deltas(path, clipBounds, deltaMask, blitter, skipRect, containedInClip);
         deltaMask.convertCoverageToAlpha(isEvenOdd, isInverse, isConvex);
         blitter->blitMask(deltaMask.prepareSkMask(), clippedIR);
-    } else {
+    } else if (forceRLE || isInverse ||
+               !fill_path_in_bands(path, blitter, clippedIR, clipBounds, isEvenOdd, isConvex,
+                                   skipRect, containedInClip, &alloc)) {
         SkCoverageDeltaList deltaList(&alloc, clippedIR.fTop, clippedIR.fBottom, forceRLE);
         gen_alpha_deltas(path, clipBounds, deltaList, blitter, skipRect, containedInClip);
         blitter->blitCoverageDeltas(&deltaList, clipBounds, isEvenOdd, isInverse, isConvex);
@@ -0,0 +1,511 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkDescriptor.h"
+#include "SkFontDescriptor.h"
+#include "SkMD5.h"
+#include "SkOSFile.h"
+#include "SkPath.h"
+#include "SkReader32.h"
+#include "SkScalerContext.h"
+#include "SkStream.h"
+#include "SkStreamPriv.h"
+#include "SkStrikeStore.h"
+#include "SkTypeface.h"
+
+/*  File layout. Everything is 4-byte aligned and in host byte order. The hashes are MD5 rather
+    than SkOpts::hash(), whose result depends on the CPU it runs on.
+
+    FileHeader
+    repeated FileHeader::fStrikeCount times:
+        uint32_t    key length
+        key bytes, padded to 4
+        uint32_t    glyph count
+        repeated glyph count times:
+            GlyphRecord
+            image bytes, padded to 4
+            path bytes, padded to 4
+*/
+
+namespace {
+
+static constexpr uint32_t kMagic   = SkSetFourByteTag('s', 'k', 'g', 's');
+static constexpr uint32_t kVersion = 2;
+
+struct FileHeader {
+    uint32_t fMagic;
+    uint32_t fVersion;
+    uint32_t fBodySize;     // bytes following the header
+    uint32_t fBodyHash;     // body_hash() of those bytes
+    uint32_t fStrikeCount;
+};
+
+static uint32_t body_hash(const void* data, size_t size) {
+    SkMD5 md5;
+    md5.write(data, size);
+    SkMD5::Digest digest;
+    md5.finish(digest);
+    uint32_t hash;
+    memcpy(&hash, digest.data, sizeof(hash));
+    return hash;
+}
+
+struct GlyphRecord {
+    enum {
+        kHasMetrics_Flag = 1 << 0,
+    };
+
+    uint32_t fCode;
+    int32_t  fSubX, fSubY;  // SkFixed subpixel position
+    uint32_t fFlags;
+    float    fAdvanceX, fAdvanceY;
+    uint16_t fWidth, fHeight;
+    int16_t  fTop, fLeft;
+    uint8_t  fMaskFormat;
+    int8_t   fRsbDelta, fLsbDelta;
+    int8_t   fForceBW;
+    uint32_t fImageFormat;
+    uint32_t fImageSize;
+    uint32_t fPathSize;
+};
+static_assert(sizeof(FileHeader) == 20, "FileHeader must have no padding");
+static_assert(sizeof(GlyphRecord) == 48, "GlyphRecord must have no padding");
+
+}  // namespace
+
+// The bytes a new glyph, without image or path, adds to the file. The first glyph of a strike
+// also pays for the strike's key, since empty strikes are not written.
+static size_t new_glyph_bytes(const SkString& key, int glyphCount) {
+    size_t bytes = sizeof(GlyphRecord);
+    if (glyphCount == 0) {
+        bytes += 2 * sizeof(uint32_t) + SkAlign4(key.size());
+    }
+    return bytes;
+}
+
+// The descriptor with the process-local font ID zeroed, followed by a hash of the font data.
+static SkString strike_key(const SkDescriptor& desc, uint64_t fontHash) {
+    std::unique_ptr<SkDescriptor> copy = desc.copy();
+    uint32_t length = 0;
+    auto rec = static_cast<SkScalerContextRec*>(
+            const_cast<void*>(copy->findEntry(kRec_SkDescriptorTag, &length)));
+    if (!rec || length != sizeof(*rec)) {
+        return SkString();
+    }
+    rec->fFontID = 0;
+    copy->computeChecksum();
+
+    SkString key(copy->getLength() + sizeof(fontHash));
+    memcpy(key.writable_str(), copy.get(), copy->getLength());
+    memcpy(key.writable_str() + copy->getLength(), &fontHash, sizeof(fontHash));
+    return key;
+}
+
+static sk_sp<SkData> read_file(const char path[]) {
+#if defined(SK_BUILD_FOR_WIN)
+    // Windows won't replace a file while it is mapped, so flush() couldn't move a new file
+    // over this one. Read a copy instead.
+    SkFILEStream stream(path);
+    return stream.isValid() ? SkData::MakeFromStream(&stream, stream.getLength()) : nullptr;
+#else
+    return SkData::MakeFromFileName(path);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+sk_sp<SkStrikeStore> SkStrikeStore::Make(const char path[], size_t maxBytes) {
+    if (!path || maxBytes < sizeof(FileHeader)) {
+        return nullptr;
+    }
+    sk_sp<SkStrikeStore> store(new SkStrikeStore(SkString(path), maxBytes));
+    if (sk_sp<SkData> data = read_file(path)) {
+        SkAutoMutexAcquire lock(store->fMutex);
+        if (store->load(*data)) {
+            store->fMapped = std::move(data);
+        }
+    }
+    return store;
+}
+
+SkStrikeStore::SkStrikeStore(SkString path, size_t maxBytes)
+    : fPath(std::move(path))
+    , fMaxBytes(maxBytes)
+    , fBytesUsed(sizeof(FileHeader)) {}
+
+bool SkStrikeStore::load(const SkData& data) {
+    if (data.size() < sizeof(FileHeader) || data.size() > fMaxBytes) {
+        return false;
+    }
+    FileHeader header;
+    memcpy(&header, data.data(), sizeof(header));
+    const char* body = static_cast<const char*>(data.data()) + sizeof(header);
+    if (header.fMagic != kMagic || header.fVersion != kVersion ||
+        header.fBodySize != data.size() - sizeof(header) ||
+        header.fBodyHash != body_hash(body, header.fBodySize)) {
+        return false;
+    }
+
+    SkReader32 reader(body, header.fBodySize);
+    auto readU32 = [&reader](uint32_t* value) {
+        if (!reader.isAvailable(sizeof(uint32_t))) {
+            return false;
+        }
+        *value = reader.readU32();
+        return true;
+    };
+    auto skip = [&reader](uint32_t size, const void** ptr) {
+        if (SkAlign4((size_t)size) > reader.available()) {
+            return false;
+        }
+        *ptr = reader.skip(SkAlign4(size));
+        return true;
+    };
+
+    bool ok = true;
+    for (uint32_t i = 0; ok && i < header.fStrikeCount; ++i) {
+        uint32_t keyLength, glyphCount;
+        const void* keyData;
+        if (!readU32(&keyLength) || !skip(keyLength, &keyData) || !readU32(&glyphCount)) {
+            ok = false;
+            break;
+        }
+        SkString key(static_cast<const char*>(keyData), keyLength);
+        if (fStrikesByKey.find(key)) {
+            ok = false;
+            break;
+        }
+        Strike* strike = this->internalFindOrAddStrike(key);
+
+        for (uint32_t j = 0; j < glyphCount; ++j) {
+            if (!reader.isAvailable(sizeof(GlyphRecord))) {
+                ok = false;
+                break;
+            }
+            GlyphRecord record;
+            reader.read(&record, sizeof(record));
+
+            if (record.fCode > SK_MaxU16) {
+                ok = false;
+                break;
+            }
+            SkPackedGlyphID id(SkToU16(record.fCode), record.fSubX, record.fSubY);
+            Glyph glyph;
+            if (!skip(record.fImageSize, &glyph.fImage) || !skip(record.fPathSize, &glyph.fPath)) {
+                ok = false;
+                break;
+            }
+            if (record.fImageSize == 0) {
+                glyph.fImage = nullptr;
+            }
+            if (record.fPathSize == 0) {
+                glyph.fPath = nullptr;
+            }
+            // Stored metrics are always full metrics, and images must be in a format SkGlyph
+            // knows how to size; anything else means the file is not ours.
+            if ((record.fFlags & GlyphRecord::kHasMetrics_Flag) &&
+                record.fMaskFormat > SkMask::kLCD16_Format) {
+                ok = false;
+                break;
+            }
+            if (record.fImageSize && record.fImageFormat > SkMask::kLCD16_Format) {
+                ok = false;
+                break;
+            }
+            glyph.fMetrics.initWithGlyphID(id);
+            glyph.fHasMetrics  = SkToBool(record.fFlags & GlyphRecord::kHasMetrics_Flag);
+            glyph.fMetrics.fAdvanceX   = record.fAdvanceX;
+            glyph.fMetrics.fAdvanceY   = record.fAdvanceY;
+            glyph.fMetrics.fWidth      = record.fWidth;
+            glyph.fMetrics.fHeight     = record.fHeight;
+            glyph.fMetrics.fTop        = record.fTop;
+            glyph.fMetrics.fLeft       = record.fLeft;
+            glyph.fMetrics.fMaskFormat = record.fMaskFormat;
+            glyph.fMetrics.fRsbDelta   = record.fRsbDelta;
+            glyph.fMetrics.fLsbDelta   = record.fLsbDelta;
+            glyph.fMetrics.fForceBW    = record.fForceBW;
+            glyph.fImageFormat = SkToU8(record.fImageFormat);
+            glyph.fImageSize   = record.fImageSize;
+            glyph.fPathSize    = record.fPathSize;
+            strike->fGlyphs.set(id, glyph);
+        }
+    }
+    if (ok && reader.eof()) {
+        fBytesUsed = data.size();
+        return true;
+    }
+
+    fStrikes.reset();
+    fStrikesByKey.reset();
+    fBytesUsed = sizeof(FileHeader);
+    return false;
+}
+
+uint64_t SkStrikeStore::fontHash(SkTypeface* typeface) {
+    const uint32_t fontID = typeface->uniqueID();
+    {
+        SkAutoMutexAcquire lock(fMutex);
+        if (uint64_t* hash = fFontHashes.find(fontID)) {
+            return *hash;
+        }
+    }
+
+    // Hash the whole font, its index in a collection, and its variation, outside the lock.
+    // The font is streamed through the hash in a single pass, without copying it.
+    uint64_t hash = 0;
+    std::unique_ptr<SkFontData> fontData = typeface->makeFontData();
+    if (fontData && fontData->hasStream()) {
+        SkMD5 md5;
+        int32_t index = fontData->getIndex();
+        md5.write(&index, sizeof(index));
+        md5.write(fontData->getAxis(), fontData->getAxisCount() * sizeof(SkFixed));
+        if (SkStreamCopy(&md5, fontData->getStream())) {
+            SkMD5::Digest digest;
+            md5.finish(digest);
+            memcpy(&hash, digest.data, sizeof(hash));
+        }
+    }
+
+    SkAutoMutexAcquire lock(fMutex);
+    fFontHashes.set(fontID, hash);
+    return hash;
+}
+
+SkStrikeStore::Strike* SkStrikeStore::findOrAddStrike(SkTypeface* typeface,
+                                                      const SkDescriptor& desc) {
+    uint64_t hash = this->fontHash(typeface);
+    if (hash == 0) {
+        return nullptr;
+    }
+    SkString key = strike_key(desc, hash);
+    if (key.isEmpty()) {
+        return nullptr;
+    }
+    SkAutoMutexAcquire lock(fMutex);
+    return this->internalFindOrAddStrike(key);
+}
+
+SkStrikeStore::Strike* SkStrikeStore::internalFindOrAddStrike(const SkString& key) {
+    if (Strike** strike = fStrikesByKey.find(key)) {
+        return *strike;
+    }
+    // Strikes cost nothing in the file until they have glyphs, so they are not budgeted here.
+    fStrikes.emplace_back(new Strike(this, key));
+    Strike* strike = fStrikes.back().get();
+    fStrikesByKey.set(key, strike);
+    return strike;
+}
+
+bool SkStrikeStore::reserve(size_t bytes) {
+    if (bytes > fMaxBytes - fBytesUsed) {
+        return false;
+    }
+    fBytesUsed += bytes;
+    return true;
+}
+
+size_t SkStrikeStore::getBytesUsed() const {
+    SkAutoMutexAcquire lock(fMutex);
+    return fBytesUsed;
+}
+
+int SkStrikeStore::countGlyphs() const {
+    SkAutoMutexAcquire lock(fMutex);
+    int count = 0;
+    for (const auto& strike : fStrikes) {
+        count += strike->fGlyphs.count();
+    }
+    return count;
+}
+
+bool SkStrikeStore::flush() {
+    SkDynamicMemoryWStream body;
+    uint32_t strikeCount = 0;
+    {
+        SkAutoMutexAcquire lock(fMutex);
+        static const char kPad[4] = {0, 0, 0, 0};
+        auto writePadded = [&body](const void* data, size_t size) {
+            body.write(data, size);
+            body.write(kPad, SkAlign4(size) - size);
+        };
+
+        for (const auto& strike : fStrikes) {
+            if (strike->fGlyphs.count() == 0) {
+                continue;
+            }
+            strikeCount += 1;
+            body.write32(SkToU32(strike->fKey.size()));
+            writePadded(strike->fKey.c_str(), strike->fKey.size());
+            body.write32(SkToU32(strike->fGlyphs.count()));
+            const auto& glyphs = strike->fGlyphs;
+            glyphs.foreach([&](const SkPackedGlyphID& id, const Glyph& glyph) {
+                GlyphRecord record;
+                memset(&record, 0, sizeof(record));
+                record.fCode        = id.code();
+                record.fSubX        = id.getSubXFixed();
+                record.fSubY        = id.getSubYFixed();
+                record.fFlags       = glyph.fHasMetrics ? GlyphRecord::kHasMetrics_Flag : 0;
+                record.fAdvanceX    = glyph.fMetrics.fAdvanceX;
+                record.fAdvanceY    = glyph.fMetrics.fAdvanceY;
+                record.fWidth       = glyph.fMetrics.fWidth;
+                record.fHeight      = glyph.fMetrics.fHeight;
+                record.fTop         = glyph.fMetrics.fTop;
+                record.fLeft        = glyph.fMetrics.fLeft;
+                record.fMaskFormat  = glyph.fMetrics.fMaskFormat;
+                record.fRsbDelta    = glyph.fMetrics.fRsbDelta;
+                record.fLsbDelta    = glyph.fMetrics.fLsbDelta;
+                record.fForceBW     = glyph.fMetrics.fForceBW;
+                record.fImageFormat = glyph.fImageFormat;
+                record.fImageSize   = glyph.fImageSize;
+                record.fPathSize    = glyph.fPathSize;
+                body.write(&record, sizeof(record));
+                writePadded(glyph.fImage, glyph.fImageSize);
+                writePadded(glyph.fPath, glyph.fPathSize);
+            });
+        }
+    }
+
+    sk_sp<SkData> bodyData = body.detachAsData();
+    FileHeader header;
+    header.fMagic       = kMagic;
+    header.fVersion     = kVersion;
+    header.fBodySize    = SkToU32(bodyData->size());
+    header.fBodyHash    = body_hash(bodyData->data(), bodyData->size());
+    header.fStrikeCount = strikeCount;
+
+    // Write beside the file and move it into place, so a reader (including our own mapping of
+    // the old file) never sees it half written.
+    SkString tmpPath = SkStringPrintf("%s.tmp", fPath.c_str());
+    bool written;
+    {
+        SkFILEWStream file(tmpPath.c_str());
+        written = file.isValid() &&
+                  file.write(&header, sizeof(header)) &&
+                  file.write(bodyData->data(), bodyData->size());
+        file.flush();
+    }
+    if (!written || !sk_rename(tmpPath.c_str(), fPath.c_str())) {
+        sk_remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool SkStrikeStore::Strike::findMetrics(SkGlyph* glyph) const {
+    SkAutoMutexAcquire lock(fStore->fMutex);
+    const Glyph* stored = fGlyphs.find(glyph->getPackedID());
+    if (!stored || !stored->fHasMetrics) {
+        return false;
+    }
+    const SkGlyph& metrics = stored->fMetrics;
+    glyph->fAdvanceX   = metrics.fAdvanceX;
+    glyph->fAdvanceY   = metrics.fAdvanceY;
+    glyph->fWidth      = metrics.fWidth;
+    glyph->fHeight     = metrics.fHeight;
+    glyph->fTop        = metrics.fTop;
+    glyph->fLeft       = metrics.fLeft;
+    glyph->fMaskFormat = metrics.fMaskFormat;
+    glyph->fRsbDelta   = metrics.fRsbDelta;
+    glyph->fLsbDelta   = metrics.fLsbDelta;
+    glyph->fForceBW    = metrics.fForceBW;
+    return true;
+}
+
+bool SkStrikeStore::Strike::findImage(const SkGlyph& glyph) const {
+    SkASSERT(glyph.fImage);
+    SkAutoMutexAcquire lock(fStore->fMutex);
+    const Glyph* stored = fGlyphs.find(glyph.getPackedID());
+    if (!stored || !stored->fImage || stored->fImageFormat != glyph.fMaskFormat ||
+        stored->fImageSize != glyph.computeImageSize()) {
+        return false;
+    }
+    memcpy(glyph.fImage, stored->fImage, stored->fImageSize);
+    return true;
+}
+
+bool SkStrikeStore::Strike::findPath(SkPackedGlyphID id, SkPath* path) const {
+    SkAutoMutexAcquire lock(fStore->fMutex);
+    const Glyph* stored = fGlyphs.find(id);
+    if (!stored || !stored->fPath) {
+        return false;
+    }
+    SkPath loaded;
+    if (0 == loaded.readFromMemory(stored->fPath, stored->fPathSize)) {
+        return false;
+    }
+    *path = loaded;
+    return true;
+}
+
+void SkStrikeStore::Strike::addMetrics(const SkGlyph& glyph) {
+    if (glyph.isJustAdvance()) {
+        return;
+    }
+    SkAutoMutexAcquire lock(fStore->fMutex);
+    Glyph* stored = fGlyphs.find(glyph.getPackedID());
+    if (!stored) {
+        if (!fStore->reserve(new_glyph_bytes(fKey, fGlyphs.count()))) {
+            return;
+        }
+        stored = fGlyphs.set(glyph.getPackedID(), Glyph());
+    } else if (stored->fHasMetrics) {
+        return;
+    }
+    stored->fMetrics = glyph;
+    stored->fMetrics.fImage = nullptr;
+    stored->fMetrics.fPathData = nullptr;
+    stored->fHasMetrics = true;
+}
+
+void SkStrikeStore::Strike::addImage(const SkGlyph& glyph) {
+    if (!glyph.fImage) {
+        return;
+    }
+    this->addMetrics(glyph);
+
+    SkAutoMutexAcquire lock(fStore->fMutex);
+    Glyph* stored = fGlyphs.find(glyph.getPackedID());
+    if (!stored || stored->fImage) {
+        return;
+    }
+    const size_t size = glyph.computeImageSize();
+    if (!fStore->reserve(SkAlign4(size))) {
+        return;
+    }
+    void* image = fStore->fAlloc.makeArrayDefault<uint32_t>(SkAlign4(size) >> 2);
+    memcpy(image, glyph.fImage, size);
+    stored->fImage       = image;
+    stored->fImageFormat = glyph.fMaskFormat;
+    stored->fImageSize   = SkToU32(size);
+}
+
+void SkStrikeStore::Strike::addPath(SkPackedGlyphID id, const SkPath& path) {
+    const size_t size = path.writeToMemory(nullptr);
+
+    SkAutoMutexAcquire lock(fStore->fMutex);
+    Glyph* stored = fGlyphs.find(id);
+    if (stored && stored->fPath) {
+        return;
+    }
+    size_t bytes = SkAlign4(size);
+    if (!stored) {
+        bytes += new_glyph_bytes(fKey, fGlyphs.count());
+    }
+    if (!fStore->reserve(bytes)) {
+        return;
+    }
+    if (!stored) {
+        stored = fGlyphs.set(id, Glyph());
+        stored->fMetrics.initWithGlyphID(id);
+    }
+    void* data = fStore->fAlloc.makeArrayDefault<uint32_t>(SkAlign4(size) >> 2);
+    path.writeToMemory(data);
+    stored->fPath     = data;
+    stored->fPathSize = SkToU32(size);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkStrikeStore_DEFINED
+#define SkStrikeStore_DEFINED
+
+#include "SkArenaAlloc.h"
+#include "SkData.h"
+#include "SkGlyph.h"
+#include "SkMutex.h"
+#include "SkRefCnt.h"
+#include "SkString.h"
+#include "SkTArray.h"
+#include "SkTHash.h"
+
+class SkDescriptor;
+class SkPath;
+class SkTypeface;
+
+/** \class SkStrikeStore
+
+    A persistent store of glyph metrics, images and paths, so that a process can skip
+    regenerating the glyphs an earlier run already made.
+
+    The store is backed by a single file. Make() maps the file and validates it; anything that
+    fails validation is dropped and the store starts out empty. Strikes (SkGlyphCache) consult
+    the store before asking their SkScalerContext for a glyph, and record whatever they had to
+    generate. flush() writes everything known, up to the size limit, back to the file.
+
+    Strikes are keyed by their SkDescriptor with the process-local font ID replaced by a hash of
+    the font's data, so keys stay valid across restarts. The file does not record which font
+    engine produced the glyphs; delete it when that changes.
+
+    All methods are thread safe.
+*/
+class SkStrikeStore : public SkRefCnt {
+public:
+    /** Returns a store backed by the file at path, which need not exist yet. The store will not
+        grow past maxBytes, counting both loaded and newly recorded glyphs.
+    */
+    static sk_sp<SkStrikeStore> Make(const char path[], size_t maxBytes);
+
+    class Strike;
+
+    /** Return the part of the store for the strike described by desc, which was made for
+        typeface. The result lives as long as the store. Returns nullptr if the typeface's data
+        cannot be read, since then there is nothing stable to key the strike by.
+    */
+    Strike* findOrAddStrike(SkTypeface*, const SkDescriptor&);
+
+    /** Write the store to its file. Returns false if the file could not be written. */
+    bool flush();
+
+    /** Approximate number of bytes the store would write. */
+    size_t getBytesUsed() const;
+    int countGlyphs() const;
+
+private:
+    struct Glyph {
+        SkGlyph     fMetrics;       // only the metrics fields are used
+        bool        fHasMetrics = false;
+        uint8_t     fImageFormat = 0;
+        const void* fImage = nullptr;
+        uint32_t    fImageSize = 0;
+        const void* fPath = nullptr;  // as written by SkPath::writeToMemory()
+        uint32_t    fPathSize = 0;
+    };
+    struct GlyphIDHash {
+        uint32_t operator()(SkPackedGlyphID id) const { return id.hash(); }
+    };
+
+    SkStrikeStore(SkString path, size_t maxBytes);
+
+    bool load(const SkData&);
+    Strike* internalFindOrAddStrike(const SkString& key);
+    uint64_t fontHash(SkTypeface*);
+    bool reserve(size_t bytes);
+
+    const SkString      fPath;
+    const size_t        fMaxBytes;
+    sk_sp<SkData>       fMapped;     // the file we started from
+
+    mutable SkMutex     fMutex;      // guards everything below, and all Strikes
+    size_t              fBytesUsed;
+    SkArenaAlloc        fAlloc{4096};  // copies of newly recorded images and paths
+    SkTArray<std::unique_ptr<Strike>> fStrikes;
+    SkTHashMap<SkString, Strike*>     fStrikesByKey;
+    SkTHashMap<uint32_t, uint64_t>    fFontHashes;   // by typeface unique ID
+
+    friend class Strike;
+};
+
+class SkStrikeStore::Strike {
+public:
+    /** If the store has metrics for glyph's packed ID, fill in its metrics and return true. */
+    bool findMetrics(SkGlyph* glyph) const;
+
+    /** If the store has an image for glyph in glyph's mask format, copy it into glyph.fImage,
+        which must be allocated, and return true.
+    */
+    bool findImage(const SkGlyph& glyph) const;
+
+    /** If the store has the path for the glyph, set path to it and return true. */
+    bool findPath(SkPackedGlyphID, SkPath* path) const;
+
+    void addMetrics(const SkGlyph&);
+    void addImage(const SkGlyph&);
+    void addPath(SkPackedGlyphID, const SkPath&);
+
+private:
+    friend class SkStrikeStore;
+    Strike(SkStrikeStore* store, SkString key) : fStore(store), fKey(std::move(key)) {}
+
+    SkStrikeStore* const fStore;
+    const SkString       fKey;
+    SkTHashMap<SkPackedGlyphID, Glyph, GlyphIDHash> fGlyphs;
+};
+
+#endif
@@ -19,7 +19,7 @@ void SkTaskGroup2D::addColumn() {
 }
 
 void SkTaskGroup2D::finish() {
-    fIsFinishing.store(true, std::memory_order_relaxed);
+    fIsFinishing.store(true, std::memory_order_release);
     fThreadsGroup->wait();
 }
 
@@ -89,3 +89,88 @@ void SkFlexibleTaskGroup2D::work(int threadId) {
         }
     }
 }
+
+SkWorkStealingTaskGroup2D::SkWorkStealingTaskGroup2D(Work2D&& w, int h, SkExecutor* x, int t)
+        : SkTaskGroup2D(std::move(w), h, x, t), fRowData(h) {}
+
+bool SkWorkStealingTaskGroup2D::tryRunRow(int row) {
+    RowData& rowData = fRowData[row];
+    int width = fWidth.load();
+
+    // Cheap checks first so that we don't bounce the cache line of a busy or empty row.
+    if (rowData.fNextColumn.load(std::memory_order_relaxed) >= width ||
+            rowData.fIsClaimed.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    bool expected = false;
+    if (!rowData.fIsClaimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        return false;
+    }
+
+    // Only run the tasks that were ready when we claimed the row, and then give the row back so
+    // that a thread without work may steal it while we go back to our other rows.
+    int column = rowData.fNextColumn.load(std::memory_order_relaxed);
+    bool processed = column < width;
+    for (; column < width; ++column) {
+        fWork(row, column);
+        rowData.fNextColumn.store(column + 1, std::memory_order_relaxed);
+    }
+
+    rowData.fIsClaimed.store(false, std::memory_order_release);
+    return processed;
+}
+
+int SkWorkStealingTaskGroup2D::findVictim(int threadId) const {
+    int width = fWidth.load();
+    int victim = -1;
+    int maxBacklog = 0;
+    for (int i = 0; i < fHeight; ++i) {
+        // Start the scan at a different row on each thread to spread out the thieves.
+        int row = (threadId + i) % fHeight;
+        if (row % fThreadCnt == threadId) {
+            continue;
+        }
+        const RowData& rowData = fRowData[row];
+        int backlog = width - rowData.fNextColumn.load(std::memory_order_relaxed);
+        if (backlog > maxBacklog && !rowData.fIsClaimed.load(std::memory_order_relaxed)) {
+            victim = row;
+            maxBacklog = backlog;
+        }
+    }
+    return victim;
+}
+
+bool SkWorkStealingTaskGroup2D::isDone() const {
+    int width = fWidth.load();
+    for (int row = 0; row < fHeight; ++row) {
+        if (fRowData[row].fNextColumn.load(std::memory_order_acquire) < width) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SkWorkStealingTaskGroup2D::work(int threadId) {
+    while (true) {
+        // Read isFinishing before looking for work: if it's true, no column can be added after we
+        // scan, so finding no work below means that we're out of work for the whole group.
+        bool isFinishing = this->isFinishing();
+
+        bool processed = false;
+        for (int row = threadId; row < fHeight; row += fThreadCnt) {
+            processed |= this->tryRunRow(row);
+        }
+
+        if (!processed) {
+            int victim = this->findVictim(threadId);
+            if (victim >= 0) {
+                processed = this->tryRunRow(victim);
+            }
+        }
+
+        if (!processed && isFinishing && this->isDone()) {
+            return;
+        }
+    }
+}
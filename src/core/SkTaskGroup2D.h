@@ -38,7 +38,7 @@ public:
     void finish(); // wait and finish all tasks (no more tasks can be added after calling this)
 
     SK_ALWAYS_INLINE bool isFinishing() const {
-        return fIsFinishing.load(std::memory_order_relaxed);
+        return fIsFinishing.load(std::memory_order_acquire);
     }
 
 protected:
@@ -105,4 +105,37 @@ private:
     std::vector<ThreadData> fThreadData;
 };
 
+// A work-stealing task group. Row i is owned by thread (i % threadCnt), and each thread drains its
+// own rows first. A thread whose rows have no ready tasks steals the unclaimed row with the largest
+// backlog, so one expensive task only stalls its own row instead of a whole thread's worth of rows.
+// A row is run by at most one thread at a time, so tasks on the same row still execute in order.
+// Unlike SkSpinningTaskGroup2D, height and threadCnt may differ.
+class SkWorkStealingTaskGroup2D final : public SkTaskGroup2D {
+public:
+    SkWorkStealingTaskGroup2D(Work2D&&, int, SkExecutor*, int);
+
+protected:
+    void work(int threadId) override;
+
+private:
+    // alignas(MAX_CACHE_LINE) to avoid false sharing by cache lines
+    struct alignas(MAX_CACHE_LINE) RowData {
+        RowData() : fNextColumn(0), fIsClaimed(false) {}
+
+        std::atomic<int>    fNextColumn; // next column index to be executed
+        std::atomic<bool>   fIsClaimed;  // whether some thread is currently running this row
+    };
+
+    // Claim the row and run all of its tasks that are ready. Return whether any task was run.
+    bool tryRunRow(int row);
+
+    // Return the unclaimed row not owned by threadId with the most ready tasks, or -1 if none.
+    int findVictim(int threadId) const;
+
+    // Return whether all tasks that have been added are done.
+    bool isDone() const;
+
+    std::vector<RowData> fRowData;
+};
+
 #endif//SkTaskGroup2D_DEFINED
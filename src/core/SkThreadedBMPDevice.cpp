@@ -8,35 +8,87 @@
 #include "SkThreadedBMPDevice.h"
 
 #include "SkPath.h"
+#include "SkSpecialImage.h"
 #include "SkTaskGroup.h"
 #include "SkVertices.h"
 
+#include <thread>
+
 void SkThreadedBMPDevice::DrawQueue::reset() {
     if (fTasks) {
         fTasks->finish();
+        fTasks.reset();
     }
 
     fSize = 0;
+    fChunkEnd = 0;
+    for (auto& chunk : fChunks) {
+        if (chunk) {
+            chunk->fAlloc.reset();
+        }
+    }
+}
+
+void SkThreadedBMPDevice::DrawQueue::startTasks() {
+    SkASSERT(!fTasks && fSize == 0);
+
+    fTileProgress = std::vector<TileProgress>(fDevice->fTileCnt);
+    for (auto& progress : fTileProgress) {
+        progress.fNextColumn.store(0, std::memory_order_relaxed);
+    }
 
     // using TaskGroup2D = SkSpinningTaskGroup2D;
-    using TaskGroup2D = SkFlexibleTaskGroup2D;
+    // using TaskGroup2D = SkFlexibleTaskGroup2D;
+    using TaskGroup2D = SkWorkStealingTaskGroup2D;
     auto draw2D = [this](int row, int column){
-        SkThreadedBMPDevice::DrawElement& drawElement = fElements[column];
-        if (!SkIRect::Intersects(fDevice->fTileBounds[row], drawElement.fDrawBounds)) {
-            return;
+        const SkThreadedBMPDevice::DrawElement& drawElement = this->element(column);
+        if (SkIRect::Intersects(fDevice->fTileBounds[row], drawElement.fDrawBounds)) {
+            drawElement.fDrawFn(drawElement.fRecord, fDevice->fTileBounds[row]);
         }
-        drawElement.fDrawFn(fDevice->fTileBounds[row]);
+        fTileProgress[row].fNextColumn.store(column + 1, std::memory_order_release);
     };
     fTasks.reset(new TaskGroup2D(draw2D, fDevice->fTileCnt, fDevice->fExecutor,
                                  fDevice->fThreadCnt));
     fTasks->start();
 }
 
+void SkThreadedBMPDevice::DrawQueue::acquireChunk() {
+    SkASSERT(fSize == fChunkEnd);
+    fChunkEnd = fSize + kChunkSize;
+
+    std::unique_ptr<Chunk>& chunk = fChunks[(fSize / kChunkSize) % kChunkCnt];
+    if (!chunk) {
+        chunk.reset(new Chunk);
+        return;
+    }
+
+    // The chunk still holds columns [fSize - kChunkCnt * kChunkSize, stale). Wait until every
+    // tile is done with them, then recycle the chunk. Tiles only depend on columns that have been
+    // added already, so this can't deadlock.
+    const int stale = fSize - (kChunkCnt - 1) * kChunkSize;
+    if (stale > 0) {
+        for (const auto& progress : fTileProgress) {
+            while (progress.fNextColumn.load(std::memory_order_acquire) < stale) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    chunk->fAlloc.reset();
+}
+
+SkThreadedBMPDevice::SkThreadedBMPDevice(const SkBitmap& bitmap,
+                                         int tiles,
+                                         int threads,
+                                         SkExecutor* executor)
+        : SkThreadedBMPDevice(bitmap, SkSurfaceProps(SkSurfaceProps::kLegacyFontHost_InitType),
+                              tiles, threads, executor) {}
+
 SkThreadedBMPDevice::SkThreadedBMPDevice(const SkBitmap& bitmap,
+                                         const SkSurfaceProps& surfaceProps,
                                          int tiles,
                                          int threads,
                                          SkExecutor* executor)
-        : INHERITED(bitmap)
+        : INHERITED(bitmap, surfaceProps)
         , fTileCnt(tiles)
         , fThreadCnt(threads <= 0 ? tiles : threads)
         , fQueue(this)
@@ -61,6 +113,50 @@ void SkThreadedBMPDevice::flush() {
     fQueue.reset();
 }
 
+SkBaseDevice* SkThreadedBMPDevice::onCreateDevice(const CreateInfo& cinfo, const SkPaint*) {
+    const SkSurfaceProps surfaceProps(this->surfaceProps().flags(), cinfo.fPixelGeometry);
+    sk_sp<SkBitmapDevice> layer(SkBitmapDevice::Create(cinfo.fInfo, surfaceProps,
+                                                       cinfo.fAllocator));
+    if (!layer || cinfo.fAllocator) {
+        return layer.release();
+    }
+
+    // SkCanvas won't draw into us until the layer is restored, so we give our threads to the layer.
+    // The layer's tasks share our executor, so ours must have finished before the layer's start.
+    this->flush();
+    SkThreadedBMPDevice* device = new SkThreadedBMPDevice(layer->fBitmap, surfaceProps, fTileCnt,
+                                                          fThreadCnt, fExecutor);
+    // The layer may outlive us (e.g. in an SkCanvas's layer stack), so it holds its own
+    // reference to a thread pool that we own.
+    device->fInternalExecutor = fInternalExecutor;
+    return device;
+}
+
+sk_sp<SkSpecialImage> SkThreadedBMPDevice::snapSpecial() {
+    this->flush();
+    return INHERITED::snapSpecial();
+}
+
+bool SkThreadedBMPDevice::onReadPixels(const SkPixmap& pm, int x, int y) {
+    this->flush();
+    return INHERITED::onReadPixels(pm, x, y);
+}
+
+bool SkThreadedBMPDevice::onWritePixels(const SkPixmap& pm, int x, int y) {
+    this->flush();
+    return INHERITED::onWritePixels(pm, x, y);
+}
+
+bool SkThreadedBMPDevice::onPeekPixels(SkPixmap* pmap) {
+    this->flush();
+    return INHERITED::onPeekPixels(pmap);
+}
+
+bool SkThreadedBMPDevice::onAccessPixels(SkPixmap* pmap) {
+    this->flush();
+    return INHERITED::onAccessPixels(pmap);
+}
+
 // Having this captured in lambda seems to be faster than saving this in DrawElement
 struct SkThreadedBMPDevice::DrawState {
     SkPixmap fDst;
@@ -69,7 +165,10 @@ struct SkThreadedBMPDevice::DrawState {
 
     explicit DrawState(SkThreadedBMPDevice* dev) {
         // we need fDst to be set, and if we're actually drawing, to dirty the genID
-        if (!dev->accessPixels(&fDst)) {
+        // (we can't call accessPixels() as our onPeekPixels() waits for all queued draws)
+        if (dev->INHERITED::onPeekPixels(&fDst)) {
+            dev->fBitmap.notifyPixelsChanged();
+        } else {
             // NoDrawDevice uses us (why?) so we have to catch this case w/ no pixels
             fDst.reset(dev->imageInfo(), nullptr, 0);
         }
@@ -77,13 +176,15 @@ struct SkThreadedBMPDevice::DrawState {
         fRC = dev->fRCStack.rc();
     }
 
-    SkDraw getThreadDraw(SkRasterClip& threadRC, const SkIRect& threadBounds) const {
+    // Rasterize against the whole clip and only blit inside the tile. Clipping the geometry to
+    // the tile instead would chop anti-aliased edges at tile seams, and then the tiles wouldn't
+    // add up to the pixels of a single SkBitmapDevice draw.
+    SkDraw getThreadDraw(const SkIRect& threadBounds) const {
         SkDraw draw;
         draw.fDst = fDst;
         draw.fMatrix = &fMatrix;
-        threadRC = fRC;
-        threadRC.op(threadBounds, SkRegion::kIntersect_Op);
-        draw.fRC = &threadRC;
+        draw.fRC = &fRC;
+        draw.fBlitBounds = &threadBounds;
         return draw;
     }
 };
@@ -100,15 +201,18 @@ SkIRect SkThreadedBMPDevice::transformDrawBounds(const SkRect& drawBounds) const
 // The do {...} while (false) is to enforce trailing semicolon as suggested by mtklein@
 #define THREADED_DRAW(drawBounds, actualDrawCall)                                                  \
     do {                                                                                           \
+        SkIRect devBounds = this->transformDrawBounds(drawBounds);                                 \
+        if (!devBounds.intersect(fRCStack.rc().getBounds())) {                                     \
+            break; /* clipped out: don't bother queueing it */                                     \
+        }                                                                                          \
         DrawState ds(this);                                                                        \
-        fQueue.push({                                                                              \
-            this->transformDrawBounds(drawBounds),                                                 \
+        fQueue.push(                                                                               \
+            devBounds,                                                                             \
             [=](const SkIRect& tileBounds) {                                                       \
-                SkRasterClip tileRC;                                                               \
-                SkDraw draw = ds.getThreadDraw(tileRC, tileBounds);                                \
+                SkDraw draw = ds.getThreadDraw(tileBounds);                                        \
                 draw.actualDrawCall;                                                               \
-            },                                                                                     \
-        });                                                                                        \
+            }                                                                                      \
+        );                                                                                         \
     } while (false)
 
 static inline SkRect get_fast_bounds(const SkRect& r, const SkPaint& p) {
@@ -129,7 +233,8 @@ void SkThreadedBMPDevice::drawPoints(SkCanvas::PointMode mode, size_t count,
         const SkPoint pts[], const SkPaint& paint) {
     // TODO tighter drawBounds
     SkRect drawBounds = SkRect::MakeLargest();
-    THREADED_DRAW(drawBounds, drawPoints(mode, count, pts, paint, nullptr));
+    const SkPoint* ptsCopy = fQueue.copy(pts, count);
+    THREADED_DRAW(drawBounds, drawPoints(mode, count, ptsCopy, paint, nullptr));
 }
 
 void SkThreadedBMPDevice::drawRect(const SkRect& r, const SkPaint& paint) {
@@ -155,17 +260,21 @@ void SkThreadedBMPDevice::drawPath(const SkPath& path, const SkPaint& paint,
         const SkMatrix* prePathMatrix, bool pathIsMutable) {
     SkRect drawBounds = path.isInverseFillType() ? SkRect::MakeLargest()
                                                  : get_fast_bounds(path.getBounds(), paint);
+    if (prePathMatrix) {
+        prePathMatrix->mapRect(&drawBounds);
+    }
+    const SkMatrix* prePathMatrixCopy = fQueue.copy(prePathMatrix, 1);
     // For thread safety, make path imutable
-    THREADED_DRAW(drawBounds, drawPath(path, paint, prePathMatrix, false));
+    THREADED_DRAW(drawBounds, drawPath(path, paint, prePathMatrixCopy, false));
 }
 
-void SkThreadedBMPDevice::drawBitmap(const SkBitmap& bitmap, SkScalar x, SkScalar y,
-        const SkPaint& paint) {
-    SkMatrix matrix = SkMatrix::MakeTrans(x, y);
-    LogDrawScaleFactor(SkMatrix::Concat(this->ctm(), matrix), paint.getFilterQuality());
-    SkRect drawBounds = SkRect::MakeWH(bitmap.width(), bitmap.height());
+void SkThreadedBMPDevice::drawBitmapWithMatrix(const SkBitmap& bitmap, const SkMatrix& matrix,
+        const SkRect* dstOrNull, const SkPaint& paint) {
+    SkRect drawBounds = dstOrNull ? *dstOrNull : SkRect::MakeIWH(bitmap.width(), bitmap.height());
     matrix.mapRect(&drawBounds);
-    THREADED_DRAW(drawBounds, drawBitmap(bitmap, matrix, nullptr, paint));
+    drawBounds = get_fast_bounds(drawBounds, paint);
+    const SkRect* dstCopy = fQueue.copy(dstOrNull, 1);
+    THREADED_DRAW(drawBounds, drawBitmap(bitmap, matrix, dstCopy, paint));
 }
 
 void SkThreadedBMPDevice::drawSprite(const SkBitmap& bitmap, int x, int y, const SkPaint& paint) {
@@ -176,28 +285,36 @@ void SkThreadedBMPDevice::drawSprite(const SkBitmap& bitmap, int x, int y, const
 void SkThreadedBMPDevice::drawText(const void* text, size_t len, SkScalar x, SkScalar y,
         const SkPaint& paint) {
     SkRect drawBounds = SkRect::MakeLargest(); // TODO tighter drawBounds
-    THREADED_DRAW(drawBounds, drawText((const char*)text, len, x, y, paint, &this->surfaceProps()));
+    const char* textCopy = fQueue.copy((const char*)text, len);
+    THREADED_DRAW(drawBounds, drawText(textCopy, len, x, y, paint, &this->surfaceProps()));
 }
 
 void SkThreadedBMPDevice::drawPosText(const void* text, size_t len, const SkScalar xpos[],
         int scalarsPerPos, const SkPoint& offset, const SkPaint& paint) {
     SkRect drawBounds = SkRect::MakeLargest(); // TODO tighter drawBounds
-    THREADED_DRAW(drawBounds, drawPosText((const char*)text, len, xpos, scalarsPerPos, offset,
+    const char* textCopy = fQueue.copy((const char*)text, len);
+    const SkScalar* xposCopy = fQueue.copy(xpos, paint.countText(text, len) * scalarsPerPos);
+    THREADED_DRAW(drawBounds, drawPosText(textCopy, len, xposCopy, scalarsPerPos, offset,
                                           paint, &surfaceProps()));
 }
 
 void SkThreadedBMPDevice::drawVertices(const SkVertices* vertices, SkBlendMode bmode,
         const SkPaint& paint) {
-    SkRect drawBounds = SkRect::MakeLargest(); // TODO tighter drawBounds
-    THREADED_DRAW(drawBounds, drawVertices(vertices->mode(), vertices->vertexCount(),
-                                           vertices->positions(), vertices->texCoords(),
-                                           vertices->colors(), bmode, vertices->indices(),
-                                           vertices->indexCount(), paint));
+    SkRect drawBounds = get_fast_bounds(vertices->bounds(), paint);
+    // Vertices are often temporaries (e.g., from drawAtlas or drawShadow), so keep them alive.
+    sk_sp<const SkVertices> v = sk_ref_sp(vertices);
+    THREADED_DRAW(drawBounds, drawVertices(v->mode(), v->vertexCount(), v->positions(),
+                                           v->texCoords(), v->colors(), bmode, v->indices(),
+                                           v->indexCount(), paint));
 }
 
 void SkThreadedBMPDevice::drawDevice(SkBaseDevice* device, int x, int y, const SkPaint& paint) {
     SkASSERT(!paint.getImageFilter());
+    // The layer may have draws of its own in flight.
+    device->flush();
     SkRect drawBounds = SkRect::MakeXYWH(x, y, device->width(), device->height());
-    THREADED_DRAW(drawBounds,
-                  drawSprite(static_cast<SkBitmapDevice*>(device)->fBitmap, x, y, paint));
+    // Capture a copy of the bitmap (which refs the pixels) as the device may be gone by the time
+    // the tiles draw it.
+    const SkBitmap& bitmap = static_cast<SkBitmapDevice*>(device)->fBitmap;
+    THREADED_DRAW(drawBounds, drawSprite(bitmap, x, y, paint));
 }
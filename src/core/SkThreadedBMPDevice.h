@@ -8,6 +8,7 @@
 #ifndef SkThreadedBMPDevice_DEFINED
 #define SkThreadedBMPDevice_DEFINED
 
+#include "SkArenaAlloc.h"
 #include "SkBitmapDevice.h"
 #include "SkDraw.h"
 #include "SkTaskGroup2D.h"
@@ -18,6 +19,8 @@ public:
     // When executor = nullptr, we manages the thread pool. Otherwise, the caller manages it.
     SkThreadedBMPDevice(const SkBitmap& bitmap, int tiles, int threads = 0,
                         SkExecutor* executor = nullptr);
+    SkThreadedBMPDevice(const SkBitmap& bitmap, const SkSurfaceProps& surfaceProps, int tiles,
+                        int threads = 0, SkExecutor* executor = nullptr);
 
     ~SkThreadedBMPDevice() override { fQueue.finish(); }
 
@@ -30,7 +33,8 @@ protected:
 
     void drawPath(const SkPath&, const SkPaint&, const SkMatrix* prePathMatrix,
                   bool pathIsMutable) override;
-    void drawBitmap(const SkBitmap&, SkScalar x, SkScalar y, const SkPaint&) override;
+    void drawBitmapWithMatrix(const SkBitmap&, const SkMatrix&, const SkRect* dstOrNull,
+                              const SkPaint&) override;
     void drawSprite(const SkBitmap&, int x, int y, const SkPaint&) override;
 
     void drawText(const void* text, size_t len, SkScalar x, SkScalar y,
@@ -40,41 +44,119 @@ protected:
     void drawVertices(const SkVertices*, SkBlendMode, const SkPaint&) override;
     void drawDevice(SkBaseDevice*, int x, int y, const SkPaint&) override;
 
+    sk_sp<SkSpecialImage> snapSpecial() override;
+
+    // Anything that reads or writes our pixels directly has to wait for the queued draws.
+    bool onReadPixels(const SkPixmap&, int x, int y) override;
+    bool onWritePixels(const SkPixmap&, int x, int y) override;
+    bool onPeekPixels(SkPixmap*) override;
+    bool onAccessPixels(SkPixmap*) override;
+
     void flush() override;
 
 private:
     struct DrawState;
 
+    SkBaseDevice* onCreateDevice(const CreateInfo&, const SkPaint*) override;
+
+    // A draw record is a functor that draws into one tile. It's allocated in the arena of the chunk
+    // that holds its DrawElement, so pushing a draw doesn't need any std::function heap allocation.
     struct DrawElement {
-        SkIRect fDrawBounds;
-        std::function<void(const SkIRect& threadBounds)> fDrawFn;
+        using DrawFn = void(*)(const void* record, const SkIRect& tileBounds);
+
+        SkIRect     fDrawBounds;
+        DrawFn      fDrawFn;
+        const void* fRecord;
     };
 
+    // The queue is a ring of kChunkCnt chunks with kChunkSize elements each. Chunks are allocated
+    // lazily, so a device that draws little stays small. When the ring is full, push() only waits
+    // for the slowest tile to get past the oldest chunk, and then recycles that chunk. Hence memory
+    // is bounded and we never have to stall on all tiles in the middle of a frame.
     class DrawQueue {
     public:
-        static constexpr int MAX_QUEUE_SIZE = 100000;
+        static constexpr int kChunkSize = 256;
+        static constexpr int kChunkCnt = 32;
 
         DrawQueue(SkThreadedBMPDevice* device) : fDevice(device) {}
+
+        // Wait for all queued draws and empty the queue. The tasks are started again lazily by the
+        // next push(), so an idle device doesn't keep the executor's threads busy.
         void reset();
 
-        // For ~SkThreadedBMPDevice() to shutdown tasks, we use this instead of reset because reset
-        // will start new tasks.
-        void finish() { fTasks->finish(); }
+        // For ~SkThreadedBMPDevice() to shutdown tasks.
+        void finish() {
+            if (fTasks) {
+                fTasks->finish();
+            }
+        }
+
+        // Copy count elements of a POD array into storage that lives as long as the next pushed
+        // draw record. Draw calls only lend us their arrays, so records must not point to them.
+        template <typename T>
+        const T* copy(const T* src, size_t count) {
+            static_assert(std::is_trivially_copyable<T>::value, "");
+            if (!src || !count) {
+                return nullptr;
+            }
+            T* dst = this->currentChunk()->fAlloc.template makeArrayDefault<T>(count);
+            memcpy(dst, src, count * sizeof(T));
+            return dst;
+        }
+
+        template <typename T>
+        SK_ALWAYS_INLINE void push(const SkIRect& drawBounds, T&& drawFn) {
+            using Record = typename std::decay<T>::type;
 
-        SK_ALWAYS_INLINE void push(DrawElement&& element) {
-            if (fSize == MAX_QUEUE_SIZE) {
-                this->reset();
+            if (!fTasks) {
+                this->startTasks();
             }
-            SkASSERT(fSize < MAX_QUEUE_SIZE);
-            fElements[fSize++] = std::move(element);
+            Chunk* chunk = this->currentChunk();
+            DrawElement& element = chunk->fElements[fSize % kChunkSize];
+            element.fDrawBounds = drawBounds;
+            element.fRecord = chunk->fAlloc.make<Record>(std::forward<T>(drawFn));
+            element.fDrawFn = [](const void* record, const SkIRect& tileBounds) {
+                (*static_cast<const Record*>(record))(tileBounds);
+            };
+            fSize++;
             fTasks->addColumn();
         }
 
     private:
+        static constexpr int kRecordStorageSize = kChunkSize * 256;
+
+        struct Chunk {
+            DrawElement                         fElements[kChunkSize];
+            SkSTArenaAlloc<kRecordStorageSize>  fAlloc;
+        };
+
+        // alignas(64) to avoid false sharing by cache lines
+        struct alignas(64) TileProgress {
+            std::atomic<int> fNextColumn; // all columns before this are done on this tile
+        };
+
+        void startTasks();
+
+        // Return the chunk that holds the next pushed column, waiting for and recycling an old
+        // chunk if the ring is full.
+        SK_ALWAYS_INLINE Chunk* currentChunk() {
+            if (fSize >= fChunkEnd) {
+                this->acquireChunk();
+            }
+            return fChunks[(fSize / kChunkSize) % kChunkCnt].get();
+        }
+        void acquireChunk();
+
+        const DrawElement& element(int column) const {
+            return fChunks[(column / kChunkSize) % kChunkCnt]->fElements[column % kChunkSize];
+        }
+
         SkThreadedBMPDevice*            fDevice;
         std::unique_ptr<SkTaskGroup2D>  fTasks;
-        DrawElement                     fElements[MAX_QUEUE_SIZE];
-        int                             fSize;
+        std::unique_ptr<Chunk>          fChunks[kChunkCnt];
+        std::vector<TileProgress>       fTileProgress;
+        int                             fSize = 0;
+        int                             fChunkEnd = 0; // the first column after current chunk
     };
 
     SkIRect transformDrawBounds(const SkRect& drawBounds) const;
@@ -88,9 +170,10 @@ private:
      * 1. fInternalExecutor.get() which means that we're managing the thread pool's life cycle.
      * 2. provided by our caller which means that our caller is managing the threads' life cycle.
      * In the 2nd case, fInternalExecutor == nullptr.
+     * Layer devices share our fInternalExecutor, so it lives as long as the last of them.
      */
     SkExecutor* fExecutor = nullptr;
-    std::unique_ptr<SkExecutor> fInternalExecutor;
+    std::shared_ptr<SkExecutor> fInternalExecutor;
 
     DrawQueue fQueue;
 
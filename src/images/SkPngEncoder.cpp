@@ -10,14 +10,20 @@
 #ifdef SK_HAS_PNG_LIBRARY
 
 #include "SkColorTable.h"
+#include "SkExecutor.h"
 #include "SkImageEncoderFns.h"
 #include "SkImageInfoPriv.h"
 #include "SkStream.h"
 #include "SkString.h"
 #include "SkPngEncoder.h"
 #include "SkPngPriv.h"
+#include "SkTaskGroup.h"
 
 #include "png.h"
+#include "zlib.h"
+
+#include <atomic>
+#include <vector>
 
 static_assert(PNG_FILTER_NONE  == (int)SkPngEncoder::FilterFlag::kNone,  "Skia libpng filter err.");
 static_assert(PNG_FILTER_SUB   == (int)SkPngEncoder::FilterFlag::kSub,   "Skia libpng filter err.");
@@ -56,11 +62,19 @@ public:
     bool setColorSpace(const SkImageInfo& info);
     bool writeInfo(const SkImageInfo& srcInfo);
     void chooseProc(const SkImageInfo& srcInfo, SkTransferFunctionBehavior unpremulBehavior);
+    void setExecutor(const SkImageInfo& srcInfo, SkExecutor* executor);
+
+    /*
+     * Filters and compresses |numRows| rows starting at |y| in strips on the executor,
+     * then writes them as IDAT chunks.  Also finishes the png once the last row is written.
+     */
+    bool encodeStrips(const SkPixmap& src, int y, int numRows);
 
     png_structp pngPtr() { return fPngPtr; }
     png_infop infoPtr() { return fInfoPtr; }
     int pngBytesPerPixel() const { return fPngBytesPerPixel; }
     transform_scanline_proc proc() const { return fProc; }
+    SkExecutor* executor() const { return fExecutor; }
 
     ~SkPngEncoderMgr() {
         png_destroy_write_struct(&fPngPtr, &fInfoPtr);
@@ -71,12 +85,27 @@ private:
     SkPngEncoderMgr(png_structp pngPtr, png_infop infoPtr)
         : fPngPtr(pngPtr)
         , fInfoPtr(infoPtr)
+        , fExecutor(nullptr)
     {}
 
+    void transformRow(const SkPixmap& src, int y, uint8_t* dst) const;
+    void filterRows(const SkPixmap& src, int y, int numRows, int firstRow, uint8_t* dst) const;
+    bool writeIDATs(std::vector<std::vector<uint8_t>>* strips, bool first, bool last);
+
     png_structp             fPngPtr;
     png_infop               fInfoPtr;
     int                     fPngBytesPerPixel;
     transform_scanline_proc fProc;
+
+    // Only used when encoding in strips on fExecutor.
+    SkExecutor*             fExecutor;
+    int                     fZLibLevel;
+    int                     fFilters;
+    int                     fFilterBytesPerPixel;  // May be less than fPngBytesPerPixel.
+    size_t                  fFilterRowBytes;
+    std::vector<uint8_t>    fPrevRow;              // Unfiltered, zero before the first row.
+    std::vector<uint8_t>    fWindow;               // Last filtered bytes, the next dictionary.
+    uLong                   fAdler;
 };
 
 std::unique_ptr<SkPngEncoderMgr> SkPngEncoderMgr::Make(SkWStream* stream) {
@@ -173,6 +202,8 @@ bool SkPngEncoderMgr::setHeader(const SkImageInfo& srcInfo, const SkPngEncoder::
     int zlibLevel = SkTMin(SkTMax(0, options.fZLibLevel), 9);
     SkASSERT(zlibLevel == options.fZLibLevel);
     png_set_compression_level(fPngPtr, zlibLevel);
+    fZLibLevel = zlibLevel;
+    fFilters = filters;
 
     // Set comments in tEXt chunk
     const sk_sp<SkDataTable>& comments = options.fComments;
@@ -322,6 +353,311 @@ void SkPngEncoderMgr::chooseProc(const SkImageInfo& srcInfo,
     fProc = choose_proc(srcInfo, unpremulBehavior);
 }
 
+void SkPngEncoderMgr::setExecutor(const SkImageInfo& srcInfo, SkExecutor* executor) {
+    fExecutor = executor;
+    if (!fExecutor) {
+        return;
+    }
+
+    // Opaque F16 rows are transformed as RGBA, but written as RGB (see writeInfo()).
+    fFilterBytesPerPixel = fPngBytesPerPixel;
+    if (kRGBA_F16_SkColorType == srcInfo.colorType() &&
+        kOpaque_SkAlphaType == srcInfo.alphaType())
+    {
+        fFilterBytesPerPixel = 6;
+    }
+    fFilterRowBytes = fFilterBytesPerPixel * srcInfo.width();
+    if (0 == fFilters) {
+        // libpng picks its own filters when none are set.  Every format we write is 8 or 16
+        // bits per channel, so that means all of them.
+        fFilters = PNG_ALL_FILTERS;
+    }
+    fPrevRow.assign(fPngBytesPerPixel * srcInfo.width(), 0);
+    fWindow.clear();
+    fAdler = adler32(0L, Z_NULL, 0);
+}
+
+// Strips are compressed independently, each primed with the tail of the strip before it, so
+// the only cost over a serial stream is an empty stored block per strip.  Larger strips
+// compress slightly better, smaller strips balance across threads better.
+static constexpr size_t kPngStripBytes  = 128 * 1024;
+static constexpr size_t kZLibWindowSize = 32 * 1024;
+
+static inline uint8_t paeth_predictor(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = SkTAbs(p - a);
+    int pb = SkTAbs(p - b);
+    int pc = SkTAbs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+static void filter_row(int filter, const uint8_t* row, const uint8_t* prior, int bpp, size_t len,
+                       uint8_t* dst) {
+    dst[0] = filter;
+    dst++;
+    switch (filter) {
+        case PNG_FILTER_VALUE_NONE:
+            memcpy(dst, row, len);
+            break;
+        case PNG_FILTER_VALUE_SUB:
+            for (size_t i = 0; i < len; i++) {
+                dst[i] = row[i] - (i >= (size_t) bpp ? row[i - bpp] : 0);
+            }
+            break;
+        case PNG_FILTER_VALUE_UP:
+            for (size_t i = 0; i < len; i++) {
+                dst[i] = row[i] - prior[i];
+            }
+            break;
+        case PNG_FILTER_VALUE_AVG:
+            for (size_t i = 0; i < len; i++) {
+                int left = i >= (size_t) bpp ? row[i - bpp] : 0;
+                dst[i] = row[i] - ((left + prior[i]) >> 1);
+            }
+            break;
+        case PNG_FILTER_VALUE_PAETH:
+            for (size_t i = 0; i < len; i++) {
+                int left = 0, upLeft = 0;
+                if (i >= (size_t) bpp) {
+                    left = row[i - bpp];
+                    upLeft = prior[i - bpp];
+                }
+                dst[i] = row[i] - paeth_predictor(left, prior[i], upLeft);
+            }
+            break;
+        default:
+            SkASSERT(false);
+            break;
+    }
+}
+
+// libpng's heuristic: the sum of the filtered bytes, treated as signed, estimates how well the
+// row will compress.
+static uint32_t filtered_row_cost(const uint8_t* filtered, size_t len) {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < len; i++) {
+        sum += filtered[i] < 128 ? filtered[i] : 256 - filtered[i];
+    }
+    return sum;
+}
+
+void SkPngEncoderMgr::transformRow(const SkPixmap& src, int y, uint8_t* dst) const {
+    fProc((char*) dst, (const char*) src.addr(0, y), src.width(),
+          SkColorTypeBytesPerPixel(src.colorType()), nullptr);
+
+    if (fFilterBytesPerPixel != fPngBytesPerPixel) {
+        // Drop the 16-bit alpha channel in place, as png_set_filler() would.
+        SkASSERT(8 == fPngBytesPerPixel && 6 == fFilterBytesPerPixel);
+        for (int x = 0; x < src.width(); x++) {
+            memmove(dst + 6 * x, dst + 8 * x, 6);
+        }
+    }
+}
+
+void SkPngEncoderMgr::filterRows(const SkPixmap& src, int y, int numRows, int firstRow,
+                                 uint8_t* dst) const {
+    const size_t len = fFilterRowBytes;
+    SkAutoTMalloc<uint8_t> storage(2 * fPrevRow.size() + 2 * (len + 1));
+    uint8_t* row = storage.get();
+    uint8_t* prior = row + fPrevRow.size();
+    uint8_t* candidate = prior + fPrevRow.size();
+    uint8_t* best = candidate + len + 1;
+
+    // The prior row may belong to another strip, or to an earlier call to encodeRows().
+    if (y == firstRow) {
+        memcpy(prior, fPrevRow.data(), fPrevRow.size());
+    } else {
+        this->transformRow(src, y - 1, prior);
+    }
+
+    static const int kFilterFlags[] = {
+        PNG_FILTER_NONE, PNG_FILTER_SUB, PNG_FILTER_UP, PNG_FILTER_AVG, PNG_FILTER_PAETH,
+    };
+    static const int kFilterValues[] = {
+        PNG_FILTER_VALUE_NONE, PNG_FILTER_VALUE_SUB, PNG_FILTER_VALUE_UP, PNG_FILTER_VALUE_AVG,
+        PNG_FILTER_VALUE_PAETH,
+    };
+
+    for (int i = 0; i < numRows; i++) {
+        this->transformRow(src, y + i, row);
+
+        uint8_t* out = dst + i * (len + 1);
+        uint32_t bestCost = UINT32_MAX;
+        for (int f = 0; f < (int) SK_ARRAY_COUNT(kFilterFlags); f++) {
+            if (!(fFilters & kFilterFlags[f])) {
+                continue;
+            }
+
+            filter_row(kFilterValues[f], row, prior, fFilterBytesPerPixel, len, candidate);
+            uint32_t cost = filtered_row_cost(candidate + 1, len);
+            if (cost < bestCost) {
+                bestCost = cost;
+                std::swap(candidate, best);
+            }
+        }
+
+        memcpy(out, best, len + 1);
+        std::swap(row, prior);
+    }
+}
+
+static bool deflate_strip(const uint8_t* data, size_t len, const uint8_t* dict, size_t dictLen,
+                          int level, int strategy, bool finish, std::vector<uint8_t>* dst) {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // Negative window bits write a raw deflate stream.  The zlib header and adler32 trailer
+    // are written once for the whole image.
+    if (Z_OK != deflateInit2(&stream, level, Z_DEFLATED, -15, 8, strategy)) {
+        return false;
+    }
+
+    bool success = true;
+    if (dictLen > 0 && Z_OK != deflateSetDictionary(&stream, dict, dictLen)) {
+        success = false;
+    }
+
+    dst->resize(deflateBound(&stream, len) + 16);
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = len;
+    stream.next_out = dst->data();
+    stream.avail_out = dst->size();
+
+    // A sync flush byte-aligns the output so the next strip can be appended directly.
+    const int flush = finish ? Z_FINISH : Z_SYNC_FLUSH;
+    while (success) {
+        int result = deflate(&stream, flush);
+        if (Z_STREAM_ERROR == result) {
+            success = false;
+            break;
+        }
+
+        if (0 == stream.avail_in && stream.avail_out > 0 && (!finish || Z_STREAM_END == result)) {
+            break;
+        }
+
+        size_t used = dst->size() - stream.avail_out;
+        dst->resize(2 * dst->size());
+        stream.next_out = dst->data() + used;
+        stream.avail_out = dst->size() - used;
+    }
+
+    dst->resize(dst->size() - stream.avail_out);
+    deflateEnd(&stream);
+    return success;
+}
+
+bool SkPngEncoderMgr::encodeStrips(const SkPixmap& src, int y, int numRows) {
+    const size_t filteredRowBytes = fFilterRowBytes + 1;
+    const int rowsPerStrip = SkTMax(1, (int) (kPngStripBytes / filteredRowBytes));
+    const int numStrips = (numRows + rowsPerStrip - 1) / rowsPerStrip;
+    const bool first = (0 == y);
+    const bool last = (src.height() == y + numRows);
+    const int strategy = (fFilters & ~PNG_FILTER_NONE) ? Z_FILTERED : Z_DEFAULT_STRATEGY;
+
+    SkAutoTMalloc<uint8_t> filtered(numRows * filteredRowBytes);
+    std::vector<std::vector<uint8_t>> strips(numStrips);
+    std::vector<uLong> adlers(numStrips);
+    std::atomic<bool> success{true};
+
+    auto stripRows = [&](int s, int* start, int* count) {
+        *start = s * rowsPerStrip;
+        *count = SkTMin(rowsPerStrip, numRows - *start);
+    };
+
+    SkTaskGroup tg(*fExecutor);
+    tg.batch(numStrips, [&](int s) {
+        int start, count;
+        stripRows(s, &start, &count);
+        this->filterRows(src, y + start, count, y, filtered.get() + start * filteredRowBytes);
+    });
+    tg.wait();
+
+    // Every strip but the first in a call is at least kZLibWindowSize bytes, so each dictionary
+    // comes entirely from the previous strip or, for the first, from the previous call.
+    tg.batch(numStrips, [&](int s) {
+        int start, count;
+        stripRows(s, &start, &count);
+        const uint8_t* data = filtered.get() + start * filteredRowBytes;
+        size_t len = count * filteredRowBytes;
+
+        const uint8_t* dict = fWindow.data();
+        size_t dictLen = fWindow.size();
+        if (s > 0) {
+            dictLen = SkTMin(kZLibWindowSize, start * filteredRowBytes);
+            dict = data - dictLen;
+        }
+
+        adlers[s] = adler32(adler32(0L, Z_NULL, 0), data, len);
+        if (!deflate_strip(data, len, dict, dictLen, fZLibLevel, strategy,
+                           last && s == numStrips - 1, &strips[s])) {
+            success = false;
+        }
+    });
+    tg.wait();
+
+    if (!success) {
+        return false;
+    }
+
+    for (int s = 0; s < numStrips; s++) {
+        int start, count;
+        stripRows(s, &start, &count);
+        fAdler = adler32_combine(fAdler, adlers[s], count * filteredRowBytes);
+    }
+
+    const size_t totalBytes = numRows * filteredRowBytes;
+    const uint8_t* begin = filtered.get();
+    const uint8_t* end = begin + totalBytes;
+    if (totalBytes >= kZLibWindowSize) {
+        fWindow.assign(end - kZLibWindowSize, end);
+    } else {
+        fWindow.insert(fWindow.end(), begin, end);
+        if (fWindow.size() > kZLibWindowSize) {
+            fWindow.erase(fWindow.begin(), fWindow.end() - kZLibWindowSize);
+        }
+    }
+    this->transformRow(src, y + numRows - 1, fPrevRow.data());
+
+    return this->writeIDATs(&strips, first, last);
+}
+
+bool SkPngEncoderMgr::writeIDATs(std::vector<std::vector<uint8_t>>* strips, bool first,
+                                 bool last) {
+    if (first) {
+        // 32K window, no preset dictionary, and the same level hint zlib would write.
+        uint8_t levelFlags = fZLibLevel < 2 ? 0 : fZLibLevel < 6 ? 1 : fZLibLevel == 6 ? 2 : 3;
+        uint8_t header[2] = { 0x78, (uint8_t) (levelFlags << 6) };
+        header[1] += 31 - ((header[0] << 8) + header[1]) % 31;
+        strips->front().insert(strips->front().begin(), header, header + 2);
+    }
+    if (last) {
+        uint8_t trailer[4] = {
+            (uint8_t) (fAdler >> 24), (uint8_t) (fAdler >> 16),
+            (uint8_t) (fAdler >>  8), (uint8_t) (fAdler >>  0),
+        };
+        strips->back().insert(strips->back().end(), trailer, trailer + 4);
+    }
+
+    if (setjmp(png_jmpbuf(fPngPtr))) {
+        return false;
+    }
+
+    for (const std::vector<uint8_t>& strip : *strips) {
+        png_write_chunk(fPngPtr, (png_bytep) "IDAT", (png_bytep) strip.data(), strip.size());
+    }
+
+    // libpng did not see the IDATs, so png_write_end() would reject the stream.  The text
+    // chunks were all written before the image data, so IEND is all that is left.
+    if (last) {
+        png_write_chunk(fPngPtr, (png_bytep) "IEND", nullptr, 0);
+    }
+
+    return true;
+}
+
 std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& src,
                                               const Options& options) {
     if (!SkPixmapIsValid(src, options.fUnpremulBehavior)) {
@@ -346,6 +682,7 @@ std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& sr
     }
 
     encoderMgr->chooseProc(src.info(), options.fUnpremulBehavior);
+    encoderMgr->setExecutor(src.info(), options.fExecutor);
 
     return std::unique_ptr<SkPngEncoder>(new SkPngEncoder(std::move(encoderMgr), src));
 }
@@ -358,6 +695,15 @@ SkPngEncoder::SkPngEncoder(std::unique_ptr<SkPngEncoderMgr> encoderMgr, const Sk
 SkPngEncoder::~SkPngEncoder() {}
 
 bool SkPngEncoder::onEncodeRows(int numRows) {
+    if (fEncoderMgr->executor()) {
+        if (!fEncoderMgr->encodeStrips(fSrc, fCurrRow, numRows)) {
+            return false;
+        }
+
+        fCurrRow += numRows;
+        return true;
+    }
+
     if (setjmp(png_jmpbuf(fEncoderMgr->pngPtr()))) {
         return false;
     }
@@ -108,6 +108,14 @@ extern "C" {
         SK_RASTER_PIPELINE_STAGES(M)
     #undef M
 
+    #if JUMPER_HAS_SKX_LOWP
+        StartPipelineFn ASM(start_pipeline,skx_lowp);
+        StageFn ASM(just_return,skx_lowp);
+        #define M(st) StageFn ASM(st,skx_lowp);
+            SK_RASTER_PIPELINE_STAGES(M)
+        #undef M
+    #endif
+
 #elif defined(__i386__) || defined(_M_IX86)
     StartPipelineFn ASM(start_pipeline,sse2),
                     ASM(start_pipeline,sse2_lowp);
@@ -139,6 +147,23 @@ extern "C" {
 
 #if SK_JUMPER_USE_ASSEMBLY
     #if defined(__x86_64__) || defined(_M_X64)
+        #if JUMPER_HAS_SKX_LOWP
+            template <SkRasterPipeline::StockStage st>
+            static constexpr StageFn* skx_lowp();
+
+            #define SKX_LOWP(st) \
+                template <> constexpr StageFn* skx_lowp<SkRasterPipeline::st>() {   \
+                    return ASM(st,skx_lowp);                                        \
+                }
+            #define SKX_NOPE(st) \
+                template <> constexpr StageFn* skx_lowp<SkRasterPipeline::st>() {   \
+                    return nullptr;                                                 \
+                }
+        #else
+            #define SKX_LOWP(st)
+            #define SKX_NOPE(st)
+        #endif
+
         template <SkRasterPipeline::StockStage st>
         static constexpr StageFn* hsw_lowp();
 
@@ -149,6 +174,7 @@ extern "C" {
         static constexpr StageFn* sse2_lowp();
 
         #define LOWP(st) \
+            SKX_LOWP(st)                                                        \
             template <> constexpr StageFn* hsw_lowp<SkRasterPipeline::st>() {   \
                 return ASM(st,hsw_lowp);                                        \
             }                                                                   \
@@ -159,6 +185,7 @@ extern "C" {
                 return ASM(st,sse2_lowp);                                       \
             }
         #define NOPE(st) \
+            SKX_NOPE(st)                                                        \
             template <> constexpr StageFn* hsw_lowp<SkRasterPipeline::st>() {   \
                 return nullptr;                                                 \
             }                                                                   \
@@ -219,7 +246,7 @@ extern "C" {
     NOPE(load_f32)  NOPE(load_f32_dst)  NOPE(store_f32)
     LOWP(load_8888) LOWP(load_8888_dst) LOWP(store_8888) LOWP(gather_8888)
     LOWP(load_bgra) LOWP(load_bgra_dst) LOWP(store_bgra) LOWP(gather_bgra)
-    TODO(bilerp_clamp_8888)
+    LOWP(bilerp_clamp_8888)
     TODO(load_u16_be) TODO(load_rgb_u16_be) TODO(store_u16_be)
     NOPE(load_tables_u16_be) NOPE(load_tables_rgb_u16_be) NOPE(load_tables)
     NOPE(load_rgba) NOPE(store_rgba)
@@ -264,6 +291,8 @@ extern "C" {
     #undef LOWP
     #undef TODO
     #undef NOPE
+    #undef SKX_LOWP
+    #undef SKX_NOPE
 #endif
 
 // Engines comprise everything we need to run SkRasterPipelines.
@@ -366,6 +395,17 @@ static SkJumper_Engine choose_engine() {
     static SkJumper_Engine choose_lowp() {
     #if SK_JUMPER_USE_ASSEMBLY
         #if defined(__x86_64__) || defined(_M_X64)
+            #if JUMPER_HAS_SKX_LOWP && !defined(_MSC_VER)  // No _skx stages for Windows yet.
+                if (1 && SkCpu::Supports(SkCpu::SKX)) {
+                    return {
+                    #define M(st) skx_lowp<SkRasterPipeline::st>(),
+                        { SK_RASTER_PIPELINE_STAGES(M) },
+                        ASM(start_pipeline,skx_lowp),
+                        ASM(just_return   ,skx_lowp),
+                    #undef M
+                    };
+                }
+            #endif
             if (1 && SkCpu::Supports(SkCpu::HSW)) {
                 return {
                 #define M(st) hsw_lowp<SkRasterPipeline::st>(),
@@ -418,6 +458,17 @@ static SkJumper_Engine choose_engine() {
     }
 #endif
 
+bool SkRasterPipeline::lowp_supports(StockStage stage) {
+#ifndef SK_JUMPER_DISABLE_8BIT
+    gChooseLowpOnce([]{ gLowp = choose_lowp(); });
+    return stage == SkRasterPipeline::clamp_0
+        || stage == SkRasterPipeline::clamp_1  // No-ops in lowp.
+        || gLowp.stages[stage] != nullptr;
+#else
+    return false;
+#endif
+}
+
 const SkJumper_Engine& SkRasterPipeline::build_pipeline(void** ip) const {
 #ifndef SK_JUMPER_DISABLE_8BIT
     gChooseLowpOnce([]{ gLowp = choose_lowp(); });
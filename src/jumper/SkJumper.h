@@ -40,7 +40,17 @@
     #define JUMPER_HAS_NEON_LOWP
 #endif
 
-static const int SkJumper_kMaxStride = 16;
+// skx_lowp works on 32 pixels at once, so it needs a larger SkJumper_kMaxStride, which changes
+// the ctx layouts every other backend was assembled against.  Only turn this on together with
+// regenerating SkJumper_generated.S and SkJumper_generated_win.S with build_stages.py.
+#define JUMPER_HAS_SKX_LOWP 0
+
+// The most pixels any backend works on at once.
+#if JUMPER_HAS_SKX_LOWP
+    static const int SkJumper_kMaxStride = 32;  // skx_lowp, 32 x 16-bit lanes.
+#else
+    static const int SkJumper_kMaxStride = 16;
+#endif
 
 struct SkJumper_MemoryCtx {
     void* pixels;
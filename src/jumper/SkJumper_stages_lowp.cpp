@@ -12,7 +12,9 @@
 #include "SkJumper.h"
 #include "SkJumper_misc.h"
 
-#if defined(__clang__)  // This file is empty when not compiled by Clang.
+// This file is empty when not compiled by Clang, and for AVX-512 until SkJumper.h turns on
+// JUMPER_HAS_SKX_LOWP.
+#if defined(__clang__) && (JUMPER_HAS_SKX_LOWP || !defined(__AVX512F__))
 
 #if defined(__ARM_NEON)
     #include <arm_neon.h>
@@ -24,6 +26,8 @@
 
 #if !defined(JUMPER_IS_OFFLINE)
     #define WRAP(name) sk_##name##_lowp
+#elif defined(__AVX512F__)
+    #define WRAP(name) sk_##name##_skx_lowp
 #elif defined(__AVX2__)
     #define WRAP(name) sk_##name##_hsw_lowp
 #elif defined(__SSE4_1__)
@@ -32,7 +36,14 @@
     #define WRAP(name) sk_##name##_sse2_lowp
 #endif
 
-#if defined(__AVX2__)
+#if defined(__AVX512F__)
+    using U8  = uint8_t  __attribute__((ext_vector_type(32)));
+    using U16 = uint16_t __attribute__((ext_vector_type(32)));
+    using I16 =  int16_t __attribute__((ext_vector_type(32)));
+    using I32 =  int32_t __attribute__((ext_vector_type(32)));
+    using U32 = uint32_t __attribute__((ext_vector_type(32)));
+    using F   = float    __attribute__((ext_vector_type(32)));
+#elif defined(__AVX2__)
     using U8  = uint8_t  __attribute__((ext_vector_type(16)));
     using U16 = uint16_t __attribute__((ext_vector_type(16)));
     using I16 =  int16_t __attribute__((ext_vector_type(16)));
@@ -195,7 +206,9 @@ SI F mad(F f, F m, F a) { return f*m+a; }
 SI U32 trunc_(F x) { return (U32)cast<I32>(x); }
 
 SI F rcp(F x) {
-#if defined(__AVX2__)
+#if defined(__AVX512F__)
+    return map(x, _mm512_rcp14_ps);
+#elif defined(__AVX2__)
     return map(x, _mm256_rcp_ps);
 #elif defined(__SSE__)
     return map(x, _mm_rcp_ps);
@@ -209,7 +222,9 @@ SI F rcp(F x) {
 #endif
 }
 SI F sqrt_(F x) {
-#if defined(__AVX2__)
+#if defined(__AVX512F__)
+    return map(x, _mm512_sqrt_ps);
+#elif defined(__AVX2__)
     return map(x, _mm256_sqrt_ps);
 #elif defined(__SSE__)
     return map(x, _mm_sqrt_ps);
@@ -233,6 +248,8 @@ SI F sqrt_(F x) {
 SI F floor_(F x) {
 #if defined(__aarch64__)
     return map(x, vrndmq_f32);
+#elif defined(__AVX512F__)
+    return map(x, +[](__m512 v){ return _mm512_roundscale_ps(v, _MM_FROUND_TO_NEG_INF); });
 #elif defined(__AVX2__)
     return map(x, +[](__m256 v){ return _mm256_floor_ps(v); });  // _mm256_floor_ps is a macro...
 #elif defined(__SSE4_1__)
@@ -418,6 +435,24 @@ SI V load(const T* ptr, size_t tail) {
     V v = 0;
     switch (tail & (N-1)) {
         case  0: memcpy(&v, ptr, sizeof(v)); break;
+    #if defined(__AVX512F__)
+        case 31: v[30] = ptr[30];
+        case 30: v[29] = ptr[29];
+        case 29: v[28] = ptr[28];
+        case 28: memcpy(&v, ptr, 28*sizeof(T)); break;
+        case 27: v[26] = ptr[26];
+        case 26: v[25] = ptr[25];
+        case 25: v[24] = ptr[24];
+        case 24: memcpy(&v, ptr, 24*sizeof(T)); break;
+        case 23: v[22] = ptr[22];
+        case 22: v[21] = ptr[21];
+        case 21: v[20] = ptr[20];
+        case 20: memcpy(&v, ptr, 20*sizeof(T)); break;
+        case 19: v[18] = ptr[18];
+        case 18: v[17] = ptr[17];
+        case 17: v[16] = ptr[16];
+        case 16: memcpy(&v, ptr, 16*sizeof(T)); break;
+    #endif
     #if defined(__AVX2__)
         case 15: v[14] = ptr[14];
         case 14: v[13] = ptr[13];
@@ -442,6 +477,24 @@ template <typename V, typename T>
 SI void store(T* ptr, size_t tail, V v) {
     switch (tail & (N-1)) {
         case  0: memcpy(ptr, &v, sizeof(v)); break;
+    #if defined(__AVX512F__)
+        case 31: ptr[30] = v[30];
+        case 30: ptr[29] = v[29];
+        case 29: ptr[28] = v[28];
+        case 28: memcpy(ptr, &v, 28*sizeof(T)); break;
+        case 27: ptr[26] = v[26];
+        case 26: ptr[25] = v[25];
+        case 25: ptr[24] = v[24];
+        case 24: memcpy(ptr, &v, 24*sizeof(T)); break;
+        case 23: ptr[22] = v[22];
+        case 22: ptr[21] = v[21];
+        case 21: ptr[20] = v[20];
+        case 20: memcpy(ptr, &v, 20*sizeof(T)); break;
+        case 19: ptr[18] = v[18];
+        case 18: ptr[17] = v[17];
+        case 17: ptr[16] = v[16];
+        case 16: memcpy(ptr, &v, 16*sizeof(T)); break;
+    #endif
     #if defined(__AVX2__)
         case 15: ptr[14] = v[14];
         case 14: ptr[13] = v[13];
@@ -462,7 +515,37 @@ SI void store(T* ptr, size_t tail, V v) {
     }
 }
 
-#if defined(__AVX2__)
+#if defined(__AVX512F__)
+    template <typename V, typename T>
+    SI V gather(const T* ptr, U32 ix) {
+        return V{ ptr[ix[ 0]], ptr[ix[ 1]], ptr[ix[ 2]], ptr[ix[ 3]],
+                  ptr[ix[ 4]], ptr[ix[ 5]], ptr[ix[ 6]], ptr[ix[ 7]],
+                  ptr[ix[ 8]], ptr[ix[ 9]], ptr[ix[10]], ptr[ix[11]],
+                  ptr[ix[12]], ptr[ix[13]], ptr[ix[14]], ptr[ix[15]],
+                  ptr[ix[16]], ptr[ix[17]], ptr[ix[18]], ptr[ix[19]],
+                  ptr[ix[20]], ptr[ix[21]], ptr[ix[22]], ptr[ix[23]],
+                  ptr[ix[24]], ptr[ix[25]], ptr[ix[26]], ptr[ix[27]],
+                  ptr[ix[28]], ptr[ix[29]], ptr[ix[30]], ptr[ix[31]], };
+    }
+
+    template<>
+    F gather(const float* p, U32 ix) {
+        __m512i lo, hi;
+        split(ix, &lo, &hi);
+
+        return join<F>(_mm512_i32gather_ps(lo, p, 4),
+                       _mm512_i32gather_ps(hi, p, 4));
+    }
+
+    template<>
+    U32 gather(const uint32_t* p, U32 ix) {
+        __m512i lo, hi;
+        split(ix, &lo, &hi);
+
+        return join<U32>(_mm512_i32gather_epi32(lo, p, 4),
+                         _mm512_i32gather_epi32(hi, p, 4));
+    }
+#elif defined(__AVX2__)
     template <typename V, typename T>
     SI V gather(const T* ptr, U32 ix) {
         return V{ ptr[ix[ 0]], ptr[ix[ 1]], ptr[ix[ 2]], ptr[ix[ 3]],
@@ -500,7 +583,12 @@ SI void store(T* ptr, size_t tail, V v) {
 // ~~~~~~ 32-bit memory loads and stores ~~~~~~ //
 
 SI void from_8888(U32 rgba, U16* r, U16* g, U16* b, U16* a) {
-#if 1 && defined(__AVX2__)
+#if 1 && defined(__AVX512F__)
+    // AVX-512 can narrow 32->16 bits directly (vpmovdw), so there's no lane shuffling to undo.
+    auto cast_U16 = [](U32 v) -> U16 {
+        return cast<U16>(v);
+    };
+#elif 1 && defined(__AVX2__)
     // Swap the middle 128-bit lanes to make _mm256_packus_epi32() in cast_U16() work out nicely.
     __m256i _01,_23;
     split(rgba, &_01, &_23);
@@ -600,6 +688,50 @@ STAGE_GP(gather_bgra, const SkJumper_GatherCtx* ctx) {
     from_8888(gather<U32>(ptr, ix), &b, &g, &r, &a);
 }
 
+STAGE_GP(bilerp_clamp_8888, const SkJumper_GatherCtx* ctx) {
+    // (cx,cy) are the center of our sample.
+    F cx = x,
+      cy = y;
+
+    // All sample points are at the same fractional offset (fx,fy).
+    // They're the 4 corners of a logical 1x1 pixel surrounding (x,y) at (0.5,0.5) offsets.
+    F fx = (cx + 0.5f) - floor_(cx + 0.5f),
+      fy = (cy + 0.5f) - floor_(cy + 0.5f);
+
+    // Like the legacy bitmap samplers we weight with 4 bits of subpixel precision,
+    // so the four areas always sum to exactly 256 and our sums all fit in 16 bits.
+    U16 wx = cast<U16>(fx * 16.0f + 0.5f),
+        wy = cast<U16>(fy * 16.0f + 0.5f);
+
+    r = g = b = a = 0;
+
+    for (float dy = -0.5f; dy <= +0.5f; dy += 1.0f)
+    for (float dx = -0.5f; dx <= +0.5f; dx += 1.0f) {
+        // ix_and_ptr() will clamp to the image's bounds for us.
+        const uint32_t* ptr;
+        U32 ix = ix_and_ptr(&ptr, ctx, cx + dx, cy + dy);
+
+        U16 sr,sg,sb,sa;
+        from_8888(gather<U32>(ptr, ix), &sr,&sg,&sb,&sa);
+
+        // At positive offsets, the x-axis contribution to the sample's area is wx,
+        // or (16-wx) at negative x.  Same deal for y.
+        U16 sx = (dx > 0) ? wx : 16 - wx,
+            sy = (dy > 0) ? wy : 16 - wy,
+            area = sx * sy;
+
+        r += sr * area;
+        g += sg * area;
+        b += sb * area;
+        a += sa * area;
+    }
+
+    r = (r + 128) >> 8;
+    g = (g + 128) >> 8;
+    b = (b + 128) >> 8;
+    a = (a + 128) >> 8;
+}
+
 // ~~~~~~ 16-bit memory loads and stores ~~~~~~ //
 
 SI void from_565(U16 rgb, U16* r, U16* g, U16* b) {
@@ -812,7 +944,29 @@ SI void gradient_lookup(const SkJumper_GradientCtx* c, U32 idx, F t,
                         U16* r, U16* g, U16* b, U16* a) {
 
     F fr, fg, fb, fa, br, bg, bb, ba;
-#if defined(__AVX2__)
+#if defined(__AVX512F__)
+    if (c->stopCount <= 16) {
+        __m512i lo, hi;
+        split(idx, &lo, &hi);
+
+        fr = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->fs[0])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->fs[0])));
+        br = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->bs[0])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->bs[0])));
+        fg = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->fs[1])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->fs[1])));
+        bg = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->bs[1])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->bs[1])));
+        fb = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->fs[2])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->fs[2])));
+        bb = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->bs[2])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->bs[2])));
+        fa = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->fs[3])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->fs[3])));
+        ba = join<F>(_mm512_permutexvar_ps(lo, _mm512_loadu_ps(c->bs[3])),
+                     _mm512_permutexvar_ps(hi, _mm512_loadu_ps(c->bs[3])));
+    } else
+#elif defined(__AVX2__)
     if (c->stopCount <=8) {
         __m256i lo, hi;
         split(idx, &lo, &hi);
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCoverageDelta_opts_DEFINED
+#define SkCoverageDelta_opts_DEFINED
+
+#include "SkCoverageDelta.h"
+#include "SkNx.h"
+
+namespace SK_OPTS_NS {
+
+    // Returns {v[0], v[0]+v[1], v[0]+v[1]+v[2], v[0]+v[1]+v[2]+v[3]}.
+    static inline Sk4i prefix_sum(const Sk4i& v) {
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        Sk4i s = v + Sk4i(_mm_slli_si128(v.fVec, 4));
+        return   s + Sk4i(_mm_slli_si128(s.fVec, 8));
+    #elif defined(SK_ARM_HAS_NEON)
+        int32x4_t zero = vdupq_n_s32(0);
+        Sk4i s = v + Sk4i(vextq_s32(zero, v.fVec, 3));
+        return   s + Sk4i(vextq_s32(zero, s.fVec, 2));
+    #else
+        Sk4i s = v + Sk4i(0, v[0], v[1], v[2]);
+        return   s + Sk4i(0, 0, s[0], s[1]);
+    #endif
+    }
+
+    // Returns v[3] in all lanes.
+    static inline Sk4i last_lane(const Sk4i& v) {
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        return _mm_shuffle_epi32(v.fVec, 0xff);
+    #elif defined(SK_ARM_HAS_NEON)
+        return vdupq_n_s32(vgetq_lane_s32(v.fVec, 3));
+    #else
+        return v[3];
+    #endif
+    }
+
+    // Cumulates a row of deltas into coverages 8 at a time, then converts them to alphas.
+    template <typename ToAlpha>
+    static inline void accumulate_coverage_deltas(SkAlpha alphas[], const SkFixed deltas[],
+                                                  int count, const ToAlpha& toAlpha) {
+        SkASSERT(count % SkCoverageDeltaMask::SIMD_WIDTH == 0);
+        Sk4i carry(0);
+        for (int i = 0; i < count; i += 8) {
+            Sk4i lo = prefix_sum(Sk4i::Load(deltas + i    )) + carry,
+                 hi = prefix_sum(Sk4i::Load(deltas + i + 4)) + last_lane(lo);
+            carry = last_lane(hi);
+            SkNx_cast<SkAlpha>(toAlpha(Sk8i(lo, hi))).store(alphas + i);
+        }
+    }
+
+    /*not static*/ inline void coverage_deltas_to_alphas(SkAlpha alphas[], const SkFixed deltas[],
+                                                         int count, bool isEvenOdd,
+                                                         bool isInverse, bool isConvex) {
+        if (isConvex) {
+            accumulate_coverage_deltas(alphas, deltas, count, [=](const Sk8i& c) {
+                return ConvexCoverageToAlpha(c, isInverse);
+            });
+        } else {
+            accumulate_coverage_deltas(alphas, deltas, count, [=](const Sk8i& c) {
+                return CoverageToAlpha(c, isEvenOdd, isInverse);
+            });
+        }
+    }
+
+}  // namespace SK_OPTS_NS
+
+#endif//SkCoverageDelta_opts_DEFINED
@@ -426,6 +426,8 @@ public:
 
     AI SkNx operator + (const SkNx& o) const { return vaddq_u8(fVec, o.fVec); }
     AI SkNx operator - (const SkNx& o) const { return vsubq_u8(fVec, o.fVec); }
+    AI SkNx operator & (const SkNx& o) const { return vandq_u8(fVec, o.fVec); }
+    AI SkNx operator | (const SkNx& o) const { return vorrq_u8(fVec, o.fVec); }
 
     AI static SkNx Min(const SkNx& a, const SkNx& b) { return vminq_u8(a.fVec, b.fVec); }
     AI SkNx operator < (const SkNx& o) const { return vcltq_u8(fVec, o.fVec); }
@@ -9,9 +9,11 @@
 
 #define SK_OPTS_NS sse41
 #include "SkBlitRow_opts.h"
+#include "SkCoverageDelta_opts.h"
 
 namespace SkOpts {
     void Init_sse41() {
-        blit_row_s32a_opaque = sse41::blit_row_s32a_opaque;
+        blit_row_s32a_opaque      = sse41::blit_row_s32a_opaque;
+        coverage_deltas_to_alphas = sse41::coverage_deltas_to_alphas;
     }
 }
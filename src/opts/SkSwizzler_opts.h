@@ -166,6 +166,101 @@ static void inverted_CMYK_to_BGR1_portable(uint32_t* dst, const void* vsrc, int
     }
 }
 
+// The 16-bit formats store each component big-endian.  We keep the high byte, which comes first.
+static void RGB16_to_RGB1_portable(uint32_t dst[], const void* vsrc, int count) {
+    const uint8_t* src = (const uint8_t*)vsrc;
+    for (int i = 0; i < count; i++) {
+        uint8_t r = src[0],
+                g = src[2],
+                b = src[4];
+        src += 6;
+        dst[i] = (uint32_t)0xFF << 24
+               | (uint32_t)b    << 16
+               | (uint32_t)g    <<  8
+               | (uint32_t)r    <<  0;
+    }
+}
+
+static void RGB16_to_BGR1_portable(uint32_t dst[], const void* vsrc, int count) {
+    const uint8_t* src = (const uint8_t*)vsrc;
+    for (int i = 0; i < count; i++) {
+        uint8_t r = src[0],
+                g = src[2],
+                b = src[4];
+        src += 6;
+        dst[i] = (uint32_t)0xFF << 24
+               | (uint32_t)r    << 16
+               | (uint32_t)g    <<  8
+               | (uint32_t)b    <<  0;
+    }
+}
+
+static void RGBA16_to_RGBA_portable(uint32_t dst[], const void* vsrc, int count) {
+    const uint8_t* src = (const uint8_t*)vsrc;
+    for (int i = 0; i < count; i++) {
+        uint8_t r = src[0],
+                g = src[2],
+                b = src[4],
+                a = src[6];
+        src += 8;
+        dst[i] = (uint32_t)a << 24
+               | (uint32_t)b << 16
+               | (uint32_t)g <<  8
+               | (uint32_t)r <<  0;
+    }
+}
+
+static void RGBA16_to_BGRA_portable(uint32_t dst[], const void* vsrc, int count) {
+    const uint8_t* src = (const uint8_t*)vsrc;
+    for (int i = 0; i < count; i++) {
+        uint8_t r = src[0],
+                g = src[2],
+                b = src[4],
+                a = src[6];
+        src += 8;
+        dst[i] = (uint32_t)a << 24
+               | (uint32_t)r << 16
+               | (uint32_t)g <<  8
+               | (uint32_t)b <<  0;
+    }
+}
+
+static void RGBA16_to_rgbA_portable(uint32_t dst[], const void* vsrc, int count) {
+    const uint8_t* src = (const uint8_t*)vsrc;
+    for (int i = 0; i < count; i++) {
+        uint8_t r = src[0],
+                g = src[2],
+                b = src[4],
+                a = src[6];
+        src += 8;
+        b = (b*a+127)/255;
+        g = (g*a+127)/255;
+        r = (r*a+127)/255;
+        dst[i] = (uint32_t)a << 24
+               | (uint32_t)b << 16
+               | (uint32_t)g <<  8
+               | (uint32_t)r <<  0;
+    }
+}
+
+static void RGBA16_to_bgrA_portable(uint32_t dst[], const void* vsrc, int count) {
+    const uint8_t* src = (const uint8_t*)vsrc;
+    for (int i = 0; i < count; i++) {
+        uint8_t r = src[0],
+                g = src[2],
+                b = src[4],
+                a = src[6];
+        src += 8;
+        b = (b*a+127)/255;
+        g = (g*a+127)/255;
+        r = (r*a+127)/255;
+        dst[i] = (uint32_t)a << 24
+               | (uint32_t)r << 16
+               | (uint32_t)g <<  8
+               | (uint32_t)b <<  0;
+    }
+}
+
 #if defined(SK_ARM_HAS_NEON)
 
 // Rounded divide by 255, (x + 127) / 255
@@ -490,6 +585,109 @@ static void inverted_cmyk_to(uint32_t* dst, const void* vsrc, int count) {
     inverted_cmyk_to<kBGR1>(dst, src, count);
 }
 
+template <bool kSwapRB>
+static void RGB16_insert_alpha_should_swaprb(uint32_t dst[], const void* vsrc, int count) {
+    const uint16_t* src = (const uint16_t*) vsrc;
+    while (count >= 8) {
+        // Load 8 pixels.
+        uint16x8x3_t rgb = vld3q_u16(src);
+
+        // Keep the high byte of each big-endian component, which is the low byte of each lane.
+        uint8x8_t r = vmovn_u16(rgb.val[0]),
+                  g = vmovn_u16(rgb.val[1]),
+                  b = vmovn_u16(rgb.val[2]);
+
+        // Insert an opaque alpha channel and swap if needed.
+        uint8x8x4_t rgba;
+        if (kSwapRB) {
+            rgba.val[0] = b;
+            rgba.val[2] = r;
+        } else {
+            rgba.val[0] = r;
+            rgba.val[2] = b;
+        }
+        rgba.val[1] = g;
+        rgba.val[3] = vdup_n_u8(0xFF);
+
+        // Store 8 pixels.
+        vst4_u8((uint8_t*) dst, rgba);
+        src += 8*3;
+        dst += 8;
+        count -= 8;
+    }
+
+    // Call portable code to finish up the tail of [0,8) pixels.
+    auto proc = kSwapRB ? RGB16_to_BGR1_portable : RGB16_to_RGB1_portable;
+    proc(dst, src, count);
+}
+
+/*not static*/ inline void RGB16_to_RGB1(uint32_t dst[], const void* src, int count) {
+    RGB16_insert_alpha_should_swaprb<false>(dst, src, count);
+}
+
+/*not static*/ inline void RGB16_to_BGR1(uint32_t dst[], const void* src, int count) {
+    RGB16_insert_alpha_should_swaprb<true>(dst, src, count);
+}
+
+template <bool kSwapRB, bool kPremul>
+static void RGBA16_to_8888(uint32_t dst[], const void* vsrc, int count) {
+    const uint16_t* src = (const uint16_t*) vsrc;
+    while (count >= 8) {
+        // Load 8 pixels.
+        uint16x8x4_t rgba16 = vld4q_u16(src);
+
+        // Keep the high byte of each big-endian component, which is the low byte of each lane.
+        uint8x8_t r = vmovn_u16(rgba16.val[0]),
+                  g = vmovn_u16(rgba16.val[1]),
+                  b = vmovn_u16(rgba16.val[2]),
+                  a = vmovn_u16(rgba16.val[3]);
+
+        // Premultiply if requested.
+        if (kPremul) {
+            r = scale(r, a);
+            g = scale(g, a);
+            b = scale(b, a);
+        }
+
+        // Store 8 pixels, swapping if needed.
+        uint8x8x4_t rgba;
+        if (kSwapRB) {
+            rgba.val[0] = b;
+            rgba.val[2] = r;
+        } else {
+            rgba.val[0] = r;
+            rgba.val[2] = b;
+        }
+        rgba.val[1] = g;
+        rgba.val[3] = a;
+        vst4_u8((uint8_t*) dst, rgba);
+        src += 8*4;
+        dst += 8;
+        count -= 8;
+    }
+
+    // Call portable code to finish up the tail of [0,8) pixels.
+    auto proc = kPremul ? (kSwapRB ? RGBA16_to_bgrA_portable : RGBA16_to_rgbA_portable)
+                        : (kSwapRB ? RGBA16_to_BGRA_portable : RGBA16_to_RGBA_portable);
+    proc(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_RGBA(uint32_t dst[], const void* src, int count) {
+    RGBA16_to_8888<false, false>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_BGRA(uint32_t dst[], const void* src, int count) {
+    RGBA16_to_8888<true, false>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_rgbA(uint32_t dst[], const void* src, int count) {
+    RGBA16_to_8888<false, true>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_bgrA(uint32_t dst[], const void* src, int count) {
+    RGBA16_to_8888<true, true>(dst, src, count);
+}
+
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSSE3
 
 // Scale a byte by another.
@@ -502,48 +700,50 @@ static __m128i scale(__m128i x, __m128i y) {
     return _mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(x, y), _128), _257);
 }
 
+// Premultiply 8 RGBA pixels, swapping to BGRA if requested.
 template <bool kSwapRB>
-static void premul_should_swapRB(uint32_t* dst, const void* vsrc, int count) {
-    auto src = (const uint32_t*)vsrc;
-
-    auto premul8 = [](__m128i* lo, __m128i* hi) {
-        const __m128i zeros = _mm_setzero_si128();
-        __m128i planar;
-        if (kSwapRB) {
-            planar = _mm_setr_epi8(2,6,10,14, 1,5,9,13, 0,4,8,12, 3,7,11,15);
-        } else {
-            planar = _mm_setr_epi8(0,4,8,12, 1,5,9,13, 2,6,10,14, 3,7,11,15);
-        }
-
-        // Swizzle the pixels to 8-bit planar.
-        *lo = _mm_shuffle_epi8(*lo, planar);                      // rrrrgggg bbbbaaaa
-        *hi = _mm_shuffle_epi8(*hi, planar);                      // RRRRGGGG BBBBAAAA
-        __m128i rg = _mm_unpacklo_epi32(*lo, *hi),                // rrrrRRRR ggggGGGG
-                ba = _mm_unpackhi_epi32(*lo, *hi);                // bbbbBBBB aaaaAAAA
-
-        // Unpack to 16-bit planar.
-        __m128i r = _mm_unpacklo_epi8(rg, zeros),                 // r_r_r_r_ R_R_R_R_
-                g = _mm_unpackhi_epi8(rg, zeros),                 // g_g_g_g_ G_G_G_G_
-                b = _mm_unpacklo_epi8(ba, zeros),                 // b_b_b_b_ B_B_B_B_
-                a = _mm_unpackhi_epi8(ba, zeros);                 // a_a_a_a_ A_A_A_A_
+static void premul8(__m128i* lo, __m128i* hi) {
+    const __m128i zeros = _mm_setzero_si128();
+    __m128i planar;
+    if (kSwapRB) {
+        planar = _mm_setr_epi8(2,6,10,14, 1,5,9,13, 0,4,8,12, 3,7,11,15);
+    } else {
+        planar = _mm_setr_epi8(0,4,8,12, 1,5,9,13, 2,6,10,14, 3,7,11,15);
+    }
 
-        // Premultiply!
-        r = scale(r, a);
-        g = scale(g, a);
-        b = scale(b, a);
+    // Swizzle the pixels to 8-bit planar.
+    *lo = _mm_shuffle_epi8(*lo, planar);                      // rrrrgggg bbbbaaaa
+    *hi = _mm_shuffle_epi8(*hi, planar);                      // RRRRGGGG BBBBAAAA
+    __m128i rg = _mm_unpacklo_epi32(*lo, *hi),                // rrrrRRRR ggggGGGG
+            ba = _mm_unpackhi_epi32(*lo, *hi);                // bbbbBBBB aaaaAAAA
+
+    // Unpack to 16-bit planar.
+    __m128i r = _mm_unpacklo_epi8(rg, zeros),                 // r_r_r_r_ R_R_R_R_
+            g = _mm_unpackhi_epi8(rg, zeros),                 // g_g_g_g_ G_G_G_G_
+            b = _mm_unpacklo_epi8(ba, zeros),                 // b_b_b_b_ B_B_B_B_
+            a = _mm_unpackhi_epi8(ba, zeros);                 // a_a_a_a_ A_A_A_A_
+
+    // Premultiply!
+    r = scale(r, a);
+    g = scale(g, a);
+    b = scale(b, a);
+
+    // Repack into interlaced pixels.
+    rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));               // rgrgrgrg RGRGRGRG
+    ba = _mm_or_si128(b, _mm_slli_epi16(a, 8));               // babababa BABABABA
+    *lo = _mm_unpacklo_epi16(rg, ba);                         // rgbargba rgbargba
+    *hi = _mm_unpackhi_epi16(rg, ba);                         // RGBARGBA RGBARGBA
+}
 
-        // Repack into interlaced pixels.
-        rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));               // rgrgrgrg RGRGRGRG
-        ba = _mm_or_si128(b, _mm_slli_epi16(a, 8));               // babababa BABABABA
-        *lo = _mm_unpacklo_epi16(rg, ba);                         // rgbargba rgbargba
-        *hi = _mm_unpackhi_epi16(rg, ba);                         // RGBARGBA RGBARGBA
-    };
+template <bool kSwapRB>
+static void premul_should_swapRB(uint32_t* dst, const void* vsrc, int count) {
+    auto src = (const uint32_t*)vsrc;
 
     while (count >= 8) {
         __m128i lo = _mm_loadu_si128((const __m128i*) (src + 0)),
                 hi = _mm_loadu_si128((const __m128i*) (src + 4));
 
-        premul8(&lo, &hi);
+        premul8<kSwapRB>(&lo, &hi);
 
         _mm_storeu_si128((__m128i*) (dst + 0), lo);
         _mm_storeu_si128((__m128i*) (dst + 4), hi);
@@ -557,7 +757,7 @@ static void premul_should_swapRB(uint32_t* dst, const void* vsrc, int count) {
         __m128i lo = _mm_loadu_si128((const __m128i*) src),
                 hi = _mm_setzero_si128();
 
-        premul8(&lo, &hi);
+        premul8<kSwapRB>(&lo, &hi);
 
         _mm_storeu_si128((__m128i*) dst, lo);
 
@@ -797,6 +997,126 @@ static void inverted_cmyk_to(uint32_t* dst, const void* vsrc, int count) {
     inverted_cmyk_to<kBGR1>(dst, src, count);
 }
 
+template <bool kSwapRB>
+static void RGB16_insert_alpha_should_swaprb(uint32_t dst[], const void* vsrc, int count) {
+    const uint8_t* src = (const uint8_t*) vsrc;
+
+    // Each component is big-endian, so we keep the first byte of each pair.  Four pixels span
+    // 24 bytes, so we load them as two overlapping vectors, bytes [0,16) and [8,24).  An index
+    // with its high bit set shuffles in a zero, so the two halves can be or-ed together.
+    const __m128i alphaMask = _mm_set1_epi32(0xFF000000);
+    __m128i expandLo, expandHi;
+    const uint8_t X = 0xFF;
+    if (kSwapRB) {
+        expandLo = _mm_setr_epi8(4,2,0,X, 10,8,6,X, X,14,12,X, X,X,X,X);
+        expandHi = _mm_setr_epi8(X,X,X,X, X,X,X,X, 8,X,X,X, 14,12,10,X);
+    } else {
+        expandLo = _mm_setr_epi8(0,2,4,X, 6,8,10,X, 12,14,X,X, X,X,X,X);
+        expandHi = _mm_setr_epi8(X,X,X,X, X,X,X,X, X,X,8,X, 10,12,14,X);
+    }
+
+    while (count >= 4) {
+        __m128i lo = _mm_loadu_si128((const __m128i*) (src + 0)),
+                hi = _mm_loadu_si128((const __m128i*) (src + 8));
+
+        __m128i rgba = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(lo, expandLo),
+                                                 _mm_shuffle_epi8(hi, expandHi)),
+                                    alphaMask);
+
+        _mm_storeu_si128((__m128i*) dst, rgba);
+
+        src += 4*6;
+        dst += 4;
+        count -= 4;
+    }
+
+    // Call portable code to finish up the tail of [0,4) pixels.
+    auto proc = kSwapRB ? RGB16_to_BGR1_portable : RGB16_to_RGB1_portable;
+    proc(dst, src, count);
+}
+
+/*not static*/ inline void RGB16_to_RGB1(uint32_t dst[], const void* src, int count) {
+    RGB16_insert_alpha_should_swaprb<false>(dst, src, count);
+}
+
+/*not static*/ inline void RGB16_to_BGR1(uint32_t dst[], const void* src, int count) {
+    RGB16_insert_alpha_should_swaprb<true>(dst, src, count);
+}
+
+template <bool kSwapRB, bool kPremul>
+static void RGBA16_to_8888(uint32_t dst[], const void* vsrc, int count) {
+    const uint8_t* src = (const uint8_t*) vsrc;
+
+    // Keep the first (high) byte of each big-endian component.  When premultiplying,
+    // premul8() takes care of the swap.
+    __m128i highBytes;
+    const uint8_t X = 0xFF;
+    if (kSwapRB && !kPremul) {
+        highBytes = _mm_setr_epi8(4,2,0,6, 12,10,8,14, X,X,X,X, X,X,X,X);
+    } else {
+        highBytes = _mm_setr_epi8(0,2,4,6, 8,10,12,14, X,X,X,X, X,X,X,X);
+    }
+
+    // Strip 4 pixels down to 8-bit components.
+    auto strip4 = [&](const uint8_t* ptr) {
+        __m128i lo = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (ptr +  0)), highBytes),
+                hi = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (ptr + 16)), highBytes);
+        return _mm_unpacklo_epi64(lo, hi);
+    };
+
+    while (count >= 8) {
+        __m128i lo = strip4(src +  0),
+                hi = strip4(src + 32);
+
+        if (kPremul) {
+            premul8<kSwapRB>(&lo, &hi);
+        }
+
+        _mm_storeu_si128((__m128i*) (dst + 0), lo);
+        _mm_storeu_si128((__m128i*) (dst + 4), hi);
+
+        src += 8*8;
+        dst += 8;
+        count -= 8;
+    }
+
+    if (count >= 4) {
+        __m128i lo = strip4(src),
+                hi = _mm_setzero_si128();
+
+        if (kPremul) {
+            premul8<kSwapRB>(&lo, &hi);
+        }
+
+        _mm_storeu_si128((__m128i*) dst, lo);
+
+        src += 4*8;
+        dst += 4;
+        count -= 4;
+    }
+
+    // Call portable code to finish up the tail of [0,4) pixels.
+    auto proc = kPremul ? (kSwapRB ? RGBA16_to_bgrA_portable : RGBA16_to_rgbA_portable)
+                        : (kSwapRB ? RGBA16_to_BGRA_portable : RGBA16_to_RGBA_portable);
+    proc(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_RGBA(uint32_t dst[], const void* src, int count) {
+    RGBA16_to_8888<false, false>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_BGRA(uint32_t dst[], const void* src, int count) {
+    RGBA16_to_8888<true, false>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_rgbA(uint32_t dst[], const void* src, int count) {
+    RGBA16_to_8888<false, true>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_bgrA(uint32_t dst[], const void* src, int count) {
+    RGBA16_to_8888<true, true>(dst, src, count);
+}
+
 #else
 
 /*not static*/ inline void RGBA_to_rgbA(uint32_t* dst, const void* src, int count) {
@@ -839,6 +1159,30 @@ static void inverted_cmyk_to(uint32_t* dst, const void* vsrc, int count) {
     inverted_CMYK_to_BGR1_portable(dst, src, count);
 }
 
+/*not static*/ inline void RGB16_to_RGB1(uint32_t dst[], const void* src, int count) {
+    RGB16_to_RGB1_portable(dst, src, count);
+}
+
+/*not static*/ inline void RGB16_to_BGR1(uint32_t dst[], const void* src, int count) {
+    RGB16_to_BGR1_portable(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_RGBA(uint32_t dst[], const void* src, int count) {
+    RGBA16_to_RGBA_portable(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_BGRA(uint32_t dst[], const void* src, int count) {
+    RGBA16_to_BGRA_portable(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_rgbA(uint32_t dst[], const void* src, int count) {
+    RGBA16_to_rgbA_portable(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_bgrA(uint32_t dst[], const void* src, int count) {
+    RGBA16_to_bgrA_portable(dst, src, count);
+}
+
 #endif
 
 }
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "SkData.h"
 #include "SkFontArguments.h"
 #include "SkFontDescriptor.h"
 #include "SkFontHost_FreeType_common.h"
@@ -76,6 +77,10 @@ SkTypeface_File::SkTypeface_File(const SkFontStyle& style, bool isFixedPitch, bo
 
 SkStreamAsset* SkTypeface_File::onOpenStream(int* ttcIndex) const {
     *ttcIndex = this->getIndex();
+    fMapOnce([this] { fMapped = SkData::MakeFromFileName(fPath.c_str()); });
+    if (fMapped) {
+        return new SkMemoryStream(fMapped);
+    }
     return SkStream::MakeFromFile(fPath.c_str()).release();
 }
 
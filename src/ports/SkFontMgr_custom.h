@@ -11,6 +11,7 @@
 #include "SkFontHost_FreeType_common.h"
 #include "SkFontMgr.h"
 #include "SkFontStyle.h"
+#include "SkOnce.h"
 #include "SkRefCnt.h"
 #include "SkString.h"
 #include "SkTArray.h"
@@ -84,6 +85,11 @@ protected:
 private:
     SkString fPath;
 
+    // The file is mapped the first time it is opened and shared by every stream after that,
+    // so its pages are only read in as they are used.
+    mutable SkOnce        fMapOnce;
+    mutable sk_sp<SkData> fMapped;
+
     typedef SkTypeface_Custom INHERITED;
 };
 
@@ -5,23 +5,295 @@
  * found in the LICENSE file.
  */
 
+#include "SkData.h"
 #include "SkFontMgr_custom.h"
 #include "SkFontMgr_directory.h"
+#include "SkOpts.h"
 #include "SkOSFile.h"
 #include "SkOSPath.h"
+#include "SkReader32.h"
 #include "SkStream.h"
+#include "SkTHash.h"
+
+/*  Index file layout. Everything is 4-byte aligned and in host byte order.
+
+    IndexHeader
+    repeated IndexHeader::fFileCount times:
+        FileRecord
+        path bytes, padded to 4
+        repeated FileRecord::fFaceCount times:
+            FaceRecord
+            family name bytes, padded to 4
+*/
+
+namespace {
+
+static constexpr uint32_t kIndexMagic   = SkSetFourByteTag('s', 'k', 'f', 'i');
+static constexpr uint32_t kIndexVersion = 2;
+
+struct IndexHeader {
+    uint32_t fMagic;
+    uint32_t fVersion;
+    uint32_t fBodySize;     // bytes following the header
+    uint32_t fBodyHash;     // SkOpts::hash() of those bytes
+    uint32_t fFileCount;
+};
+
+struct FileRecord {
+    uint32_t fSizeLo, fSizeHi;
+    uint32_t fModTimeLo, fModTimeHi;
+    uint32_t fFingerprint;
+    uint32_t fPathLength;
+    uint32_t fFaceCount;    // faces that scanned as fonts; 0 if the file is not a font
+};
+
+struct FaceRecord {
+    int32_t  fIndex;
+    int32_t  fWeight, fWidth, fSlant;
+    uint32_t fIsFixedPitch;
+    uint32_t fNameLength;
+};
+
+/** What scanning a font file found, as kept in the index. */
+struct ScannedFace {
+    int         fIndex;
+    SkFontStyle fStyle;
+    bool        fIsFixedPitch;
+    SkString    fFamilyName;
+};
+
+/**
+ *  What identifies a version of a file. The modification time only has a granularity of seconds,
+ *  so it also keeps a hash of the start and end of the file. For sfnt fonts the start holds the
+ *  table directory, whose checksums change along with any table.
+ */
+struct FileStamp {
+    uint64_t fSize;
+    uint64_t fModTime;
+    uint32_t fFingerprint;
+
+    bool operator==(const FileStamp& that) const {
+        return fSize == that.fSize && fModTime == that.fModTime &&
+               fFingerprint == that.fFingerprint;
+    }
+
+    bool init(const char path[]) {
+        int64_t modTime;
+        if (!sk_stat(path, &fSize, &modTime)) {
+            return false;
+        }
+        fModTime = modTime;
+
+        static constexpr size_t kChunkSize = 4096;
+        uint8_t buffer[2 * kChunkSize];
+        size_t head = (size_t)SkTMin<uint64_t>(fSize, kChunkSize),
+               tail = (size_t)SkTMin<uint64_t>(fSize - head, kChunkSize);
+        FILE* file = sk_fopen(path, kRead_SkFILE_Flag);
+        if (!file) {
+            return false;
+        }
+        bool read = sk_qread(file, buffer, head, 0) == head &&
+                    sk_qread(file, buffer + head, tail, fSize - tail) == tail;
+        sk_fclose(file);
+        fFingerprint = SkOpts::hash(buffer, head + tail);
+        return read;
+    }
+};
+
+struct ScannedFile {
+    FileStamp               fStamp;
+    SkTArray<ScannedFace>   fFaces;
+    bool                    fSeen;   // still in the directory
+};
+
+/**
+ *  The family and style of every face in the directory, by file, so that files which have not
+ *  changed since the last run do not have to be opened to find out.
+ */
+class FontIndex {
+public:
+    explicit FontIndex(const char* path) : fPath(path), fDirty(false) {
+        if (fPath.isEmpty()) {
+            return;
+        }
+        if (sk_sp<SkData> data = SkData::MakeFromFileName(fPath.c_str())) {
+            if (!this->load(*data)) {
+                fFiles.reset();
+                fDirty = true;
+            }
+        }
+    }
+
+    /** Returns what was recorded for the file, if it has not changed since. */
+    const ScannedFile* find(const SkString& filename, const FileStamp& stamp) {
+        ScannedFile* file = fFiles.find(filename);
+        if (!file || !(file->fStamp == stamp)) {
+            return nullptr;
+        }
+        file->fSeen = true;
+        return file;
+    }
+
+    void add(const SkString& filename, ScannedFile file) {
+        file.fSeen = true;
+        fFiles.set(filename, std::move(file));
+        fDirty = true;
+    }
+
+    /** Writes the index back if anything was added, or any file it knew of has gone. */
+    void save() {
+        if (fPath.isEmpty()) {
+            return;
+        }
+        SkTArray<SkString> gone;
+        fFiles.foreach([&gone](const SkString& filename, ScannedFile* file) {
+            if (!file->fSeen) {
+                gone.push_back(filename);
+            }
+        });
+        for (const SkString& filename : gone) {
+            fFiles.remove(filename);
+        }
+        if (!fDirty && gone.empty()) {
+            return;
+        }
+
+        SkDynamicMemoryWStream body;
+        static const char kPad[4] = {0, 0, 0, 0};
+        auto writePadded = [&body](const void* data, size_t size) {
+            body.write(data, size);
+            body.write(kPad, SkAlign4(size) - size);
+        };
+        const auto& files = fFiles;
+        files.foreach([&](const SkString& filename, const ScannedFile& file) {
+            FileRecord record;
+            record.fSizeLo      = (uint32_t)file.fStamp.fSize;
+            record.fSizeHi      = (uint32_t)(file.fStamp.fSize >> 32);
+            record.fModTimeLo   = (uint32_t)file.fStamp.fModTime;
+            record.fModTimeHi   = (uint32_t)(file.fStamp.fModTime >> 32);
+            record.fFingerprint = file.fStamp.fFingerprint;
+            record.fPathLength  = SkToU32(filename.size());
+            record.fFaceCount   = SkToU32(file.fFaces.count());
+            body.write(&record, sizeof(record));
+            writePadded(filename.c_str(), filename.size());
+            for (const ScannedFace& face : file.fFaces) {
+                FaceRecord faceRecord;
+                faceRecord.fIndex        = face.fIndex;
+                faceRecord.fWeight       = face.fStyle.weight();
+                faceRecord.fWidth        = face.fStyle.width();
+                faceRecord.fSlant        = face.fStyle.slant();
+                faceRecord.fIsFixedPitch = face.fIsFixedPitch;
+                faceRecord.fNameLength   = SkToU32(face.fFamilyName.size());
+                body.write(&faceRecord, sizeof(faceRecord));
+                writePadded(face.fFamilyName.c_str(), face.fFamilyName.size());
+            }
+        });
+
+        sk_sp<SkData> bodyData = body.detachAsData();
+        IndexHeader header;
+        header.fMagic     = kIndexMagic;
+        header.fVersion   = kIndexVersion;
+        header.fBodySize  = SkToU32(bodyData->size());
+        header.fBodyHash  = SkOpts::hash(bodyData->data(), bodyData->size());
+        header.fFileCount = SkToU32(fFiles.count());
+
+        // Write beside the index and move it into place, so another process starting up never
+        // reads it half written.
+        SkString tmpPath = SkStringPrintf("%s.tmp", fPath.c_str());
+        bool written;
+        {
+            SkFILEWStream file(tmpPath.c_str());
+            written = file.isValid() &&
+                      file.write(&header, sizeof(header)) &&
+                      file.write(bodyData->data(), bodyData->size());
+            file.flush();
+        }
+        if (!written || !sk_rename(tmpPath.c_str(), fPath.c_str())) {
+            SkDebugf("---- failed to write font index <%s>\n", fPath.c_str());
+            sk_remove(tmpPath.c_str());
+        }
+    }
+
+private:
+    bool load(const SkData& data) {
+        if (data.size() < sizeof(IndexHeader)) {
+            return false;
+        }
+        IndexHeader header;
+        memcpy(&header, data.data(), sizeof(header));
+        const char* body = static_cast<const char*>(data.data()) + sizeof(header);
+        if (header.fMagic != kIndexMagic || header.fVersion != kIndexVersion ||
+            header.fBodySize != data.size() - sizeof(header) ||
+            header.fBodyHash != SkOpts::hash(body, header.fBodySize)) {
+            return false;
+        }
+
+        SkReader32 reader(body, header.fBodySize);
+        auto readString = [&reader](uint32_t length, SkString* string) {
+            if (SkAlign4((size_t)length) > reader.available()) {
+                return false;
+            }
+            string->set(static_cast<const char*>(reader.skip(SkAlign4(length))), length);
+            return true;
+        };
+
+        for (uint32_t i = 0; i < header.fFileCount; ++i) {
+            FileRecord record;
+            SkString filename;
+            if (!reader.isAvailable(sizeof(record))) {
+                return false;
+            }
+            reader.read(&record, sizeof(record));
+            if (!readString(record.fPathLength, &filename)) {
+                return false;
+            }
+
+            ScannedFile file;
+            file.fStamp.fSize        = (uint64_t)record.fSizeHi << 32 | record.fSizeLo;
+            file.fStamp.fModTime     = (uint64_t)record.fModTimeHi << 32 | record.fModTimeLo;
+            file.fStamp.fFingerprint = record.fFingerprint;
+            file.fSeen               = false;
+            for (uint32_t j = 0; j < record.fFaceCount; ++j) {
+                FaceRecord faceRecord;
+                if (!reader.isAvailable(sizeof(faceRecord))) {
+                    return false;
+                }
+                reader.read(&faceRecord, sizeof(faceRecord));
+                ScannedFace& face = file.fFaces.push_back();
+                face.fIndex = faceRecord.fIndex;
+                face.fStyle = SkFontStyle(faceRecord.fWeight, faceRecord.fWidth,
+                                          (SkFontStyle::Slant)faceRecord.fSlant);
+                face.fIsFixedPitch = faceRecord.fIsFixedPitch != 0;
+                if (!readString(faceRecord.fNameLength, &face.fFamilyName)) {
+                    return false;
+                }
+            }
+            fFiles.set(filename, std::move(file));
+        }
+        return reader.eof();
+    }
+
+    SkString                          fPath;
+    SkTHashMap<SkString, ScannedFile> fFiles;
+    bool                              fDirty;
+};
+
+}  // namespace
 
 class DirectorySystemFontLoader : public SkFontMgr_Custom::SystemFontLoader {
 public:
-    DirectorySystemFontLoader(const char* dir) : fBaseDirectory(dir) { }
+    DirectorySystemFontLoader(const char* dir, const char* indexPath)
+        : fBaseDirectory(dir), fIndexPath(indexPath) { }
 
     void loadSystemFonts(const SkTypeface_FreeType::Scanner& scanner,
                          SkFontMgr_Custom::Families* families) const override
     {
-        load_directory_fonts(scanner, fBaseDirectory, ".ttf", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".ttc", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".otf", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".pfb", families);
+        FontIndex index(fIndexPath.c_str());
+        load_directory_fonts(scanner, fBaseDirectory, ".ttf", &index, families);
+        load_directory_fonts(scanner, fBaseDirectory, ".ttc", &index, families);
+        load_directory_fonts(scanner, fBaseDirectory, ".otf", &index, families);
+        load_directory_fonts(scanner, fBaseDirectory, ".pfb", &index, families);
+        index.save();
 
         if (families->empty()) {
             SkFontStyleSet_Custom* family = new SkFontStyleSet_Custom(SkString());
@@ -42,47 +314,73 @@ private:
         return nullptr;
     }
 
+    static bool scan_file(const SkTypeface_FreeType::Scanner& scanner, const SkString& filename,
+                          ScannedFile* file)
+    {
+        std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(filename.c_str());
+        if (!stream) {
+            SkDebugf("---- failed to open <%s>\n", filename.c_str());
+            return false;
+        }
+
+        int numFaces;
+        if (!scanner.recognizedFont(stream.get(), &numFaces)) {
+            SkDebugf("---- failed to open <%s> as a font\n", filename.c_str());
+            return true;
+        }
+
+        for (int faceIndex = 0; faceIndex < numFaces; ++faceIndex) {
+            bool isFixedPitch;
+            SkString realname;
+            SkFontStyle style = SkFontStyle(); // avoid uninitialized warning
+            if (!scanner.scanFont(stream.get(), faceIndex,
+                                  &realname, &style, &isFixedPitch, nullptr))
+            {
+                SkDebugf("---- failed to open <%s> <%d> as a font\n",
+                         filename.c_str(), faceIndex);
+                continue;
+            }
+            file->fFaces.push_back(ScannedFace{faceIndex, style, isFixedPitch, realname});
+        }
+        return true;
+    }
+
     static void load_directory_fonts(const SkTypeface_FreeType::Scanner& scanner,
                                      const SkString& directory, const char* suffix,
-                                     SkFontMgr_Custom::Families* families)
+                                     FontIndex* index, SkFontMgr_Custom::Families* families)
     {
         SkOSFile::Iter iter(directory.c_str(), suffix);
         SkString name;
 
         while (iter.next(&name, false)) {
             SkString filename(SkOSPath::Join(directory.c_str(), name.c_str()));
-            std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(filename.c_str());
-            if (!stream) {
-                SkDebugf("---- failed to open <%s>\n", filename.c_str());
-                continue;
-            }
 
-            int numFaces;
-            if (!scanner.recognizedFont(stream.get(), &numFaces)) {
-                SkDebugf("---- failed to open <%s> as a font\n", filename.c_str());
+            // Only a file that has changed since it was indexed needs to be scanned now.
+            FileStamp stamp;
+            if (!stamp.init(filename.c_str())) {
+                SkDebugf("---- failed to open <%s>\n", filename.c_str());
                 continue;
             }
-
-            for (int faceIndex = 0; faceIndex < numFaces; ++faceIndex) {
-                bool isFixedPitch;
-                SkString realname;
-                SkFontStyle style = SkFontStyle(); // avoid uninitialized warning
-                if (!scanner.scanFont(stream.get(), faceIndex,
-                                      &realname, &style, &isFixedPitch, nullptr))
-                {
-                    SkDebugf("---- failed to open <%s> <%d> as a font\n",
-                             filename.c_str(), faceIndex);
+            const ScannedFile* file = index->find(filename, stamp);
+            ScannedFile scanned;
+            if (!file) {
+                scanned.fStamp = stamp;
+                if (!scan_file(scanner, filename, &scanned)) {
                     continue;
                 }
+                index->add(filename, scanned);
+                file = &scanned;
+            }
 
-                SkFontStyleSet_Custom* addTo = find_family(*families, realname.c_str());
+            for (const ScannedFace& face : file->fFaces) {
+                SkFontStyleSet_Custom* addTo = find_family(*families, face.fFamilyName.c_str());
                 if (nullptr == addTo) {
-                    addTo = new SkFontStyleSet_Custom(realname);
+                    addTo = new SkFontStyleSet_Custom(face.fFamilyName);
                     families->push_back().reset(addTo);
                 }
-                addTo->appendTypeface(sk_make_sp<SkTypeface_File>(style, isFixedPitch, true,
-                                                                  realname, filename.c_str(),
-                                                                  faceIndex));
+                addTo->appendTypeface(sk_make_sp<SkTypeface_File>(face.fStyle, face.fIsFixedPitch,
+                                                                  true, face.fFamilyName,
+                                                                  filename.c_str(), face.fIndex));
             }
         }
 
@@ -92,13 +390,18 @@ private:
                 continue;
             }
             SkString dirname(SkOSPath::Join(directory.c_str(), name.c_str()));
-            load_directory_fonts(scanner, dirname, suffix, families);
+            load_directory_fonts(scanner, dirname, suffix, index, families);
         }
     }
 
     SkString fBaseDirectory;
+    SkString fIndexPath;
 };
 
 SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir) {
-    return sk_make_sp<SkFontMgr_Custom>(DirectorySystemFontLoader(dir));
+    return SkFontMgr_New_Custom_Directory(dir, nullptr);
+}
+
+SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir, const char* indexPath) {
+    return sk_make_sp<SkFontMgr_Custom>(DirectorySystemFontLoader(dir, indexPath));
 }
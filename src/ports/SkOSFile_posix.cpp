@@ -120,6 +120,10 @@ size_t sk_qread(FILE* file, void* buffer, size_t count, size_t offset) {
     return bytesRead;
 }
 
+bool sk_rename(const char* from, const char* to) {
+    return 0 == rename(from, to);
+}
+
 ////////////////////////////////////////////////////////////////////////////
 
 struct SkOSFileIterData {
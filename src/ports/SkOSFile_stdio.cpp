@@ -127,6 +127,16 @@ bool sk_isdir(const char *path) {
     return SkToBool(status.st_mode & S_IFDIR);
 }
 
+bool sk_stat(const char* path, uint64_t* size, int64_t* modTime) {
+    struct stat status;
+    if (0 != stat(path, &status)) {
+        return false;
+    }
+    *size = status.st_size;
+    *modTime = status.st_mtime;
+    return true;
+}
+
 bool sk_mkdir(const char* path) {
     if (sk_isdir(path)) {
         return true;
@@ -146,3 +156,7 @@ bool sk_mkdir(const char* path) {
 #endif
     return 0 == retval;
 }
+
+bool sk_remove(const char* path) {
+    return 0 == remove(path);
+}
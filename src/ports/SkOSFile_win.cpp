@@ -153,6 +153,11 @@ size_t sk_qread(FILE* file, void* buffer, size_t count, size_t offset) {
     return SIZE_MAX;
 }
 
+bool sk_rename(const char* from, const char* to) {
+    // Unlike POSIX rename(), MoveFile() fails if to exists unless asked to replace it.
+    return 0 != MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING);
+}
+
 ////////////////////////////////////////////////////////////////////////////
 
 struct SkOSFileIterData {
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Resources.h"
+#include "SkBitmap.h"
+#include "SkCodec.h"
+#include "SkCodecResizer.h"
+#include "SkData.h"
+#include "SkImageEncoder.h"
+#include "Test.h"
+
+static const SkCodecResizer::Filter gFilters[] = {
+    SkCodecResizer::kBox_Filter,
+    SkCodecResizer::kTriangle_Filter,
+    SkCodecResizer::kMitchell_Filter,
+};
+
+// A box filter halving the image averages each 2x2 block.
+DEF_TEST(CodecResizer_box, r) {
+    const char* path = "images/mandrill_512.png";
+    std::unique_ptr<SkCodec> codec(SkCodec::MakeFromStream(GetResourceAsStream(path)));
+    if (!codec) {
+        return;
+    }
+
+    const SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType)
+                                             .makeAlphaType(kPremul_SkAlphaType);
+    SkBitmap full;
+    full.allocPixels(info);
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(info, full.getPixels(),
+                                                             full.rowBytes()));
+
+    SkBitmap half;
+    half.allocPixels(info.makeWH(info.width() / 2, info.height() / 2));
+    SkPixmap pixmap;
+    half.peekPixels(&pixmap);
+    REPORTER_ASSERT(r, SkCodec::kSuccess == SkCodecResizer::Resize(codec.get(), pixmap,
+                                                                   SkCodecResizer::kBox_Filter));
+
+    for (int y = 0; y < half.height(); y++) {
+        for (int x = 0; x < half.width(); x++) {
+            uint32_t expected = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                uint32_t sum = 0;
+                for (int dy = 0; dy < 2; dy++) {
+                    for (int dx = 0; dx < 2; dx++) {
+                        sum += (*full.getAddr32(2 * x + dx, 2 * y + dy) >> shift) & 0xFF;
+                    }
+                }
+                expected |= ((sum + 2) / 4) << shift;
+            }
+            if (expected != *half.getAddr32(x, y)) {
+                ERRORF(r, "Mismatch at (%i, %i): expected %x, got %x", x, y, expected,
+                       *half.getAddr32(x, y));
+                return;
+            }
+        }
+    }
+}
+
+// Resampling at the original size with an interpolating filter changes nothing.
+DEF_TEST(CodecResizer_identity, r) {
+    const char* path = "images/mandrill_512_q075.jpg";
+    std::unique_ptr<SkCodec> codec(SkCodec::MakeFromStream(GetResourceAsStream(path)));
+    if (!codec) {
+        return;
+    }
+
+    const SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType);
+    SkBitmap expected;
+    expected.allocPixels(info);
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(info, expected.getPixels(),
+                                                             expected.rowBytes()));
+
+    for (auto filter : { SkCodecResizer::kBox_Filter, SkCodecResizer::kTriangle_Filter }) {
+        SkBitmap bm;
+        bm.allocPixels(info);
+        SkPixmap pixmap;
+        bm.peekPixels(&pixmap);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == SkCodecResizer::Resize(codec.get(), pixmap,
+                                                                       filter));
+        REPORTER_ASSERT(r, !memcmp(expected.getPixels(), bm.getPixels(),
+                                   bm.computeByteSize()));
+    }
+}
+
+// Every filter preserves a solid color at any size, including upscales.
+DEF_TEST(CodecResizer_solid, r) {
+    SkBitmap src;
+    src.allocPixels(SkImageInfo::MakeN32Premul(37, 23));
+    src.eraseColor(SkColorSetARGB(0x80, 0x40, 0x20, 0x10));
+    sk_sp<SkData> encoded = SkEncodeBitmap(src, SkEncodedImageFormat::kPNG, 100);
+    REPORTER_ASSERT(r, encoded);
+    if (!encoded) {
+        return;
+    }
+    std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(encoded));
+    REPORTER_ASSERT(r, codec);
+    if (!codec) {
+        return;
+    }
+
+    // Compare against the decoded color, which has been through unpremultiplying for PNG.
+    SkBitmap decoded;
+    decoded.allocPixels(src.info());
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(decoded.info(),
+                                                             decoded.getPixels(),
+                                                             decoded.rowBytes()));
+    const uint32_t color = *decoded.getAddr32(0, 0);
+
+    const SkISize sizes[] = { { 1, 1 }, { 5, 17 }, { 37, 23 }, { 100, 3 }, { 111, 79 } };
+    for (auto filter : gFilters) {
+        for (const SkISize& size : sizes) {
+            SkBitmap bm;
+            bm.allocPixels(src.info().makeWH(size.width(), size.height()));
+            SkPixmap pixmap;
+            bm.peekPixels(&pixmap);
+            REPORTER_ASSERT(r, SkCodec::kSuccess == SkCodecResizer::Resize(codec.get(), pixmap,
+                                                                           filter));
+            for (int y = 0; y < size.height(); y++) {
+                for (int x = 0; x < size.width(); x++) {
+                    if (color != *bm.getAddr32(x, y)) {
+                        ERRORF(r, "Filter %i at %ix%i: (%i, %i) is %x", filter, size.width(),
+                               size.height(), x, y, *bm.getAddr32(x, y));
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
+
+DEF_TEST(CodecResizer_incomplete, r) {
+    sk_sp<SkData> data = GetResourceAsData("images/mandrill_512_q075.jpg");
+    if (!data) {
+        return;
+    }
+    data = SkData::MakeSubset(data.get(), 0, data->size() / 2);
+    std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(data));
+    REPORTER_ASSERT(r, codec);
+    if (!codec) {
+        return;
+    }
+
+    for (auto filter : gFilters) {
+        SkBitmap bm;
+        bm.allocPixels(SkImageInfo::MakeN32Premul(100, 100));
+        SkPixmap pixmap;
+        bm.peekPixels(&pixmap);
+        REPORTER_ASSERT(r, SkCodec::kIncompleteInput == SkCodecResizer::Resize(codec.get(),
+                                                                               pixmap, filter));
+    }
+}
+
+DEF_TEST(CodecResizer_invalid, r) {
+    std::unique_ptr<SkCodec> codec(SkCodec::MakeFromStream(
+            GetResourceAsStream("images/mandrill_512_q075.jpg")));
+    if (!codec) {
+        return;
+    }
+
+    SkBitmap bm;
+    bm.allocPixels(SkImageInfo::Make(10, 10, kRGB_565_SkColorType, kOpaque_SkAlphaType));
+    SkPixmap pixmap;
+    bm.peekPixels(&pixmap);
+    REPORTER_ASSERT(r, SkCodec::kInvalidConversion == SkCodecResizer::Resize(codec.get(),
+            pixmap, SkCodecResizer::kBox_Filter));
+}
@@ -15,6 +15,7 @@
 #include "SkColorSpace_XYZ.h"
 #include "SkColorSpacePriv.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkFrontBufferedStream.h"
 #include "SkImageEncoder.h"
 #include "SkImageEncoderPriv.h"
@@ -295,9 +296,9 @@ static void check(skiatest::Reporter* r,
     if (supportsNewScanlineDecoding && !isIncomplete) {
         test_incremental_decode(r, codec.get(), info, codecDigest);
         // This is only supported by codecs that use incremental decoding to
-        // support subset decodes - png and jpeg (once SkJpegCodec is
-        // converted).
-        if (SkStrEndsWith(path, "png") || SkStrEndsWith(path, "PNG")) {
+        // support subset decodes - png and jpeg.
+        if (SkStrEndsWith(path, "png") || SkStrEndsWith(path, "PNG") ||
+                SkStrEndsWith(path, "jpg")) {
             test_in_stripes(r, codec.get(), info, codecDigest);
         }
     }
@@ -488,13 +489,14 @@ DEF_TEST(Codec_gif, r) {
 }
 
 DEF_TEST(Codec_jpg, r) {
-    check(r, "images/CMYK.jpg", SkISize::Make(642, 516), true, false, true);
-    check(r, "images/color_wheel.jpg", SkISize::Make(128, 128), true, false, true);
+    check(r, "images/CMYK.jpg", SkISize::Make(642, 516), true, false, true, true);
+    check(r, "images/color_wheel.jpg", SkISize::Make(128, 128), true, false, true, true);
     // grayscale.jpg is too small to test incomplete
-    check(r, "images/grayscale.jpg", SkISize::Make(128, 128), true, false, false);
-    check(r, "images/mandrill_512_q075.jpg", SkISize::Make(512, 512), true, false, true);
+    check(r, "images/grayscale.jpg", SkISize::Make(128, 128), true, false, false, true);
+    check(r, "images/mandrill_512_q075.jpg", SkISize::Make(512, 512), true, false, true, true);
+    check(r, "images/mandrill_512_restart.jpg", SkISize::Make(512, 512), true, false, true, true);
     // randPixels.jpg is too small to test incomplete
-    check(r, "images/randPixels.jpg", SkISize::Make(8, 8), true, false, false);
+    check(r, "images/randPixels.jpg", SkISize::Make(8, 8), true, false, false, true);
 }
 
 DEF_TEST(Codec_png, r) {
@@ -989,6 +991,134 @@ DEF_TEST(Codec_jpeg_rewind, r) {
     REPORTER_ASSERT(r, SkCodec::kIncompleteInput == result);
 }
 
+// mandrill_512_restart.jpg has a restart marker at the start of every MCU row, which lets
+// SkJpegCodec decode independent bands of rows, both on an SkExecutor and to skip straight
+// to the top of a subset.
+DEF_TEST(Codec_jpeg_restart, r) {
+    const char* path = "images/mandrill_512_restart.jpg";
+    std::unique_ptr<SkCodec> codec(SkCodec::MakeFromStream(GetResourceAsStream(path)));
+    if (!codec) {
+        return;
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    const SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType);
+
+    for (float scale : { 1.0f, 0.5f, 0.375f }) {
+        const SkISize size = codec->getScaledDimensions(scale);
+        const SkImageInfo scaledInfo = info.makeWH(size.width(), size.height());
+        SkBitmap serial, threaded;
+        serial.allocPixels(scaledInfo);
+        threaded.allocPixels(scaledInfo);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(scaledInfo, serial.getPixels(),
+                                                                 serial.rowBytes()));
+
+        SkCodec::Options opts;
+        opts.fExecutor = executor.get();
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(scaledInfo, threaded.getPixels(),
+                                                                 threaded.rowBytes(), &opts));
+        SkMD5::Digest serialDigest;
+        md5(serial, &serialDigest);
+        compare_to_good_digest(r, serialDigest, threaded);
+
+        const int width = scaledInfo.width();
+        const int height = scaledInfo.height();
+        for (SkIRect subset : { SkIRect::MakeXYWH(3, height / 3, width / 2, height / 3),
+                                SkIRect::MakeXYWH(0, height - 20, 17, 20),
+                                SkIRect::MakeXYWH(10, 1, 30, 1) }) {
+            // Scanline decodes of a column are the reference for the incremental subset.
+            SkIRect column = SkIRect::MakeXYWH(subset.x(), 0, subset.width(), height);
+            SkCodec::Options scanlineOpts;
+            scanlineOpts.fSubset = &column;
+            SkBitmap expected;
+            expected.allocPixels(scaledInfo.makeWH(subset.width(), subset.height()));
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->startScanlineDecode(scaledInfo,
+                                                                               &scanlineOpts));
+            REPORTER_ASSERT(r, codec->skipScanlines(subset.y()));
+            REPORTER_ASSERT(r, subset.height() == codec->getScanlines(expected.getPixels(),
+                                                                      subset.height(),
+                                                                      expected.rowBytes()));
+            SkMD5::Digest expectedDigest;
+            md5(expected, &expectedDigest);
+
+            for (SkExecutor* subsetExecutor : { (SkExecutor*) nullptr, executor.get() }) {
+                SkBitmap bm;
+                bm.allocPixels(expected.info());
+                SkCodec::Options subsetOpts;
+                subsetOpts.fSubset = &subset;
+                subsetOpts.fExecutor = subsetExecutor;
+                REPORTER_ASSERT(r, SkCodec::kSuccess == codec->startIncrementalDecode(
+                        scaledInfo, bm.getPixels(), bm.rowBytes(), &subsetOpts));
+                REPORTER_ASSERT(r, SkCodec::kSuccess == codec->incrementalDecode());
+                compare_to_good_digest(r, expectedDigest, bm);
+            }
+        }
+    }
+
+    // A stream that is not in memory is decoded serially, even with an executor.
+    std::unique_ptr<SkCodec> streamCodec(SkCodec::MakeFromStream(
+            skstd::make_unique<NotAssetMemStream>(GetResourceAsData(path))));
+    REPORTER_ASSERT(r, streamCodec);
+    if (streamCodec) {
+        SkBitmap serial, threaded;
+        serial.allocPixels(info);
+        threaded.allocPixels(info);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(info, serial.getPixels(),
+                                                                 serial.rowBytes()));
+        SkCodec::Options opts;
+        opts.fExecutor = executor.get();
+        REPORTER_ASSERT(r, SkCodec::kSuccess == streamCodec->getPixels(info,
+                threaded.getPixels(), threaded.rowBytes(), &opts));
+        SkMD5::Digest serialDigest;
+        md5(serial, &serialDigest);
+        compare_to_good_digest(r, serialDigest, threaded);
+    }
+}
+
+// Sample sizes beyond 8 average libjpeg's 1/8 scale decode, rather than sampling it.
+DEF_TEST(Codec_jpeg_areaAverage, r) {
+    const char* path = "images/mandrill_512_q075.jpg";
+    std::unique_ptr<SkAndroidCodec> codec(SkAndroidCodec::MakeFromStream(
+            GetResourceAsStream(path)));
+    if (!codec) {
+        return;
+    }
+
+    const SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType);
+    SkAndroidCodec::AndroidOptions opts;
+    opts.fSampleSize = 8;
+    SkBitmap eighth;
+    eighth.allocPixels(info.makeWH(64, 64));
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getAndroidPixels(eighth.info(),
+            eighth.getPixels(), eighth.rowBytes(), &opts));
+
+    opts.fSampleSize = 16;
+    SkBitmap sixteenth;
+    sixteenth.allocPixels(info.makeWH(32, 32));
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getAndroidPixels(sixteenth.info(),
+            sixteenth.getPixels(), sixteenth.rowBytes(), &opts));
+
+    for (int y = 0; y < 32; y++) {
+        for (int x = 0; x < 32; x++) {
+            uint32_t expected = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                uint32_t sum = 0;
+                for (int dy = 0; dy < 2; dy++) {
+                    for (int dx = 0; dx < 2; dx++) {
+                        sum += (*eighth.getAddr32(2 * x + dx, 2 * y + dy) >> shift) & 0xFF;
+                    }
+                }
+                expected |= ((sum + 2) / 4) << shift;
+            }
+            if (expected != *sixteenth.getAddr32(x, y)) {
+                ERRORF(r, "Mismatch at (%i, %i): expected %x, got %x", x, y, expected,
+                       *sixteenth.getAddr32(x, y));
+                return;
+            }
+        }
+    }
+}
+
 static void check_color_xform(skiatest::Reporter* r, const char* path) {
     std::unique_ptr<SkAndroidCodec> codec(SkAndroidCodec::MakeFromStream(GetResourceAsStream(path)));
 
@@ -1163,7 +1293,7 @@ static void test_conversion_possible(skiatest::Reporter* r, const char* path,
 
 DEF_TEST(Codec_F16ConversionPossible, r) {
     test_conversion_possible(r, "images/color_wheel.webp", false, false);
-    test_conversion_possible(r, "images/mandrill_512_q075.jpg", true, false);
+    test_conversion_possible(r, "images/mandrill_512_q075.jpg", true, true);
     test_conversion_possible(r, "images/yellow_rose.png", false, true);
 }
 
@@ -1264,7 +1394,6 @@ DEF_TEST(Codec_fallBack, r) {
 
     // Formats that currently do not support incremental decoding
     auto files = {
-            "images/CMYK.jpg",
             "images/color_wheel.ico",
             "images/mandrill.wbmp",
             "images/randPixels.bmp",
@@ -8,6 +8,8 @@
 #include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkDashPathEffect.h"
+#include "SkExecutor.h"
+#include "SkScan.h"
 #include "SkStrokeRec.h"
 #include "SkSurface.h"
 #include "Test.h"
@@ -362,3 +364,69 @@ DEF_TEST(DrawPath, reporter) {
     test_big_aa_rect(reporter);
     test_halfway();
 }
+
+// Tall paths drawn with delta AA may be split into bands generated on gSkDeltaAAExecutor.
+// The banded result should match the single-pass one exactly.
+DEF_TEST(DrawPath_DAABands, reporter) {
+    SkPath star;
+    const int kPoints = 37;
+    for (int i = 0; i < kPoints; ++i) {
+        SkScalar angle  = 2 * SK_ScalarPI * i / kPoints,
+                 radius = (i & 1) ? 120.5f : 290.25f;
+        SkPoint  pt     = { 150.3f + radius * SkScalarCos(angle) / 2,
+                            300.7f + radius * SkScalarSin(angle) };
+        i == 0 ? star.moveTo(pt) : star.lineTo(pt);
+    }
+    star.close();
+
+    SkPath oval;
+    oval.addOval(SkRect::MakeLTRB(20.5f, 10.25f, 280.75f, 590.5f));
+
+    // Cubics aren't chopped at their y extrema, so their edges may turn back across bands.
+    SkPath wave;
+    wave.moveTo(30.5f, 15.25f);
+    wave.cubicTo(290.25f, 420.5f, -40.75f, 180.25f, 260.5f, 585.75f);
+    wave.cubicTo(120.25f, 300.5f, 200.75f, 640.25f, 30.5f, 15.25f);
+
+    // A convex path with matching vertical edges exercises the anti-rect shared by all bands.
+    SkPath hexagon;
+    hexagon.moveTo(150.5f, 5.25f);
+    hexagon.lineTo(10.25f, 40.5f);
+    hexagon.lineTo(10.25f, 560.25f);
+    hexagon.lineTo(150.5f, 595.5f);
+    hexagon.lineTo(290.75f, 560.25f);
+    hexagon.lineTo(290.75f, 40.5f);
+    hexagon.close();
+
+    auto draw = [](const SkPath& path, SkExecutor* executor) {
+        SkBitmap bm;
+        bm.allocN32Pixels(300, 600);
+        bm.eraseColor(SK_ColorWHITE);
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+
+        gSkDeltaAAExecutor = executor;
+        SkCanvas(bm).drawPath(path, paint);
+        gSkDeltaAAExecutor = nullptr;
+        return bm;
+    };
+
+    bool useDeltaAA   = gSkUseDeltaAA,
+         forceDeltaAA = gSkForceDeltaAA;
+    gSkUseDeltaAA = gSkForceDeltaAA = true;
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (SkPath path : { star, oval, wave, hexagon }) {
+        for (auto fillType : { SkPath::kWinding_FillType, SkPath::kEvenOdd_FillType }) {
+            path.setFillType(fillType);
+            SkBitmap expected = draw(path, nullptr),
+                     actual   = draw(path, executor.get());
+            REPORTER_ASSERT(reporter, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                                  expected.computeByteSize()));
+        }
+    }
+
+    gSkUseDeltaAA   = useDeltaAA;
+    gSkForceDeltaAA = forceDeltaAA;
+}
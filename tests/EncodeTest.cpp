@@ -10,6 +10,7 @@
 
 #include "SkBitmap.h"
 #include "SkEncodedImageFormat.h"
+#include "SkExecutor.h"
 #include "SkImage.h"
 #include "SkJpegEncoder.h"
 #include "SkPngEncoder.h"
@@ -285,6 +286,66 @@ DEF_TEST(Encode_PngOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
 }
 
+DEF_TEST(Encode_PngStrips, r) {
+    SkBitmap bitmap;
+    bool success = GetResourceAsBitmap("images/mandrill_512.png", &bitmap);
+    if (!success) {
+        return;
+    }
+
+    SkPixmap src;
+    success = bitmap.peekPixels(&src);
+    REPORTER_ASSERT(r, success);
+    if (!success) {
+        return;
+    }
+    // The encoder splits the filtered rows into strips of about 128KB, so this takes several.
+    REPORTER_ASSERT(r, src.height() * (src.rowBytes() + 1) > 4 * 128 * 1024);
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (SkPngEncoder::FilterFlag filters : { SkPngEncoder::FilterFlag::kAll,
+                                              SkPngEncoder::FilterFlag::kNone,
+                                              SkPngEncoder::FilterFlag::kPaeth }) {
+        for (int zlibLevel : { 0, 1, 6, 9 }) {
+            SkPngEncoder::Options options;
+            options.fFilterFlags = filters;
+            options.fZLibLevel = zlibLevel;
+            options.fExecutor = executor.get();
+
+            // Encode in strips all at once, a few rows at a time (one strip per call), and
+            // many rows at a time (several strips per call, the last of them short).
+            SkDynamicMemoryWStream dst0, dst1, dst2;
+            success = SkPngEncoder::Encode(&dst0, src, options);
+            REPORTER_ASSERT(r, success);
+
+            std::unique_ptr<SkEncoder> encoder1 = SkPngEncoder::Make(&dst1, src, options);
+            REPORTER_ASSERT(r, encoder1);
+            for (int y = 0; encoder1 && y < src.height(); y += 7) {
+                REPORTER_ASSERT(r, encoder1->encodeRows(7));
+            }
+
+            std::unique_ptr<SkEncoder> encoder2 = SkPngEncoder::Make(&dst2, src, options);
+            REPORTER_ASSERT(r, encoder2);
+            for (int y = 0; encoder2 && y < src.height(); y += 150) {
+                REPORTER_ASSERT(r, encoder2->encodeRows(150));
+            }
+
+            // PNG is lossless, so every way should give back the source pixels exactly.
+            for (SkDynamicMemoryWStream* dst : { &dst0, &dst1, &dst2 }) {
+                sk_sp<SkImage> image = SkImage::MakeFromEncoded(dst->detachAsData());
+                REPORTER_ASSERT(r, image);
+                if (!image) {
+                    continue;
+                }
+
+                SkBitmap decoded;
+                image->asLegacyBitmap(&decoded, SkImage::kRO_LegacyBitmapMode);
+                REPORTER_ASSERT(r, almost_equals(bitmap, decoded, 0));
+            }
+        }
+    }
+}
+
 DEF_TEST(Encode_WebpOptions, r) {
     SkBitmap bitmap;
     bool success = GetResourceAsBitmap("images/google_chrome.ico", &bitmap);
@@ -8,6 +8,7 @@
 #include "SkAdvancedTypefaceMetrics.h"
 #include "SkCommandLineFlags.h"
 #include "SkFont.h"
+#include "SkFontMatchCache.h"
 #include "SkFontMgr.h"
 #include "SkPaint.h"
 #include "SkTypeface.h"
@@ -710,6 +711,92 @@ static void test_matchStyleCSS3(skiatest::Reporter* reporter) {
     }
 }
 
+// Counts how often each kind of match gets as far as the platform.
+class CountingFontMgr : public SkFontMgr {
+public:
+    mutable int fFamilyStyleCount = 0;
+    mutable int fCharacterCount = 0;
+    mutable int fLegacyCount = 0;
+
+protected:
+    int onCountFamilies() const override { return 0; }
+    void onGetFamilyName(int index, SkString* familyName) const override {}
+    SkFontStyleSet* onCreateStyleSet(int index) const override { return nullptr; }
+    SkFontStyleSet* onMatchFamily(const char familyName[]) const override { return nullptr; }
+
+    SkTypeface* onMatchFamilyStyle(const char familyName[], const SkFontStyle&) const override {
+        ++fFamilyStyleCount;
+        return SkTypeface::MakeDefault().release();
+    }
+    SkTypeface* onMatchFamilyStyleCharacter(const char familyName[], const SkFontStyle&,
+                                            const char* bcp47[], int bcp47Count,
+                                            SkUnichar character) const override {
+        ++fCharacterCount;
+        return character == 'A' ? SkTypeface::MakeDefault().release() : nullptr;
+    }
+    SkTypeface* onMatchFaceStyle(const SkTypeface*, const SkFontStyle&) const override {
+        return nullptr;
+    }
+
+    sk_sp<SkTypeface> onMakeFromData(sk_sp<SkData>, int) const override { return nullptr; }
+    sk_sp<SkTypeface> onMakeFromStreamIndex(std::unique_ptr<SkStreamAsset>, int) const override {
+        return nullptr;
+    }
+    sk_sp<SkTypeface> onMakeFromFile(const char path[], int) const override { return nullptr; }
+
+    sk_sp<SkTypeface> onLegacyMakeTypeface(const char familyName[], SkFontStyle) const override {
+        ++fLegacyCount;
+        return SkTypeface::MakeDefault();
+    }
+};
+
+// Asking the same question twice should give back the same typeface, without matching again,
+// and the least recently asked questions should make room for new ones.
+static void test_match_cache(skiatest::Reporter* reporter) {
+    sk_sp<CountingFontMgr> fm(new CountingFontMgr);
+    SkFontStyle bold = SkFontStyle::Bold();
+
+    sk_sp<SkTypeface> first(fm->matchFamilyStyle("family", bold));
+    sk_sp<SkTypeface> second(fm->matchFamilyStyle("family", bold));
+    REPORTER_ASSERT(reporter, first && first == second);
+    REPORTER_ASSERT(reporter, fm->fFamilyStyleCount == 1);
+    second.reset(fm->matchFamilyStyle(nullptr, bold));  // the default family is another question
+    REPORTER_ASSERT(reporter, fm->fFamilyStyleCount == 2);
+
+    first = fm->legacyMakeTypeface(nullptr, bold);
+    second = fm->legacyMakeTypeface(nullptr, bold);
+    REPORTER_ASSERT(reporter, first && first == second);
+    REPORTER_ASSERT(reporter, fm->fLegacyCount == 1);
+
+    // Misses are remembered too.
+    const char* bcp47[] = { "en" };
+    first.reset(fm->matchFamilyStyleCharacter(nullptr, bold, bcp47, 1, 'A'));
+    second.reset(fm->matchFamilyStyleCharacter(nullptr, bold, bcp47, 1, 'A'));
+    REPORTER_ASSERT(reporter, first && first == second);
+    REPORTER_ASSERT(reporter, fm->fCharacterCount == 1);
+    first.reset(fm->matchFamilyStyleCharacter(nullptr, bold, bcp47, 1, 0x4E00));
+    second.reset(fm->matchFamilyStyleCharacter(nullptr, bold, bcp47, 1, 0x4E00));
+    REPORTER_ASSERT(reporter, !first && !second);
+    REPORTER_ASSERT(reporter, fm->fCharacterCount == 2);
+
+    // Fill the cache with other characters, asking for 'A' along the way so it stays recent.
+    const int kMaxEntries = SkFontMatchCache::kMaxEntries;
+    for (int i = 1; i <= kMaxEntries; ++i) {
+        SkSafeUnref(fm->matchFamilyStyleCharacter(nullptr, bold, bcp47, 1, 0x4E00 + i));
+        if (i % (kMaxEntries / 4) == 0) {
+            SkSafeUnref(fm->matchFamilyStyleCharacter(nullptr, bold, bcp47, 1, 'A'));
+        }
+    }
+    REPORTER_ASSERT(reporter, fm->fCharacterCount == 2 + kMaxEntries);
+
+    // 'A' and the latest characters are still there; the oldest ones made room for them.
+    SkSafeUnref(fm->matchFamilyStyleCharacter(nullptr, bold, bcp47, 1, 'A'));
+    SkSafeUnref(fm->matchFamilyStyleCharacter(nullptr, bold, bcp47, 1, 0x4E00 + kMaxEntries));
+    REPORTER_ASSERT(reporter, fm->fCharacterCount == 2 + kMaxEntries);
+    SkSafeUnref(fm->matchFamilyStyleCharacter(nullptr, bold, bcp47, 1, 0x4E00));
+    REPORTER_ASSERT(reporter, fm->fCharacterCount == 3 + kMaxEntries);
+}
+
 DEFINE_bool(verboseFontMgr, false, "run verbose fontmgr tests.");
 
 DEF_TEST(FontMgr, reporter) {
@@ -718,4 +805,114 @@ DEF_TEST(FontMgr, reporter) {
     test_fontiter(reporter, FLAGS_verboseFontMgr);
     test_alias_names(reporter);
     test_font(reporter);
+    test_match_cache(reporter);
+}
+
+#ifdef SK_FONTMGR_CUSTOM_DIRECTORY_AVAILABLE
+
+#include "Resources.h"
+#include "SkData.h"
+#include "SkFontMgr_directory.h"
+#include "SkOSFile.h"
+#include "SkOSPath.h"
+#include "SkStream.h"
+
+static bool write_file(const SkString& path, const void* data, size_t size) {
+    SkFILEWStream file(path.c_str());
+    return file.isValid() && file.write(data, size);
+}
+
+// The families and styles the font manager found, in order.
+static SkString describe_fonts(const SkFontMgr* fm) {
+    SkString description;
+    for (int i = 0; i < fm->countFamilies(); ++i) {
+        SkString familyName;
+        fm->getFamilyName(i, &familyName);
+        description.appendf("%s:", familyName.c_str());
+        sk_sp<SkFontStyleSet> set(fm->createStyleSet(i));
+        for (int j = 0; j < set->count(); ++j) {
+            SkFontStyle style;
+            set->getStyle(j, &style, nullptr);
+            description.appendf(" %d/%d/%d", style.weight(), style.width(), style.slant());
+        }
+        description.append("\n");
+    }
+    return description;
+}
+
+// The directory font manager's index should describe the fonts as scanning them would, and
+// should be rebuilt wherever it can't be trusted.
+DEF_TEST(FontMgr_CustomDirectoryIndex, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString fontDir   = SkOSPath::Join(tmpDir.c_str(), "fontindex"),
+             emPath    = SkOSPath::Join(fontDir.c_str(), "Em.ttf"),
+             ttcPath   = SkOSPath::Join(fontDir.c_str(), "test.ttc"),
+             indexPath = SkOSPath::Join(tmpDir.c_str(), "fontindex.idx");
+    sk_sp<SkData> em  = SkData::MakeFromFileName(GetResourcePath("fonts/Em.ttf").c_str()),
+                  ttc = SkData::MakeFromFileName(GetResourcePath("fonts/test.ttc").c_str());
+    if (!em || !ttc || !sk_mkdir(fontDir.c_str())) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, write_file(emPath, em->data(), em->size()));
+    REPORTER_ASSERT(reporter, write_file(ttcPath, ttc->data(), ttc->size()));
+    sk_remove(indexPath.c_str());
+
+    auto scan = [&fontDir]() {
+        return describe_fonts(SkFontMgr_New_Custom_Directory(fontDir.c_str()).get());
+    };
+    auto useIndex = [&fontDir, &indexPath]() {
+        return describe_fonts(SkFontMgr_New_Custom_Directory(fontDir.c_str(),
+                                                             indexPath.c_str()).get());
+    };
+
+    // The first run scans the fonts and saves the index.
+    const SkString scanned = scan();
+    REPORTER_ASSERT(reporter, useIndex() == scanned);
+    sk_sp<SkData> index = SkData::MakeFromFileName(indexPath.c_str());
+    REPORTER_ASSERT(reporter, index && index->size() > 0);
+    if (!index) {
+        return;
+    }
+
+    // Later runs load it, leave it as it is, and make typefaces that still open their files.
+    {
+        sk_sp<SkFontMgr> fm = SkFontMgr_New_Custom_Directory(fontDir.c_str(), indexPath.c_str());
+        REPORTER_ASSERT(reporter, describe_fonts(fm.get()) == scanned);
+        sk_sp<SkTypeface> typeface = fm->legacyMakeTypeface(nullptr, SkFontStyle());
+        REPORTER_ASSERT(reporter, typeface && typeface->countGlyphs() > 0);
+        sk_sp<SkData> reloaded = SkData::MakeFromFileName(indexPath.c_str());
+        REPORTER_ASSERT(reporter, reloaded && reloaded->equals(index.get()));
+    }
+
+    // A damaged index is ignored, and saved again.
+    {
+        sk_sp<SkData> damaged = SkData::MakeWithCopy(index->data(), index->size());
+        static_cast<uint8_t*>(damaged->writable_data())[damaged->size() - 1] ^= 0xFF;
+        REPORTER_ASSERT(reporter, write_file(indexPath, damaged->data(), damaged->size()));
+        REPORTER_ASSERT(reporter, useIndex() == scanned);
+        sk_sp<SkData> rebuilt = SkData::MakeFromFileName(indexPath.c_str());
+        REPORTER_ASSERT(reporter, rebuilt && rebuilt->equals(index.get()));
+    }
+
+    // A font rewritten in place is scanned again, even if its size and modification time (to
+    // the second) are unchanged.
+    SkAutoTMalloc<uint8_t> zeros(em->size());
+    sk_bzero(zeros.get(), em->size());
+    REPORTER_ASSERT(reporter, write_file(emPath, zeros.get(), em->size()));
+    REPORTER_ASSERT(reporter, useIndex() == scan());
+    REPORTER_ASSERT(reporter, scan() != scanned);
+
+    // A font that is gone is dropped from the index.
+    sk_remove(emPath.c_str());
+    REPORTER_ASSERT(reporter, useIndex() == scan());
+    sk_sp<SkData> shrunk = SkData::MakeFromFileName(indexPath.c_str());
+    REPORTER_ASSERT(reporter, shrunk && shrunk->size() < index->size());
+
+    sk_remove(ttcPath.c_str());
+    sk_remove(indexPath.c_str());
 }
+
+#endif
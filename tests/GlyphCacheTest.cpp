@@ -0,0 +1,158 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkGlyphCache.h"
+#include "SkPaint.h"
+#include "SkTypeface.h"
+#include "Test.h"
+
+#include <thread>
+#include <vector>
+
+class GlyphCacheTestingAccess {
+public:
+    static constexpr uint32_t kColdUseCount = SkGlyphCache::kColdUseCount;
+
+    // Pretend the strike was found this many more times, without anyone asking for its glyphs.
+    static void Age(SkGlyphCache* cache, uint32_t uses) {
+        cache->fUseCount.fetch_add(uses, std::memory_order_relaxed);
+    }
+
+    static void TrimImages(SkGlyphCache* cache, size_t bytesNeeded) {
+        cache->trimImages(bytesNeeded);
+    }
+};
+
+static std::vector<uint8_t> copy_image(const SkGlyph& glyph) {
+    const uint8_t* image = static_cast<const uint8_t*>(glyph.fImage);
+    return std::vector<uint8_t>(image, image + glyph.computeImageSize());
+}
+
+// Cold glyph images are evicted and the image store compacted, while the other images survive
+// the move. Evicted images are made again on demand.
+DEF_TEST(GlyphCache_TrimImages, reporter) {
+    // Small BW glyphs, whose images don't fill whole words. An odd size, so no other test running
+    // meanwhile uses this strike.
+    SkPaint paint;
+    paint.setTypeface(SkTypeface::MakeDefault());
+    paint.setTextSize(9.5f);
+    const char text[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    SkGlyphID glyphIDs[SK_ARRAY_COUNT(text) - 1];
+    int glyphCount = paint.textToGlyphs(text, strlen(text), glyphIDs);
+
+    SkAutoGlyphCache cache(paint, nullptr, nullptr);
+    std::vector<const SkGlyph*> glyphs;
+    std::vector<std::vector<uint8_t>> images;
+    for (int i = 0; i < glyphCount; ++i) {
+        const SkGlyph& glyph = cache->getGlyphIDMetrics(glyphIDs[i]);
+        if (cache->findImage(glyph)) {
+            glyphs.push_back(&glyph);
+            images.push_back(copy_image(glyph));
+        }
+    }
+    if (glyphs.size() < 2) {
+        return;
+    }
+    const size_t liveBytes = cache->getImageBytesLive();
+    REPORTER_ASSERT(reporter, liveBytes > 0);
+    REPORTER_ASSERT(reporter, cache->getImageBytesFragmented() == 0);
+
+    // Keep the first half of the glyphs in use; the rest go cold.
+    const size_t hotCount = glyphs.size() / 2;
+    GlyphCacheTestingAccess::Age(cache.get(), GlyphCacheTestingAccess::kColdUseCount);
+    for (size_t i = 0; i < hotCount; ++i) {
+        cache->findImage(*glyphs[i]);
+    }
+
+    GlyphCacheTestingAccess::TrimImages(cache.get(), SIZE_MAX);
+    REPORTER_ASSERT(reporter, cache->getImageBytesLive() < liveBytes);
+    REPORTER_ASSERT(reporter, cache->getImageBytesFragmented() == 0);  // compacted
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        if (i < hotCount) {
+            REPORTER_ASSERT(reporter, glyphs[i]->fImage);
+            REPORTER_ASSERT(reporter, glyphs[i]->fImage && copy_image(*glyphs[i]) == images[i]);
+        } else {
+            REPORTER_ASSERT(reporter, !glyphs[i]->fImage);
+        }
+    }
+
+    // Evicted images are made again, the same as before.
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        REPORTER_ASSERT(reporter, cache->findImage(*glyphs[i]));
+        REPORTER_ASSERT(reporter, glyphs[i]->fImage && copy_image(*glyphs[i]) == images[i]);
+    }
+    REPORTER_ASSERT(reporter, cache->getImageBytesLive() == liveBytes);
+
+    // With nothing cold and nothing wasted, trimming again moves nothing.
+    std::vector<const void*> addresses;
+    for (const SkGlyph* glyph : glyphs) {
+        addresses.push_back(glyph->fImage);
+    }
+    GlyphCacheTestingAccess::TrimImages(cache.get(), SIZE_MAX);
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        REPORTER_ASSERT(reporter, glyphs[i]->fImage == addresses[i]);
+    }
+    REPORTER_ASSERT(reporter, cache->getImageBytesLive() == liveBytes);
+}
+
+// Threads asking for just the advances of glyphs race with threads asking for their full metrics
+// and images. Readers of a just-advance glyph must never see it change under them.
+DEF_TEST(GlyphCache_AdvancesAndMetricsThreaded, reporter) {
+    const char text[] = "The quick brown fox jumps over the lazy dog 0123456789";
+    const int kThreadCount = 8;
+
+    // Every round is a new strike (an odd size, so no other test uses it), so the glyphs are
+    // first looked up while the threads are racing.
+    for (int round = 0; round < 8; ++round) {
+        SkPaint paint;
+        paint.setTypeface(SkTypeface::MakeDefault());
+        paint.setTextSize(13.37f + round);
+        SkGlyphID glyphIDs[SK_ARRAY_COUNT(text) - 1];
+        const int glyphCount = paint.textToGlyphs(text, strlen(text), glyphIDs);
+
+        SkAutoGlyphCache cache(paint, nullptr, nullptr);
+        SkGlyphCache* strike = cache.get();
+
+        std::vector<std::vector<float>> advances(kThreadCount);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreadCount; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < glyphCount; ++i) {
+                    // Half the threads walk the glyphs backwards, to meet the others midway.
+                    const SkGlyphID glyphID = glyphIDs[t & 2 ? glyphCount - 1 - i : i];
+                    if (t & 1) {
+                        const SkGlyph& glyph = strike->getGlyphIDMetrics(glyphID);
+                        strike->findImage(glyph);
+                        advances[t].push_back(glyph.fAdvanceX);
+                    } else {
+                        const SkGlyph& glyph = strike->getGlyphIDAdvance(glyphID);
+                        advances[t].push_back(glyph.fAdvanceX);
+                        advances[t].push_back(glyph.fAdvanceY);
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (int t = 0; t < kThreadCount; ++t) {
+            const std::vector<float>& seen = advances[t];
+            for (int i = 0; i < glyphCount; ++i) {
+                const SkGlyphID glyphID = glyphIDs[t & 2 ? glyphCount - 1 - i : i];
+                const SkGlyph& glyph = strike->getGlyphIDMetrics(glyphID);
+                REPORTER_ASSERT(reporter, !glyph.isJustAdvance());
+                if (t & 1) {
+                    REPORTER_ASSERT(reporter, seen[i] == glyph.fAdvanceX);
+                } else {
+                    REPORTER_ASSERT(reporter, seen[2 * i] == glyph.fAdvanceX);
+                    REPORTER_ASSERT(reporter, seen[2 * i + 1] == glyph.fAdvanceY);
+                }
+            }
+        }
+    }
+}
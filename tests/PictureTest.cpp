@@ -13,6 +13,7 @@
 #include "SkColorPriv.h"
 #include "SkDashPathEffect.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkImageGenerator.h"
 #include "SkImageEncoder.h"
 #include "SkImageGenerator.h"
@@ -833,3 +834,54 @@ DEF_TEST(Picture_RecordsFlush, r) {
     auto back = SkPicture::MakeFromData(skp->data(), skp->size());
     REPORTER_ASSERT(r, back->approximateOpCount() == pic->approximateOpCount());
 }
+
+static sk_sp<SkPicture> make_parallel_playback_picture(SkBBHFactory* factory) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(200, 150), factory);
+    SkRandom rand;
+    SkPaint paint;
+    for (int i = 0; i < 50; i++) {
+        canvas->save();
+        canvas->translate(rand.nextRangeU(0, 150), rand.nextRangeU(0, 100));
+        if (i % 3 == 0) {
+            canvas->clipRect(SkRect::MakeWH(30, 20));
+        }
+        if (i % 5 == 0) {
+            canvas->scale(2, 2);
+        }
+        paint.setColor(rand.nextU() | 0xFF000000);
+        canvas->drawRect(SkRect::MakeWH(rand.nextRangeU(1, 50), rand.nextRangeU(1, 50)), paint);
+        canvas->restore();
+    }
+    return recorder.finishRecordingAsPicture();
+}
+
+DEF_TEST(Picture_playbackParallel, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkRTreeFactory rtree;
+    for (SkBBHFactory* factory : { (SkBBHFactory*)nullptr, (SkBBHFactory*)&rtree }) {
+        sk_sp<SkPicture> pic = make_parallel_playback_picture(factory);
+
+        SkBitmap expected, actual;
+        expected.allocN32Pixels(200, 150);
+        actual.allocN32Pixels(200, 150);
+        expected.eraseColor(SK_ColorWHITE);
+        actual.eraseColor(SK_ColorWHITE);
+
+        SkCanvas(expected).drawPicture(pic);
+
+        const SkISize tileSizes[] = { {200, 150}, {64, 64}, {17, 33} };
+        for (const SkISize& tileSize : tileSizes) {
+            actual.eraseColor(SK_ColorWHITE);
+            pic->playbackParallel([&](const SkIRect& tile) {
+                SkPixmap pixmap;
+                SkAssertResult(actual.pixmap().extractSubset(&pixmap, tile));
+                return SkCanvas::MakeRasterDirect(pixmap.info(), pixmap.writable_addr(),
+                                                  pixmap.rowBytes());
+            }, tileSize, executor.get());
+
+            REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                           expected.computeByteSize()));
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkPaint.h"
+#include "SkShaperCache.h"
+#include "SkTextBlob.h"
+#include "SkTypeface.h"
+#include "Test.h"
+#include "sk_tool_utils.h"
+
+DEF_TEST(ShaperCache, reporter) {
+    SkPaint paint;
+    paint.setTextSize(14);
+    SkShaperCache cache(2);
+
+    auto shape = [&](const char* text, sk_sp<SkTypeface> typeface, SkScalar* advance) {
+        return cache.shape(std::move(typeface), paint, text, strlen(text), true, advance);
+    };
+
+    // Shaping the same text again hands back the same blob.
+    SkScalar advance0, advance1;
+    sk_sp<SkTextBlob> hello = shape("hello", nullptr, &advance0);
+    REPORTER_ASSERT(reporter, cache.missCount() == 1 && cache.hitCount() == 0);
+    REPORTER_ASSERT(reporter, shape("hello", nullptr, &advance1) == hello);
+    REPORTER_ASSERT(reporter, advance1 == advance0);
+    REPORTER_ASSERT(reporter, cache.missCount() == 1 && cache.hitCount() == 1);
+
+    // Anything else the blob's runs depend on is a different key.
+    paint.setTextSize(15);
+    REPORTER_ASSERT(reporter, shape("hello", nullptr, nullptr) != hello);
+    REPORTER_ASSERT(reporter, cache.missCount() == 2 && cache.count() == 2);
+    paint.setTextSize(14);
+
+    // Past two blobs, the least recently used one goes.
+    REPORTER_ASSERT(reporter, shape("hello", nullptr, nullptr) == hello);  // now most recent
+    shape("world", nullptr, nullptr);
+    REPORTER_ASSERT(reporter, cache.count() == 2 && cache.missCount() == 3);
+    REPORTER_ASSERT(reporter, shape("hello", nullptr, nullptr) == hello);
+    REPORTER_ASSERT(reporter, cache.missCount() == 3);
+    paint.setTextSize(15);
+    shape("hello", nullptr, nullptr);  // was evicted for "world"
+    REPORTER_ASSERT(reporter, cache.missCount() == 4);
+    paint.setTextSize(14);
+
+    // Shapers are kept for as few typefaces as blobs.
+    shape("hello", sk_tool_utils::create_portable_typeface("serif", SkFontStyle()), nullptr);
+    shape("hello", sk_tool_utils::create_portable_typeface("monospace", SkFontStyle()), nullptr);
+    REPORTER_ASSERT(reporter, cache.shaperCount() <= 2);
+    REPORTER_ASSERT(reporter, cache.count() == 2);
+
+    cache.reset();
+    REPORTER_ASSERT(reporter, cache.count() == 0 && cache.shaperCount() == 0);
+    REPORTER_ASSERT(reporter, cache.hitCount() == 0 && cache.missCount() == 0);
+}
@@ -287,3 +287,30 @@ DEF_TEST(ResourceCache_purge, reporter) {
         }
     }
 }
+
+static bool test_rec_visitor(const SkResourceCache::Rec&, void*) { return true; }
+
+/*
+ *  SkShardedResourceCache (the global cache) applies its byte limit to all of the shards together.
+ */
+DEF_TEST(ResourceCache_shardedLimit, reporter) {
+    const size_t kLimit = 64 * 1024;
+    SkShardedResourceCache cache(kLimit);
+
+    int flags = 0;
+    const int kCount = 1000;
+    for (int i = 0; i < kCount; ++i) {
+        TestRec* rec = new TestRec(0, i, &flags);
+        rec->fCanBePurged = true;
+        cache.add(rec);
+        REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() <= kLimit);
+    }
+    // The most recently added Rec is never the one purged to make room.
+    REPORTER_ASSERT(reporter, cache.find(TestKey(0, kCount - 1), test_rec_visitor, nullptr));
+
+    REPORTER_ASSERT(reporter, kLimit == cache.setTotalByteLimit(kLimit / 4));
+    REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() <= kLimit / 4);
+
+    cache.purgeAll();
+    REPORTER_ASSERT(reporter, 0 == cache.getTotalBytesUsed());
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkAutoMalloc.h"
+#include "SkData.h"
+#include "SkGlyphCache.h"
+#include "SkGraphics.h"
+#include "SkOSFile.h"
+#include "SkOSPath.h"
+#include "SkPaint.h"
+#include "SkPath.h"
+#include "SkStream.h"
+#include "SkStrikeStore.h"
+#include "SkTypeface.h"
+#include "Test.h"
+
+DEF_TEST(StrikeStore, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString path = SkOSPath::Join(tmpDir.c_str(), "strikes");
+    sk_fclose(sk_fopen(path.c_str(), kWrite_SkFILE_Flag));  // start from an empty file
+
+    SkPaint paint;
+    paint.setTypeface(SkTypeface::MakeDefault());
+    paint.setTextSize(24);
+    paint.setAntiAlias(true);
+    SkGlyphID glyphID;
+    paint.textToGlyphs("A", 1, &glyphID);
+
+    SkAutoGlyphCache cache(paint, nullptr, nullptr);
+    SkTypeface* typeface = cache->getScalerContext()->getTypeface();
+    const SkGlyph& glyph = cache->getGlyphIDMetrics(glyphID);
+    const void* image = cache->findImage(glyph);
+    const SkPath* glyphPath = cache->findPath(glyph);
+    if (!image || !glyphPath) {
+        return;
+    }
+
+    {
+        sk_sp<SkStrikeStore> store = SkStrikeStore::Make(path.c_str(), 1 << 20);
+        REPORTER_ASSERT(reporter, store->countGlyphs() == 0);
+        SkStrikeStore::Strike* strike = store->findOrAddStrike(typeface, cache->getDescriptor());
+        if (!strike) {
+            return;  // The typeface's data can't be read, so it can't be stored.
+        }
+        strike->addMetrics(glyph);
+        strike->addImage(glyph);
+        strike->addPath(glyph.getPackedID(), *glyphPath);
+        REPORTER_ASSERT(reporter, store->countGlyphs() == 1);
+        REPORTER_ASSERT(reporter, store->flush());
+    }
+
+    {
+        sk_sp<SkStrikeStore> store = SkStrikeStore::Make(path.c_str(), 1 << 20);
+        REPORTER_ASSERT(reporter, store->countGlyphs() == 1);
+        SkStrikeStore::Strike* strike = store->findOrAddStrike(typeface, cache->getDescriptor());
+
+        SkGlyph stored;
+        stored.initWithGlyphID(glyph.getPackedID());
+        REPORTER_ASSERT(reporter, strike->findMetrics(&stored));
+        REPORTER_ASSERT(reporter, stored.fAdvanceX == glyph.fAdvanceX);
+        REPORTER_ASSERT(reporter, stored.fWidth == glyph.fWidth);
+        REPORTER_ASSERT(reporter, stored.fHeight == glyph.fHeight);
+        REPORTER_ASSERT(reporter, stored.fMaskFormat == glyph.fMaskFormat);
+
+        SkAutoMalloc storage(stored.computeImageSize());
+        stored.fImage = storage.get();
+        REPORTER_ASSERT(reporter, strike->findImage(stored));
+        REPORTER_ASSERT(reporter, !memcmp(stored.fImage, image, glyph.computeImageSize()));
+
+        SkPath storedPath;
+        REPORTER_ASSERT(reporter, strike->findPath(glyph.getPackedID(), &storedPath));
+        REPORTER_ASSERT(reporter, storedPath == *glyphPath);
+    }
+
+    // A file larger than the limit is dropped, and nothing is recorded past the limit.
+    {
+        sk_sp<SkStrikeStore> store = SkStrikeStore::Make(path.c_str(), 64);
+        REPORTER_ASSERT(reporter, store->countGlyphs() == 0);
+        SkStrikeStore::Strike* strike = store->findOrAddStrike(typeface, cache->getDescriptor());
+        strike->addImage(glyph);
+        REPORTER_ASSERT(reporter, store->countGlyphs() == 0);
+        REPORTER_ASSERT(reporter, store->getBytesUsed() <= 64);
+    }
+
+    // A damaged file is dropped.
+    {
+        sk_sp<SkData> data = SkData::MakeFromFileName(path.c_str());
+        REPORTER_ASSERT(reporter, data && data->size() > 32);
+        sk_sp<SkData> damaged = SkData::MakeWithCopy(data->data(), data->size());
+        static_cast<uint8_t*>(damaged->writable_data())[damaged->size() - 1] ^= 0xFF;
+        data.reset();
+        {
+            SkFILEWStream file(path.c_str());
+            file.write(damaged->data(), damaged->size());
+        }
+        sk_sp<SkStrikeStore> store = SkStrikeStore::Make(path.c_str(), 1 << 20);
+        REPORTER_ASSERT(reporter, store->countGlyphs() == 0);
+    }
+}
+
+// Strikes made while SkGraphics::SetFontCacheStore() is in effect read glyphs from the store and
+// record the ones they have to generate for FlushFontCacheStore().
+DEF_TEST(StrikeStore_GlyphCache, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString path = SkOSPath::Join(tmpDir.c_str(), "strikes_glyphcache");
+    SkString tmpPath = SkStringPrintf("%s.tmp", path.c_str());
+    sk_remove(path.c_str());
+
+    // An odd size, so no other test running meanwhile uses these strikes.
+    SkPaint paint;
+    paint.setTypeface(SkTypeface::MakeDefault());
+    paint.setTextSize(37.5f);
+    paint.setAntiAlias(true);
+    SkGlyphID glyphIDs[2];
+    paint.textToGlyphs("AB", 2, glyphIDs);
+
+    // Store an image for 'A' that its scaler context would never make.
+    {
+        SkAutoGlyphCache cache(paint, nullptr, nullptr);
+        SkGlyph glyph = cache->getGlyphIDMetrics(glyphIDs[0]);
+        if (!cache->findImage(glyph)) {
+            return;
+        }
+        sk_sp<SkStrikeStore> store = SkStrikeStore::Make(path.c_str(), 1 << 20);
+        SkStrikeStore::Strike* strike = store->findOrAddStrike(
+                cache->getScalerContext()->getTypeface(), cache->getDescriptor());
+        if (!strike) {
+            return;  // The typeface's data can't be read, so it can't be stored.
+        }
+        SkAutoMalloc fake(glyph.computeImageSize());
+        memset(fake.get(), 0xA5, glyph.computeImageSize());
+        glyph.fImage = fake.get();
+        strike->addMetrics(glyph);
+        strike->addImage(glyph);
+        REPORTER_ASSERT(reporter, store->flush());
+    }
+
+    SkGraphics::PurgeFontCache();
+    SkGraphics::SetFontCacheStore(path.c_str(), 1 << 20);
+    {
+        SkAutoGlyphCache cache(paint, nullptr, nullptr);
+        const SkGlyph& stored = cache->getGlyphIDMetrics(glyphIDs[0]);
+        const uint8_t* image = static_cast<const uint8_t*>(cache->findImage(stored));
+        REPORTER_ASSERT(reporter, image);
+        for (size_t i = 0; image && i < stored.computeImageSize(); ++i) {
+            REPORTER_ASSERT(reporter, image[i] == 0xA5);
+        }
+
+        // 'B' isn't in the store, so it is generated and recorded.
+        const SkGlyph& generated = cache->getGlyphIDMetrics(glyphIDs[1]);
+        REPORTER_ASSERT(reporter, cache->findImage(generated));
+    }
+
+    // Flushing twice replaces the file, and leaves nothing behind.
+    REPORTER_ASSERT(reporter, SkGraphics::FlushFontCacheStore());
+    REPORTER_ASSERT(reporter, SkGraphics::FlushFontCacheStore());
+    REPORTER_ASSERT(reporter, !sk_exists(tmpPath.c_str()));
+    SkGraphics::SetFontCacheStore(nullptr, 0);
+    SkGraphics::PurgeFontCache();
+
+    sk_sp<SkStrikeStore> store = SkStrikeStore::Make(path.c_str(), 1 << 20);
+    SkAutoGlyphCache cache(paint, nullptr, nullptr);
+    SkStrikeStore::Strike* strike = store->findOrAddStrike(
+            cache->getScalerContext()->getTypeface(), cache->getDescriptor());
+    for (SkGlyphID glyphID : glyphIDs) {
+        SkGlyph glyph;
+        glyph.initWithGlyphID(SkPackedGlyphID(glyphID));
+        REPORTER_ASSERT(reporter, strike->findMetrics(&glyph));
+    }
+}
@@ -5,6 +5,10 @@
  * found in the LICENSE file.
  */
 
+#include "SkCodecPriv.h"
+#include "SkMaskSwizzler.h"
+#include "SkMasks.h"
+#include "SkRandom.h"
 #include "SkSwizzle.h"
 #include "SkSwizzler.h"
 #include "Test.h"
@@ -160,3 +164,180 @@ DEF_TEST(PublicSwizzleOpts, r) {
     SkSwapRB(&dst, &src, 1);
     REPORTER_ASSERT(r, dst == 0xFA04B0CE);
 }
+
+// The 16-bit swizzles should match the 8-bit swizzles applied to the high byte of each component.
+DEF_TEST(SwizzleOpts16, r) {
+    static const int kMaxCount = 37;  // Long enough for the SIMD loops and their tails.
+    uint8_t src16[4 * 2 * kMaxCount], src8[4 * kMaxCount];
+    for (int i = 0; i < (int) sizeof(src16); i++) {
+        src16[i] = (uint8_t) (i * 113 + 7);
+    }
+
+    const struct {
+        SkOpts::Swizzle_8888 fn16;
+        SkOpts::Swizzle_8888 fn8;
+        int                  components;
+    } kProcs[] = {
+        { SkOpts::RGB16_to_RGB1,  SkOpts::RGB_to_RGB1,  3 },
+        { SkOpts::RGB16_to_BGR1,  SkOpts::RGB_to_BGR1,  3 },
+        { SkOpts::RGBA16_to_RGBA, nullptr,              4 },
+        { SkOpts::RGBA16_to_BGRA, SkOpts::RGBA_to_BGRA, 4 },
+        { SkOpts::RGBA16_to_rgbA, SkOpts::RGBA_to_rgbA, 4 },
+        { SkOpts::RGBA16_to_bgrA, SkOpts::RGBA_to_bgrA, 4 },
+    };
+
+    for (const auto& proc : kProcs) {
+        for (int i = 0; i < proc.components * kMaxCount; i++) {
+            src8[i] = src16[2 * i];
+        }
+
+        for (int count = 0; count <= kMaxCount; count++) {
+            uint32_t dst16[kMaxCount], dst8[kMaxCount];
+            memset(dst16, 0, sizeof(dst16));
+            memset(dst8, 0, sizeof(dst8));
+            proc.fn16(dst16, src16, count);
+            if (proc.fn8) {
+                proc.fn8(dst8, src8, count);
+            } else {
+                memcpy(dst8, src8, count * sizeof(uint32_t));
+            }
+            REPORTER_ASSERT(r, !memcmp(dst16, dst8, sizeof(dst16)));
+        }
+    }
+}
+
+static uint32_t component_mask(int shift, int size) {
+    return ((1u << size) - 1) << shift;
+}
+
+static uint8_t get_component(const SkMasks& masks, int component, uint32_t pixel) {
+    switch (component) {
+        case 0:  return masks.getRed(pixel);
+        case 1:  return masks.getGreen(pixel);
+        case 2:  return masks.getBlue(pixel);
+        default: return masks.getAlpha(pixel);
+    }
+}
+
+static Sk4u get_component(const SkMasks& masks, int component, const Sk4u& pixels) {
+    switch (component) {
+        case 0:  return masks.getRed(pixels);
+        case 1:  return masks.getGreen(pixels);
+        case 2:  return masks.getBlue(pixels);
+        default: return masks.getAlpha(pixels);
+    }
+}
+
+// The four-wide SkMasks getters should match the scalar getters for every n-bit value.
+DEF_TEST(MasksGetters4, r) {
+    for (int component = 0; component < 4; component++) {
+        for (int size = 1; size <= 8; size++) {
+            const int kShifts[] = { 0, 3, 32 - size };
+            for (int shift : kShifts) {
+                uint32_t inputs[4] = { 0, 0, 0, 0 };
+                inputs[component] = component_mask(shift, size);
+                SkMasks::InputMasks inputMasks = { inputs[0], inputs[1], inputs[2], inputs[3] };
+                std::unique_ptr<SkMasks> masks(SkMasks::CreateMasks(inputMasks, 32));
+                REPORTER_ASSERT(r, masks);
+                if (!masks) {
+                    continue;
+                }
+
+                // Set the bits around the component too, so the getters have to mask them off.
+                const uint32_t noise = ~inputs[component] & 0xA5A5A5A5;
+                const uint32_t count = 1u << size;
+                for (uint32_t value = 0; value < count; value += 4) {
+                    uint32_t pixels[4];
+                    for (int i = 0; i < 4; i++) {
+                        pixels[i] = (((value + i) % count) << shift) | noise;
+                    }
+                    Sk4u wide = get_component(*masks, component, Sk4u::Load(pixels));
+                    for (int i = 0; i < 4; i++) {
+                        REPORTER_ASSERT(r, wide[i] == get_component(*masks, component, pixels[i]));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Sampled mask swizzles of widths that aren't multiples of four should match a per-pixel
+// reference built from the scalar SkMasks getters.
+DEF_TEST(MaskSwizzlerSampled, r) {
+    const struct {
+        uint32_t            bpp;
+        SkMasks::InputMasks masks;
+    } kConfigs[] = {
+        { 16, { 0x7C00,     0x03E0,  0x001F, 0          } },
+        { 16, { 0xF800,     0x07E0,  0x001F, 0          } },
+        { 16, { 0x7C00,     0x03E0,  0x001F, 0x8000     } },
+        { 16, { 0x0F00,     0x00F0,  0x000F, 0xF000     } },
+        { 24, { 0xFF0000,   0xFF00,  0xFF,   0          } },
+        { 32, { 0xFF0000,   0xFF00,  0xFF,   0xFF000000 } },
+        { 32, { 0x3FF00000, 0xFFC00, 0x3FF,  0xC0000000 } },
+    };
+    const int kWidths[] = { 1, 5, 13, 50, 61 };
+    const int kMaxWidth = 61;
+
+    uint8_t src[4 * kMaxWidth];
+    SkRandom random;
+    for (uint8_t& byte : src) {
+        byte = (uint8_t) random.nextU();
+    }
+
+    for (const auto& config : kConfigs) {
+        SkMasks::InputMasks inputMasks = config.masks;
+        std::unique_ptr<SkMasks> masks(SkMasks::CreateMasks(inputMasks, config.bpp));
+        REPORTER_ASSERT(r, masks);
+        if (!masks) {
+            continue;
+        }
+        const int bytesPerPixel = config.bpp / 8;
+
+        for (SkColorType colorType : { kRGBA_8888_SkColorType, kBGRA_8888_SkColorType }) {
+        for (SkAlphaType alphaType : { kOpaque_SkAlphaType, kUnpremul_SkAlphaType,
+                                       kPremul_SkAlphaType }) {
+        for (int width : kWidths) {
+            SkImageInfo dstInfo = SkImageInfo::Make(width, 1, colorType, alphaType);
+            SkImageInfo srcInfo = dstInfo.makeAlphaType(
+                    kOpaque_SkAlphaType == alphaType ? kOpaque_SkAlphaType
+                                                     : kUnpremul_SkAlphaType);
+            std::unique_ptr<SkMaskSwizzler> swizzler(SkMaskSwizzler::CreateMaskSwizzler(
+                    dstInfo, srcInfo, masks.get(), config.bpp, SkCodec::Options()));
+            REPORTER_ASSERT(r, swizzler);
+            if (!swizzler) {
+                continue;
+            }
+
+            PackColorProc pack = choose_pack_color_proc(kPremul_SkAlphaType == alphaType,
+                                                        colorType);
+            for (int sampleX = 2; sampleX <= 3; sampleX++) {
+                const int dstWidth = swizzler->setSampleX(sampleX);
+                REPORTER_ASSERT(r, dstWidth == get_scaled_dimension(width, sampleX));
+
+                uint32_t dst[kMaxWidth];
+                memset(dst, 0, sizeof(dst));
+                swizzler->swizzle(dst, src);
+
+                for (int i = 0; i < dstWidth; i++) {
+                    const int x = get_start_coord(sampleX) + i * sampleX;
+                    const uint8_t* p = src + x * bytesPerPixel;
+                    uint32_t pixel = 0;
+                    for (int b = 0; b < bytesPerPixel; b++) {
+                        pixel |= p[b] << (8 * b);
+                    }
+                    const uint8_t alpha = kOpaque_SkAlphaType == alphaType ? 0xFF
+                                                                            : masks->getAlpha(pixel);
+                    const uint32_t expected = pack(alpha, masks->getRed(pixel),
+                                                   masks->getGreen(pixel), masks->getBlue(pixel));
+                    REPORTER_ASSERT(r, dst[i] == expected);
+                }
+                for (int i = dstWidth; i < kMaxWidth; i++) {
+                    REPORTER_ASSERT(r, 0 == dst[i]);
+                }
+            }
+        }
+        }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkExecutor.h"
+#include "SkTaskGroup2D.h"
+#include "Test.h"
+
+#include <thread>
+
+// Run a skewed workload (row 0 is much more expensive than the others) and check that every task
+// is executed exactly once and that tasks on the same row are executed in column order.
+static void test_task_group_2d(skiatest::Reporter* reporter, int height, int threadCnt) {
+    static constexpr int kWidth = 64;
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(threadCnt);
+
+    std::vector<int> lastColumn(height, -1);
+    std::vector<std::atomic<int>> runCnt(height * kWidth);
+    for (auto& cnt : runCnt) {
+        cnt = 0;
+    }
+    std::atomic<bool> inOrder(true);
+
+    auto work = [&](int row, int column) {
+        if (lastColumn[row] != column - 1) {
+            inOrder = false;
+        }
+        lastColumn[row] = column;
+        runCnt[row * kWidth + column]++;
+        if (row == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    };
+
+    SkWorkStealingTaskGroup2D tasks(work, height, executor.get(), threadCnt);
+    tasks.start();
+    for (int column = 0; column < kWidth; ++column) {
+        tasks.addColumn();
+    }
+    tasks.finish();
+
+    REPORTER_ASSERT(reporter, inOrder);
+    for (int row = 0; row < height; ++row) {
+        REPORTER_ASSERT(reporter, lastColumn[row] == kWidth - 1);
+    }
+    for (auto& cnt : runCnt) {
+        REPORTER_ASSERT(reporter, cnt == 1);
+    }
+}
+
+DEF_TEST(SkWorkStealingTaskGroup2D, reporter) {
+    test_task_group_2d(reporter, 4, 4);  // one row per thread
+    test_task_group_2d(reporter, 16, 4); // more rows than threads
+    test_task_group_2d(reporter, 3, 8);  // more threads than rows
+}
@@ -5,6 +5,11 @@
  * found in the LICENSE file.
  */
 
+#include "SkBitmapDevice.h"
+#include "SkDraw.h"
+#include "SkExecutor.h"
+#include "SkGlyphCache.h"
+#include "SkGraphics.h"
 #include "SkPaint.h"
 #include "SkPoint.h"
 #include "SkTextBlobRunIterator.h"
@@ -13,6 +18,8 @@
 #include "Test.h"
 #include "sk_tool_utils.h"
 
+#include <vector>
+
 class TextBlobTester {
 public:
     // This unit test feeds an SkTextBlobBuilder various runs then checks to see if
@@ -462,3 +469,83 @@ DEF_TEST(TextBlob_serialize, reporter) {
         REPORTER_ASSERT(reporter, sk_tool_utils::equal_pixels(img0.get(), img1.get()));
     }
 }
+
+static int count_cached_glyphs(const std::vector<SkAutoGlyphCache>& caches) {
+    int count = 0;
+    for (const SkAutoGlyphCache& cache : caches) {
+        count += cache->countCachedGlyphs();
+    }
+    return count;
+}
+
+static size_t count_image_bytes(const std::vector<SkAutoGlyphCache>& caches) {
+    size_t bytes = 0;
+    for (const SkAutoGlyphCache& cache : caches) {
+        bytes += cache->getImageBytesLive();
+    }
+    return bytes;
+}
+
+/*
+ *  Prepare a blob's glyphs on a thread pool, then draw it, and check that the prepare step made
+ *  the images of every strike the draw uses, so the draw did not need to make any glyph itself.
+ */
+DEF_TEST(TextBlob_prepare, reporter) {
+    SkTextBlobBuilder builder;
+    add_run(&builder, "Hello", 10, 20, nullptr);
+    add_run(&builder, "World", 10, 40,
+            sk_tool_utils::create_portable_typeface("serif", SkFontStyle()));
+    {
+        // Without a known pixel geometry the device draws LCD text with A8 strikes instead.
+        SkPaint lcdPaint;
+        lcdPaint.setAntiAlias(true);
+        lcdPaint.setLCDRenderText(true);
+        lcdPaint.setTextSize(16);
+        const char text[] = "LCD";
+        int glyphCount = lcdPaint.textToGlyphs(text, strlen(text), nullptr);
+
+        lcdPaint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+        SkTextBlobBuilder::RunBuffer run = builder.allocRun(lcdPaint, glyphCount, 10, 60);
+
+        lcdPaint.setTextEncoding(SkPaint::kUTF8_TextEncoding);
+        (void)lcdPaint.textToGlyphs(text, strlen(text), run.glyphs);
+    }
+    sk_sp<SkTextBlob> blob = builder.make();
+
+    SkScalar x = -blob->bounds().left(),
+             y = -blob->bounds().top();
+    SkBitmap bm;
+    if (!bm.tryAllocN32Pixels(SkScalarRoundToInt(blob->bounds().width()),
+                              SkScalarRoundToInt(blob->bounds().height()))) {
+        return;
+    }
+    SkSurfaceProps props(0, kUnknown_SkPixelGeometry);
+    SkBitmapDevice device(bm, props);
+    SkCanvas canvas(bm, props);
+
+    // Hold on to the strikes the blob draws with, so they cannot be purged under us. These are
+    // the flags the device filters the runs' LCD text to.
+    SkGraphics::PurgeFontCache();
+    std::vector<SkAutoGlyphCache> caches;
+    SkPaint runPaint;
+    for (SkTextBlobRunIterator it(blob.get()); !it.done(); it.next()) {
+        it.applyFontToPaint(&runPaint);
+        if (runPaint.isLCDRenderText()) {
+            runPaint.setLCDRenderText(false);
+            runPaint.setFlags(runPaint.getFlags() | SkPaint::kGenA8FromLCD_Flag);
+        }
+        caches.emplace_back(runPaint, &props, &SkMatrix::I());
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkDraw::PrepareTextBlob(blob.get(), x, y, SkPaint(), SkMatrix::I(), device, executor.get());
+    int prepared = count_cached_glyphs(caches);
+    size_t preparedBytes = count_image_bytes(caches);
+    for (const SkAutoGlyphCache& cache : caches) {
+        REPORTER_ASSERT(reporter, cache->getImageBytesLive() > 0);
+    }
+
+    canvas.drawTextBlob(blob.get(), x, y, SkPaint());
+    REPORTER_ASSERT(reporter, count_cached_glyphs(caches) == prepared);
+    REPORTER_ASSERT(reporter, count_image_bytes(caches) == preparedBytes);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCanvas.h"
+#include "SkPath.h"
+#include "SkThreadedBMPDevice.h"
+#include "SkVertices.h"
+#include "Test.h"
+
+static void draw_across_seams(SkCanvas* canvas) {
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    // Shallow anti-aliased edges that cross many tile seams.
+    SkPath path;
+    path.moveTo(3.3f, 1.7f);
+    path.lineTo(97.1f, 40.2f);
+    path.cubicTo(10, 60, 120, 80, 5.5f, 198.6f);
+    path.close();
+    paint.setColor(0xFF3366CC);
+    canvas->drawPath(path, paint);
+
+    paint.setColor(0x8022AA44);
+    canvas->drawCircle(60.4f, 101.3f, 47.7f, paint);
+
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setStrokeWidth(0);
+    paint.setColor(0xFFCC2211);
+    canvas->drawLine(0.5f, 199.5f, 119.5f, 0.5f, paint);
+    paint.setStrokeWidth(3.3f);
+    canvas->drawLine(2, 5, 110, 190, paint);
+
+    canvas->save();
+    canvas->rotate(17);
+    paint.setStyle(SkPaint::kFill_Style);
+    paint.setColor(0xC0804020);
+    canvas->drawRect(SkRect::MakeXYWH(40.3f, 10.6f, 50, 150), paint);
+    canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(10, 70, 60, 90), 12, 12), paint);
+    canvas->restore();
+
+    const SkPoint pts[] = { { 1, 2 }, { 118, 70 }, { 20, 197 } };
+    const SkColor colors[] = { SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE };
+    canvas->drawVertices(SkVertices::MakeCopy(SkVertices::kTriangles_VertexMode, 3, pts,
+                                              nullptr, colors),
+                         SkBlendMode::kSrcOver, SkPaint());
+}
+
+// Tiles must add up to exactly what a single SkBitmapDevice would draw, even where anti-aliased
+// edges cross the seams between them.
+DEF_TEST(ThreadedBMPDevice_MatchesBitmapDevice, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(120, 200);
+
+    SkBitmap expected;
+    expected.allocPixels(info);
+    expected.eraseColor(SK_ColorWHITE);
+    {
+        SkCanvas canvas(expected);
+        draw_across_seams(&canvas);
+    }
+
+    for (int tiles : { 3, 7, 16 }) {
+        SkBitmap actual;
+        actual.allocPixels(info);
+        actual.eraseColor(SK_ColorWHITE);
+        {
+            sk_sp<SkThreadedBMPDevice> device(new SkThreadedBMPDevice(actual, tiles, 2));
+            SkCanvas canvas(device.get());
+            draw_across_seams(&canvas);
+            canvas.flush();
+        }
+
+        int mismatches = 0;
+        for (int y = 0; y < info.height(); y++) {
+            for (int x = 0; x < info.width(); x++) {
+                mismatches += *expected.getAddr32(x, y) != *actual.getAddr32(x, y);
+            }
+        }
+        if (mismatches) {
+            ERRORF(r, "%d tiles: %d pixels differ from SkBitmapDevice", tiles, mismatches);
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkOpts.h"
+#include "SkPaint.h"
+#include "SkShaperCache.h"
+
+SkShaperCache::Key::Key(const SkTypeface* typeface, const SkPaint& paint,
+                        const char* utf8text, size_t textBytes, bool leftToRight)
+    : fText(utf8text, textBytes)
+    , fTypefaceID(typeface->uniqueID())
+    , fSize(paint.getTextSize())
+    , fScaleX(paint.getTextScaleX())
+    , fSkewX(paint.getTextSkewX())
+    , fFlags(paint.getFlags())
+    , fAlign(SkToU8(paint.getTextAlign()))
+    , fHinting(SkToU8(paint.getHinting()))
+    , fLeftToRight(leftToRight) {
+    uint32_t hash = SkOpts::hash(fText.c_str(), fText.size(), fTypefaceID);
+    hash = SkOpts::hash(&fSize, sizeof(fSize), hash);
+    hash = SkOpts::hash(&fScaleX, sizeof(fScaleX), hash);
+    hash = SkOpts::hash(&fSkewX, sizeof(fSkewX), hash);
+    uint32_t bits[] = { fFlags, fAlign, fHinting, fLeftToRight };
+    fHash = SkOpts::hash(bits, sizeof(bits), hash);
+}
+
+bool SkShaperCache::Key::operator==(const Key& that) const {
+    return fHash        == that.fHash &&
+           fTypefaceID  == that.fTypefaceID &&
+           fSize        == that.fSize &&
+           fScaleX      == that.fScaleX &&
+           fSkewX       == that.fSkewX &&
+           fFlags       == that.fFlags &&
+           fAlign       == that.fAlign &&
+           fHinting     == that.fHinting &&
+           fLeftToRight == that.fLeftToRight &&
+           fText        == that.fText;
+}
+
+SkShaperCache::SkShaperCache(int maxEntries)
+    : fShaped(maxEntries)
+    , fShapers(maxEntries)
+    , fHitCount(0)
+    , fMissCount(0) {
+    SkASSERT(maxEntries > 0);
+}
+
+SkShaperCache::~SkShaperCache() {}
+
+SkShaper* SkShaperCache::findOrCreateShaper(sk_sp<SkTypeface> typeface) {
+    SkFontID id = typeface->uniqueID();
+    if (std::unique_ptr<SkShaper>* shaper = fShapers.find(id)) {
+        return shaper->get();
+    }
+    return fShapers.insert(id, std::unique_ptr<SkShaper>(new SkShaper(std::move(typeface))))->get();
+}
+
+sk_sp<SkTextBlob> SkShaperCache::shape(sk_sp<SkTypeface> typeface,
+                                       const SkPaint& paint,
+                                       const char* utf8text,
+                                       size_t textBytes,
+                                       bool leftToRight,
+                                       SkScalar* advance) {
+    if (!typeface) {
+        typeface = SkTypeface::MakeDefault();
+    }
+    Key key(typeface.get(), paint, utf8text, textBytes, leftToRight);
+    Shaped* shaped = fShaped.find(key);
+    if (shaped) {
+        fHitCount++;
+    } else {
+        fMissCount++;
+        SkShaper* shaper = this->findOrCreateShaper(std::move(typeface));
+        SkTextBlobBuilder builder;
+        SkScalar x = shaper->shape(&builder, paint, utf8text, textBytes, leftToRight,
+                                   SkPoint::Make(0, 0));
+        shaped = fShaped.insert(key, Shaped{builder.make(), x});
+    }
+    if (advance) {
+        *advance = shaped->fAdvance;
+    }
+    return shaped->fBlob;
+}
+
+void SkShaperCache::reset() {
+    fShaped.reset();
+    fShapers.reset();
+    fHitCount = 0;
+    fMissCount = 0;
+}
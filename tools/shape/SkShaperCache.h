@@ -0,0 +1,93 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkShaperCache_DEFINED
+#define SkShaperCache_DEFINED
+
+#include <memory>
+
+#include "SkLRUCache.h"
+#include "SkShaper.h"
+#include "SkString.h"
+#include "SkTextBlob.h"
+#include "SkTypeface.h"
+
+class SkPaint;
+
+/**
+   Keeps the SkTextBlobs made by shaping recent text, so that shaping the same text with the
+   same typeface and paint again hands back the blob already made instead of shaping it again.
+
+   Blobs are keyed by the text, typeface, direction and the paint settings a blob's runs keep
+   (size, scale, skew, align, hinting and flags). At most maxEntries blobs are kept; past that
+   the least recently used is dropped. It also keeps an SkShaper for each of the last maxEntries
+   typefaces it shaped with.
+
+   Not thread safe.
+ */
+class SkShaperCache {
+public:
+    explicit SkShaperCache(int maxEntries);
+    ~SkShaperCache();
+
+    /**
+     *  Returns the blob SkShaper::shape() makes for the text at (0, 0) with typeface, or with
+     *  the default typeface if it is null. If advance is not null it is set to the x that
+     *  shape() returns.
+     */
+    sk_sp<SkTextBlob> shape(sk_sp<SkTypeface> typeface,
+                            const SkPaint& paint,
+                            const char* utf8text,
+                            size_t textBytes,
+                            bool leftToRight,
+                            SkScalar* advance = nullptr);
+
+    int count() { return fShaped.count(); }
+    int shaperCount() { return fShapers.count(); }
+    int hitCount() const { return fHitCount; }
+    int missCount() const { return fMissCount; }
+
+    /** Drops every blob and shaper, and zeroes the hit and miss counts. */
+    void reset();
+
+private:
+    struct Key {
+        Key(const SkTypeface*, const SkPaint&, const char* utf8text, size_t textBytes,
+            bool leftToRight);
+
+        bool operator==(const Key& that) const;
+
+        SkString fText;
+        SkFontID fTypefaceID;
+        SkScalar fSize;
+        SkScalar fScaleX;
+        SkScalar fSkewX;
+        uint32_t fFlags;
+        uint8_t  fAlign;
+        uint8_t  fHinting;
+        bool     fLeftToRight;
+        uint32_t fHash;
+    };
+
+    struct KeyHash {
+        uint32_t operator()(const Key& key) const { return key.fHash; }
+    };
+
+    struct Shaped {
+        sk_sp<SkTextBlob> fBlob;
+        SkScalar          fAdvance;
+    };
+
+    SkShaper* findOrCreateShaper(sk_sp<SkTypeface>);
+
+    SkLRUCache<Key, Shaped, KeyHash>                fShaped;
+    SkLRUCache<SkFontID, std::unique_ptr<SkShaper>> fShapers;
+    int                                             fHitCount;
+    int                                             fMissCount;
+};
+
+#endif  // SkShaperCache_DEFINED